@@ -0,0 +1,73 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// @dart=2.9
+
+// Measures the latency of common asynchronous file operations. Small reads
+// are dominated by the round trips to the IO service rather than by the
+// read itself, so the per-operation overhead shows up directly in the
+// results. The synchronous variants are included as a baseline.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+
+const int smallSize = 4 * 1024;
+const int largeSize = 1024 * 1024;
+const Duration warmupDuration = Duration(milliseconds: 200);
+const Duration measuredDuration = Duration(seconds: 2);
+
+// Runs [operation] repeatedly for [duration] and returns the average time
+// per operation in microseconds.
+Future<double> measureFor(
+    Future<void> Function() operation, Duration duration) async {
+  final watch = Stopwatch()..start();
+  int iterations = 0;
+  do {
+    await operation();
+    iterations++;
+  } while (watch.elapsed < duration);
+  return watch.elapsedMicroseconds / iterations;
+}
+
+Future<void> report(String name, Future<void> Function() operation) async {
+  await measureFor(operation, warmupDuration);
+  final micros = await measureFor(operation, measuredDuration);
+  print('FileIO.$name(RunTime): $micros us.');
+}
+
+Future<void> main() async {
+  final directory = await Directory.systemTemp.createTemp('file_io_bench');
+  try {
+    final small = File('${directory.path}/small');
+    final large = File('${directory.path}/large');
+    final written = File('${directory.path}/written');
+    small.writeAsBytesSync(Uint8List(smallSize));
+    large.writeAsBytesSync(Uint8List(largeSize));
+    final smallData = Uint8List(smallSize);
+
+    await report('ReadAsBytes.Small', () => small.readAsBytes());
+    await report('ReadAsBytes.Large', () => large.readAsBytes());
+    await report('ReadAsBytesSync.Small', () async {
+      small.readAsBytesSync();
+    });
+    await report('WriteAsBytes.Small', () => written.writeAsBytes(smallData));
+
+    final file = await large.open();
+    final buffer = Uint8List(smallSize);
+    await report('RandomAccessFile.Read.Small', () async {
+      if ((await file.read(smallSize)).length < smallSize) {
+        await file.setPosition(0);
+      }
+    });
+    await report('RandomAccessFile.ReadInto.Small', () async {
+      if (await file.readInto(buffer) < smallSize) {
+        await file.setPosition(0);
+      }
+    });
+    await file.close();
+  } finally {
+    await directory.delete(recursive: true);
+  }
+}
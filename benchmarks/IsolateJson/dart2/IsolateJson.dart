@@ -89,6 +89,71 @@ Future<void> jsonDecodingIsolate(JsonDecodeRequest request) async {
   }
 }
 
+// Measures sending json that has already been decoded to another isolate.
+// When the VM runs with --enable-isolate-groups, isolates spawned with
+// Isolate.spawn share a heap, and the message is copied directly into it.
+// Isolates spawned with Isolate.spawnUri are always in another group, and the
+// message is sent as a snapshot.
+class JsonSendingBenchmark {
+  JsonSendingBenchmark(this.name,
+      {@required this.decoded,
+      @required this.numMessages,
+      this.acrossGroups = false});
+
+  Future<void> report() async {
+    final port = ReceivePort();
+    final inbox = StreamIterator<dynamic>(port);
+    if (acrossGroups) {
+      try {
+        await Isolate.spawnUri(
+            Platform.script, <String>[receiverArgument], port.sendPort);
+      } on UnsupportedError {
+        // Isolate.spawnUri is not available in AOT compiled programs.
+        port.close();
+        return;
+      }
+    } else {
+      await Isolate.spawn(jsonReceivingIsolate, port.sendPort);
+    }
+    await inbox.moveNext();
+    final workerPort = inbox.current as SendPort;
+
+    final stopwatch = Stopwatch()..start();
+    // Benchmark harness counts 10 iterations as one.
+    for (int i = 0; i < 10; i++) {
+      for (int i = 0; i < numMessages; i++) {
+        workerPort.send(decoded);
+      }
+      for (int i = 0; i < numMessages; i++) {
+        await inbox.moveNext();
+      }
+    }
+
+    print('$name(RunTime): ${stopwatch.elapsedMicroseconds} us.');
+    workerPort.send(null);
+    port.close();
+  }
+
+  final String name;
+  final Object decoded;
+  final int numMessages;
+  final bool acrossGroups;
+}
+
+const receiverArgument = 'receiver';
+
+void jsonReceivingIsolate(SendPort replyPort) {
+  final port = RawReceivePort();
+  port.handler = (message) {
+    if (message == null) {
+      port.close();
+      return;
+    }
+    replyPort.send(message is Map ? message.length : (message as List).length);
+  };
+  replyPort.send(port.sendPort);
+}
+
 class SyncJsonDecodingBenchmark extends BenchmarkBase {
   SyncJsonDecodingBenchmark(String name,
       {@required this.sample, @required this.iterations})
@@ -108,6 +173,19 @@ class SyncJsonDecodingBenchmark extends BenchmarkBase {
   final int iterations;
 }
 
+// Records with the same keys, like the rows of a table decoded from json.
+List<Map<String, dynamic>> createRecords(int count) {
+  return List.generate(
+      count,
+      (i) => <String, dynamic>{
+            'id': i,
+            'name': 'record $i',
+            'kind': i.isEven ? 'even' : 'odd',
+            'score': i / 3,
+            'tags': <String>['tag', 'record'],
+          });
+}
+
 class BenchmarkConfig {
   BenchmarkConfig(this.suffix, this.sample);
 
@@ -115,7 +193,12 @@ class BenchmarkConfig {
   final Uint8List sample;
 }
 
-Future<void> main() async {
+Future<void> main(List<String> args, [dynamic replyPort]) async {
+  if (args.isNotEmpty && args[0] == receiverArgument) {
+    jsonReceivingIsolate(replyPort as SendPort);
+    return;
+  }
+
   final jsonString =
       File('benchmarks/IsolateJson/dart2/sample.json').readAsStringSync();
   final json250KB = utf8.encode(jsonString); // 294356 bytes
@@ -153,6 +236,17 @@ Future<void> main() async {
               sample: config.sample,
               numTasks: iterations)
           .report();
+      await JsonSendingBenchmark(
+              'IsolateJson.SendDecoded${config.suffix}x$iterations',
+              decoded: json.decode(utf8.decode(config.sample)),
+              numMessages: iterations)
+          .report();
+      await JsonSendingBenchmark(
+              'IsolateJson.SendDecodedAcrossGroups${config.suffix}x$iterations',
+              decoded: json.decode(utf8.decode(config.sample)),
+              numMessages: iterations,
+              acrossGroups: true)
+          .report();
       SyncJsonDecodingBenchmark(
               'IsolateJson.SyncDecode${config.suffix}x$iterations',
               sample: config.sample,
@@ -160,4 +254,13 @@ Future<void> main() async {
           .report();
     }
   }
+
+  for (final count in <int>[100, 10000]) {
+    await JsonSendingBenchmark('IsolateJson.SendRecords$count',
+            decoded: createRecords(count), numMessages: 1)
+        .report();
+    await JsonSendingBenchmark('IsolateJson.SendRecordsAcrossGroups$count',
+            decoded: createRecords(count), numMessages: 1, acrossGroups: true)
+        .report();
+  }
 }
@@ -0,0 +1,81 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Measures the round trip time of a small message sent back and forth between
+// two isolates, alone and with several other pairs of isolates doing the same,
+// so that the message handlers of the isolates are scheduled on the shared
+// thread pool of the VM.
+
+import 'dart:async';
+import 'dart:isolate';
+
+const Duration warmupDuration = Duration(milliseconds: 500);
+const Duration measuredDuration = Duration(seconds: 2);
+
+// Sends its port to the first port, then echoes every message to the second
+// one, until it is sent null.
+void echo(List<SendPort> ports) {
+  final port = ReceivePort();
+  final sender = ports[1];
+  ports[0].send(port.sendPort);
+  port.listen((message) {
+    if (message == null) {
+      port.close();
+    } else {
+      sender.send(message);
+    }
+  });
+}
+
+// Sends [message] back and forth between this isolate and an echo isolate
+// for [duration], and sends the number of round trips to [result].
+Future<void> pingPong(List args) async {
+  final int durationMicros = args[0];
+  final SendPort result = args[1];
+  final duration = Duration(microseconds: durationMicros);
+  const message = [1, 2, 3];
+
+  final setup = ReceivePort();
+  final port = ReceivePort();
+  await Isolate.spawn(echo, [setup.sendPort, port.sendPort]);
+  final SendPort echoPort = await setup.first;
+  final watch = Stopwatch()..start();
+  int roundTrips = 0;
+  final done = Completer<void>();
+  port.listen((_) {
+    roundTrips++;
+    if (watch.elapsed < duration) {
+      echoPort.send(message);
+    } else {
+      echoPort.send(null);
+      port.close();
+      done.complete();
+    }
+  });
+  echoPort.send(message);
+  await done.future;
+  result.send(roundTrips);
+}
+
+Future<double> measureRoundTripMicros(int pairs, Duration duration) async {
+  final results = ReceivePort();
+  for (int i = 0; i < pairs; i++) {
+    await Isolate.spawn(pingPong, [duration.inMicroseconds, results.sendPort]);
+  }
+  int roundTrips = 0;
+  await for (final int count in results.take(pairs)) {
+    roundTrips += count;
+  }
+  results.close();
+  return duration.inMicroseconds * pairs / roundTrips;
+}
+
+Future<void> main() async {
+  for (final pairs in [1, 8]) {
+    await measureRoundTripMicros(pairs, warmupDuration);
+    final roundTripMicros =
+        await measureRoundTripMicros(pairs, measuredDuration);
+    print('IsolatePingPong.RoundTrip$pairs(RunTime): $roundTripMicros us.');
+  }
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Measures the latency of starting a short lived process with Process.run
+// while the heap holds increasing amounts of live data. Starting a process by
+// forking copies the page tables of the parent, so its cost grows with the
+// resident size of the parent.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+
+const List<int> heapSizesInMB = [0, 256, 1024];
+const Duration warmupDuration = Duration(milliseconds: 200);
+const Duration measuredDuration = Duration(seconds: 2);
+
+// Runs [operation] repeatedly for [duration] and returns the average time
+// per operation in microseconds.
+Future<double> measureFor(
+    Future<void> Function() operation, Duration duration) async {
+  final watch = Stopwatch()..start();
+  int iterations = 0;
+  do {
+    await operation();
+    iterations++;
+  } while (watch.elapsed < duration);
+  return watch.elapsedMicroseconds / iterations;
+}
+
+Future<void> main() async {
+  if (!Platform.isLinux && !Platform.isMacOS) return;
+  final retained = <Uint8List>[];
+  int retainedMB = 0;
+  for (final heapSizeInMB in heapSizesInMB) {
+    while (retainedMB < heapSizeInMB) {
+      // Touch every page, so the memory is resident.
+      retained.add(Uint8List(1024 * 1024)..fillRange(0, 1024 * 1024, 1));
+      retainedMB++;
+    }
+    Future<void> operation() async {
+      final result = await Process.run('true', const []);
+      if (result.exitCode != 0) throw 'Unexpected exit code';
+    }
+
+    await measureFor(operation, warmupDuration);
+    final micros = await measureFor(operation, measuredDuration);
+    print('ProcessRun.Heap${heapSizeInMB}MB(RunTime): $micros us.');
+  }
+  if (retained.length != retainedMB) throw 'Lost retained data';
+}
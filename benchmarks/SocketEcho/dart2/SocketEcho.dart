@@ -0,0 +1,112 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// @dart=2.9
+
+// Measures the round trip time of small messages echoed over loopback TCP
+// connections. Several isolates share the listening socket and several
+// isolates drive the client connections, so the event handler thread is the
+// shared bottleneck. On Linux the event handler can be sharded with
+// --event_handler_loops=<n>; compare runs with 1 to 16 loops.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+const int serverIsolates = 4;
+const int clientIsolates = 4;
+const int connectionsPerClient = 4;
+const int messageSize = 64;
+const Duration warmupDuration = Duration(milliseconds: 500);
+const Duration measuredDuration = Duration(seconds: 4);
+
+void echo(Socket socket) {
+  socket.setOption(SocketOption.tcpNoDelay, true);
+  socket.listen(socket.add, onDone: socket.destroy);
+}
+
+Future<void> runServer(List args) async {
+  final int port = args[0];
+  final SendPort ready = args[1];
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, port,
+      shared: true);
+  server.listen(echo);
+  ready.send(null);
+}
+
+Future<int> pingPong(int port, Duration duration) async {
+  final socket = await Socket.connect(InternetAddress.loopbackIPv4, port);
+  socket.setOption(SocketOption.tcpNoDelay, true);
+  final message = Uint8List(messageSize);
+  final watch = Stopwatch()..start();
+  final done = Completer<int>();
+  int roundTrips = 0;
+  int received = 0;
+  socket.listen((data) {
+    received += data.length;
+    if (received < messageSize) return;
+    received -= messageSize;
+    roundTrips++;
+    if (watch.elapsed < duration) {
+      socket.add(message);
+    } else {
+      socket.destroy();
+      done.complete(roundTrips);
+    }
+  });
+  socket.add(message);
+  return done.future;
+}
+
+Future<void> runClient(List args) async {
+  final int port = args[0];
+  final int durationMicros = args[1];
+  final SendPort result = args[2];
+  final duration = Duration(microseconds: durationMicros);
+  final roundTrips = await Future.wait([
+    for (int i = 0; i < connectionsPerClient; i++) pingPong(port, duration)
+  ]);
+  result.send(roundTrips.fold<int>(0, (sum, value) => sum + value));
+}
+
+Future<int> measureRoundTrips(int port, Duration duration) async {
+  final results = ReceivePort();
+  for (int i = 0; i < clientIsolates; i++) {
+    await Isolate.spawn(
+        runClient, [port, duration.inMicroseconds, results.sendPort]);
+  }
+  int roundTrips = 0;
+  await for (final int count in results.take(clientIsolates)) {
+    roundTrips += count;
+  }
+  results.close();
+  return roundTrips;
+}
+
+Future<void> main() async {
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0,
+      shared: true);
+  server.listen(echo);
+  final port = server.port;
+  final servers = <Isolate>[];
+  for (int i = 1; i < serverIsolates; i++) {
+    final ready = ReceivePort();
+    servers.add(await Isolate.spawn(runServer, [port, ready.sendPort]));
+    await ready.first;
+  }
+
+  await measureRoundTrips(port, warmupDuration);
+  final roundTrips = await measureRoundTrips(port, measuredDuration);
+
+  for (final isolate in servers) {
+    isolate.kill(priority: Isolate.immediate);
+  }
+  await server.close();
+
+  const connections = clientIsolates * connectionsPerClient;
+  final roundTripMicros =
+      measuredDuration.inMicroseconds * connections / roundTrips;
+  print('SocketEcho.RoundTrip(RunTime): $roundTripMicros us.');
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Measures the time to compress and decompress payloads with the synchronous
+// ZLibEncoder.convert, which runs on the isolate thread, and with
+// convertAsync, which runs on IO service threads and compresses large
+// payloads in parallel blocks.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+
+const int smallSize = 16 * 1024;
+const int largeSize = 8 * 1024 * 1024;
+const Duration warmupDuration = Duration(milliseconds: 200);
+const Duration measuredDuration = Duration(seconds: 2);
+
+// Moderately compressible data, like text or JSON.
+Uint8List makePayload(int size) {
+  final payload = Uint8List(size);
+  int seed = 1;
+  for (int i = 0; i < size; i++) {
+    seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF;
+    payload[i] = 32 + (seed >> 16) % 32 + (i >> 6) % 32;
+  }
+  return payload;
+}
+
+// Runs [operation] repeatedly for [duration] and returns the average time
+// per operation in microseconds.
+Future<double> measureFor(
+    Future<void> Function() operation, Duration duration) async {
+  final watch = Stopwatch()..start();
+  int iterations = 0;
+  do {
+    await operation();
+    iterations++;
+  } while (watch.elapsed < duration);
+  return watch.elapsedMicroseconds / iterations;
+}
+
+Future<void> report(String name, Future<void> Function() operation) async {
+  await measureFor(operation, warmupDuration);
+  final micros = await measureFor(operation, measuredDuration);
+  print('ZLibThroughput.$name(RunTime): $micros us.');
+}
+
+Future<void> main() async {
+  final encoder = GZipCodec().encoder;
+  final decoder = GZipCodec().decoder;
+  for (final size in [smallSize, largeSize]) {
+    final name = size == smallSize ? 'Small' : 'Large';
+    final payload = makePayload(size);
+    final compressed = encoder.convert(payload);
+    await report('Deflate.$name', () async {
+      encoder.convert(payload);
+    });
+    await report('DeflateAsync.$name', () => encoder.convertAsync(payload));
+    await report('Inflate.$name', () async {
+      decoder.convert(compressed);
+    });
+    await report('InflateAsync.$name', () => decoder.convertAsync(compressed));
+  }
+}
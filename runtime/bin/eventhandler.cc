@@ -58,6 +58,9 @@ void TimeoutQueue::UpdateTimeout(Dart_Port port, int64_t timeout) {
 static EventHandler* event_handler = NULL;
 static Monitor* shutdown_monitor = NULL;
 
+bool EventHandler::use_io_uring_ = false;
+intptr_t EventHandler::loop_count_ = 1;
+
 void EventHandler::Start() {
   // Initialize global socket registry.
   ListeningSocketRegistry::Initialize();
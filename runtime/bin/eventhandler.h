@@ -643,10 +643,29 @@ class EventHandler {
 
   static void SendFromNative(intptr_t id, Dart_Port port, int64_t data);
 
+  // Whether the event handler should use io_uring on platforms which support
+  // it. Must be set before Start().
+  static bool use_io_uring() { return use_io_uring_; }
+  static void set_use_io_uring(bool use_io_uring) {
+    use_io_uring_ = use_io_uring;
+  }
+
+  // Number of event loop threads on platforms which support sharding the
+  // event handler. Must be set before Start().
+  static const intptr_t kMaxLoopCount = 64;
+  static intptr_t loop_count() { return loop_count_; }
+  static void set_loop_count(intptr_t loop_count) {
+    ASSERT((loop_count > 0) && (loop_count <= kMaxLoopCount));
+    loop_count_ = loop_count;
+  }
+
  private:
   friend class EventHandlerImplementation;
   EventHandlerImplementation delegate_;
 
+  static bool use_io_uring_;
+  static intptr_t loop_count_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandler);
 };
 
@@ -10,19 +10,35 @@
 
 #include <errno.h>        // NOLINT
 #include <fcntl.h>        // NOLINT
+#include <poll.h>         // NOLINT
 #include <pthread.h>      // NOLINT
 #include <stdio.h>        // NOLINT
 #include <string.h>       // NOLINT
 #include <sys/epoll.h>    // NOLINT
+#include <sys/mman.h>     // NOLINT
 #include <sys/stat.h>     // NOLINT
+#include <sys/syscall.h>  // NOLINT
 #include <sys/timerfd.h>  // NOLINT
 #include <unistd.h>       // NOLINT
 
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>  // NOLINT
+#endif
+#endif
+
+// IORING_OP_EPOLL_CTL was added in Linux 5.6 together with
+// IORING_SETUP_CLAMP, which is a macro and can be tested for.
+#if defined(IORING_SETUP_CLAMP) && defined(__NR_io_uring_setup)
+#define DART_USE_IO_URING
+#endif
+
 #include "bin/dartutils.h"
 #include "bin/fdutils.h"
 #include "bin/lockers.h"
 #include "bin/socket.h"
 #include "bin/thread.h"
+#include "platform/growable_array.h"
 #include "platform/syslog.h"
 #include "platform/utils.h"
 
@@ -48,12 +64,17 @@ static void RemoveFromEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
   VOID_NO_RETRY_EXPECTED(epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, di->fd(), NULL));
 }
 
-static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
-  struct epoll_event event;
-  event.events = EPOLLRDHUP | di->GetPollEvents();
+static uint32_t GetEpollEvents(DescriptorInfo* di) {
+  uint32_t events = EPOLLRDHUP | di->GetPollEvents();
   if (!di->IsListeningSocket()) {
-    event.events |= EPOLLET;
+    events |= EPOLLET;
   }
+  return events;
+}
+
+static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
+  struct epoll_event event;
+  event.events = GetEpollEvents(di);
   event.data.ptr = di;
   int status =
       NO_RETRY_EXPECTED(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, di->fd(), &event));
@@ -68,8 +89,308 @@ static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
   }
 }
 
+#if defined(DART_USE_IO_URING)
+// Submits epoll_ctl operations through an io_uring instance. All registration
+// changes made while handling a batch of events reach the kernel with a single
+// io_uring_enter call, which also waits for the epoll instance to become
+// readable again. Readiness is still delivered through epoll, so the
+// edge-triggered semantics the Dart side relies on are unchanged. Reads,
+// writes, accepts and timers are not submitted through the ring.
+class EpollControlRing {
+ public:
+  static EpollControlRing* Create(int epoll_fd) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    const int ring_fd = NO_RETRY_EXPECTED(
+        syscall(__NR_io_uring_setup, kEntries, &params));
+    if (ring_fd == -1) {
+      return NULL;
+    }
+    EpollControlRing* ring = new EpollControlRing(ring_fd, epoll_fd);
+    if (!ring->Initialize(params)) {
+      delete ring;
+      return NULL;
+    }
+    return ring;
+  }
+
+  ~EpollControlRing() {
+    if (sqes_ != MAP_FAILED) {
+      munmap(sqes_, sqes_size_);
+    }
+    if ((cq_ring_ != MAP_FAILED) && (cq_ring_ != sq_ring_)) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    if (sq_ring_ != MAP_FAILED) {
+      munmap(sq_ring_, sq_ring_size_);
+    }
+    delete[] events_;
+    close(ring_fd_);
+  }
+
+  bool has_pending() const { return pending_ > 0; }
+
+  // Queues epoll_ctl(epoll_fd, op, fd, {events, data}). If [link_next] is
+  // true the next queued operation is only started after this one finished.
+  void QueueControl(int op,
+                    intptr_t fd,
+                    uint32_t events,
+                    void* data,
+                    bool link_next) {
+    // Keep room for the poll of the epoll instance and never separate linked
+    // operations into different submissions. The kernel may run the
+    // operations of a submission in any order unless they are linked, so an
+    // operation on a descriptor that already has one queued waits for it to
+    // complete. Otherwise an add could fail because the descriptor is still
+    // registered, and the descriptor would be reported closed.
+    if (!previous_linked_ &&
+        ((pending_ + 3 > sq_entries_) || HasQueuedControl(fd))) {
+      Submit(false);
+    }
+    queued_fds_.Add(fd);
+    const uint32_t index = sq_tail_local_ & sq_mask_;
+    struct io_uring_sqe* sqe = NextSqe();
+    struct epoll_event* event = &events_[index];
+    event->events = events;
+    event->data.ptr = data;
+    sqe->opcode = IORING_OP_EPOLL_CTL;
+    sqe->fd = epoll_fd_;
+    sqe->off = fd;
+    sqe->len = op;
+    sqe->addr = reinterpret_cast<uint64_t>(event);
+    sqe->user_data = (static_cast<uint64_t>(fd) << kOpBits) | op;
+    if (link_next) {
+      sqe->flags |= IOSQE_IO_HARDLINK;
+    }
+    previous_linked_ = link_next;
+  }
+
+  // Submits all queued operations and waits until each of them completed.
+  // If [wait_for_epoll] is true this also blocks until the epoll instance has
+  // events to harvest.
+  //
+  // The kernel may hand epoll_ctl operations to an io-wq worker instead of
+  // completing them during submission, so the completion is what tells that a
+  // removed descriptor has left the epoll instance and can be closed.
+  void Submit(bool wait_for_epoll) {
+    ASSERT(!previous_linked_);
+    if (wait_for_epoll && !epoll_poll_armed_) {
+      struct io_uring_sqe* sqe = NextSqe();
+      sqe->opcode = IORING_OP_POLL_ADD;
+      sqe->fd = epoll_fd_;
+      sqe->poll_events = POLLIN;
+      sqe->user_data = kEpollPollUserData;
+      epoll_poll_armed_ = true;
+    }
+    __atomic_store_n(sq_tail_, sq_tail_local_, __ATOMIC_RELEASE);
+    while (true) {
+      const uint32_t control_in_flight =
+          in_flight_ - (epoll_poll_armed_ ? 1 : 0);
+      const bool waiting_for_epoll = wait_for_epoll && epoll_poll_armed_;
+      if ((pending_ == 0) && (control_in_flight == 0) && !waiting_for_epoll) {
+        break;
+      }
+      // Completions are reaped after every call, so a single new one is
+      // enough to make progress.
+      const uint32_t min_complete =
+          ((control_in_flight > 0) || waiting_for_epoll) ? 1 : 0;
+      const unsigned flags = (min_complete > 0) ? IORING_ENTER_GETEVENTS : 0;
+      const intptr_t result = syscall(__NR_io_uring_enter, ring_fd_, pending_,
+                                      min_complete, flags, NULL, 0);
+      if (result >= 0) {
+        pending_ -= result;
+      } else if ((errno != EINTR) && (errno != EAGAIN) && (errno != EBUSY)) {
+        FATAL1("io_uring_enter failed: %d", errno);
+      }
+      ReapCompletions();
+    }
+    queued_fds_.Clear();
+  }
+
+  // Returns the next descriptor which could not be added to the epoll
+  // instance, or -1.
+  intptr_t NextFailedAdd() {
+    if (failed_adds_.is_empty()) {
+      return -1;
+    }
+    return failed_adds_.RemoveLast();
+  }
+
+ private:
+  static const uint32_t kEntries = 64;
+  static const int kOpBits = 8;
+  static const uint64_t kEpollPollUserData = ~static_cast<uint64_t>(0);
+
+  EpollControlRing(int ring_fd, int epoll_fd)
+      : ring_fd_(ring_fd),
+        epoll_fd_(epoll_fd),
+        sq_ring_(MAP_FAILED),
+        cq_ring_(MAP_FAILED),
+        sqes_(reinterpret_cast<struct io_uring_sqe*>(MAP_FAILED)),
+        events_(NULL) {}
+
+  bool Initialize(const struct io_uring_params& params) {
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      sq_ring_size_ = Utils::Maximum(sq_ring_size_, cq_ring_size_);
+    }
+    sq_ring_ = mmap(NULL, sq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+      return false;
+    }
+    cq_ring_ = single_mmap ? sq_ring_
+                           : mmap(NULL, cq_ring_size_, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, ring_fd_,
+                                  IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      return false;
+    }
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes_ = reinterpret_cast<struct io_uring_sqe*>(
+        mmap(NULL, sqes_size_, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES));
+    if (sqes_ == MAP_FAILED) {
+      return false;
+    }
+
+    uint8_t* sq = reinterpret_cast<uint8_t*>(sq_ring_);
+    sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    sq_entries_ = params.sq_entries;
+    sq_tail_local_ = *sq_tail_;
+
+    uint8_t* cq = reinterpret_cast<uint8_t*>(cq_ring_);
+    cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    events_ = new struct epoll_event[sq_entries_];
+    return IsSupported(IORING_OP_EPOLL_CTL) && IsSupported(IORING_OP_POLL_ADD);
+  }
+
+  bool IsSupported(uint8_t opcode) {
+    const intptr_t kMaxOps = 256;
+    const intptr_t size = sizeof(struct io_uring_probe) +
+                          kMaxOps * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe* probe =
+        reinterpret_cast<struct io_uring_probe*>(calloc(1, size));
+    const intptr_t result =
+        NO_RETRY_EXPECTED(syscall(__NR_io_uring_register, ring_fd_,
+                                  IORING_REGISTER_PROBE, probe, kMaxOps));
+    const bool supported = (result == 0) && (opcode <= probe->last_op) &&
+                           ((probe->ops[opcode].flags &
+                             IO_URING_OP_SUPPORTED) != 0);
+    free(probe);
+    return supported;
+  }
+
+  bool HasQueuedControl(intptr_t fd) const {
+    for (intptr_t i = 0; i < queued_fds_.length(); i++) {
+      if (queued_fds_[i] == fd) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  struct io_uring_sqe* NextSqe() {
+    ASSERT(pending_ < sq_entries_);
+    const uint32_t index = sq_tail_local_ & sq_mask_;
+    struct io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    sq_tail_local_++;
+    pending_++;
+    in_flight_++;
+    return sqe;
+  }
+
+  void ReapCompletions() {
+    uint32_t head = *cq_head_;
+    const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+      const struct io_uring_cqe& cqe = cqes_[head & cq_mask_];
+      ASSERT(in_flight_ > 0);
+      in_flight_--;
+      if (cqe.user_data == kEpollPollUserData) {
+        epoll_poll_armed_ = false;
+      } else if (((cqe.user_data & ((1 << kOpBits) - 1)) == EPOLL_CTL_ADD) &&
+                 (cqe.res < 0)) {
+        failed_adds_.Add(static_cast<intptr_t>(cqe.user_data >> kOpBits));
+      }
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+
+  const int ring_fd_;
+  const int epoll_fd_;
+
+  void* sq_ring_;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_;
+  size_t cq_ring_size_ = 0;
+  struct io_uring_sqe* sqes_;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_tail_ = NULL;
+  uint32_t* sq_array_ = NULL;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t sq_tail_local_ = 0;
+
+  uint32_t* cq_head_ = NULL;
+  uint32_t* cq_tail_ = NULL;
+  uint32_t cq_mask_ = 0;
+  struct io_uring_cqe* cqes_ = NULL;
+
+  // Argument of the epoll_ctl operation queued in the submission entry with
+  // the same index. The kernel copies it when the entry is submitted.
+  struct epoll_event* events_;
+
+  // Entries queued but not yet consumed by the kernel.
+  uint32_t pending_ = 0;
+  // Entries queued whose completion has not been reaped yet.
+  uint32_t in_flight_ = 0;
+  bool previous_linked_ = false;
+  bool epoll_poll_armed_ = false;
+  MallocGrowableArray<intptr_t> failed_adds_;
+  // Descriptors of the operations queued since the last submission
+  // completed.
+  MallocGrowableArray<intptr_t> queued_fds_;
+
+  DISALLOW_COPY_AND_ASSIGN(EpollControlRing);
+};
+#else
+class EpollControlRing {
+ public:
+  static EpollControlRing* Create(int epoll_fd) { return NULL; }
+
+  bool has_pending() const { return false; }
+  void QueueControl(int op,
+                    intptr_t fd,
+                    uint32_t events,
+                    void* data,
+                    bool link_next) {
+    UNREACHABLE();
+  }
+  void Submit(bool wait_for_epoll) { UNREACHABLE(); }
+  intptr_t NextFailedAdd() { return -1; }
+};
+#endif  // defined(DART_USE_IO_URING)
+
 EventHandlerImplementation::EventHandlerImplementation()
-    : socket_map_(&SimpleHashMap::SamePointerValue, 16) {
+    : socket_map_(&SimpleHashMap::SamePointerValue, 16),
+      control_ring_(NULL),
+      handler_(NULL),
+      loops_(NULL),
+      loop_count_(0),
+      running_loops_(0) {
   intptr_t result;
   result = NO_RETRY_EXPECTED(pipe(interrupt_fds_));
   if (result != 0) {
@@ -117,6 +438,10 @@ EventHandlerImplementation::EventHandlerImplementation()
     FATAL2("Failed adding timerfd fd(%i) to epoll instance: %i", timer_fd_,
            errno);
   }
+  if (EventHandler::use_io_uring()) {
+    // Falls back to plain epoll_ctl calls if the kernel lacks io_uring.
+    control_ring_ = EpollControlRing::Create(epoll_fd_);
+  }
 }
 
 static void DeleteDescriptorInfo(void* info) {
@@ -126,7 +451,12 @@ static void DeleteDescriptorInfo(void* info) {
 }
 
 EventHandlerImplementation::~EventHandlerImplementation() {
+  for (intptr_t i = 1; i < loop_count_; i++) {
+    delete loops_[i];
+  }
+  delete[] loops_;
   socket_map_.Clear(DeleteDescriptorInfo);
+  delete control_ring_;
   close(epoll_fd_);
   close(timer_fd_);
   close(interrupt_fds_[0]);
@@ -136,6 +466,10 @@ EventHandlerImplementation::~EventHandlerImplementation() {
 void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
                                                      DescriptorInfo* di) {
   intptr_t new_mask = di->Mask();
+  if (control_ring_ != NULL) {
+    QueueEpollUpdate(old_mask, new_mask, di);
+    return;
+  }
   if ((old_mask != 0) && (new_mask == 0)) {
     RemoveFromEpollInstance(epoll_fd_, di);
   } else if ((old_mask == 0) && (new_mask != 0)) {
@@ -147,6 +481,37 @@ void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
   }
 }
 
+void EventHandlerImplementation::QueueEpollUpdate(intptr_t old_mask,
+                                                  intptr_t new_mask,
+                                                  DescriptorInfo* di) {
+  const intptr_t fd = di->fd();
+  if ((old_mask != 0) && (new_mask == 0)) {
+    control_ring_->QueueControl(EPOLL_CTL_DEL, fd, 0, NULL, false);
+  } else if ((old_mask == 0) && (new_mask != 0)) {
+    control_ring_->QueueControl(EPOLL_CTL_ADD, fd, GetEpollEvents(di), di,
+                                false);
+  } else if ((old_mask != 0) && (new_mask != 0) && (old_mask != new_mask)) {
+    ASSERT(!di->IsListeningSocket());
+    control_ring_->QueueControl(EPOLL_CTL_DEL, fd, 0, NULL, true);
+    control_ring_->QueueControl(EPOLL_CTL_ADD, fd, GetEpollEvents(di), di,
+                                false);
+  }
+  HandleFailedEpollAdds();
+}
+
+void EventHandlerImplementation::HandleFailedEpollAdds() {
+  intptr_t fd;
+  while ((fd = control_ring_->NextFailedAdd()) != -1) {
+    SimpleHashMap::Entry* entry = socket_map_.Lookup(
+        GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd), false);
+    if (entry != NULL) {
+      // See AddToEpollInstance.
+      DescriptorInfo* di = reinterpret_cast<DescriptorInfo*>(entry->value);
+      di->NotifyAllDartPorts(1 << kCloseEvent);
+    }
+  }
+}
+
 DescriptorInfo* EventHandlerImplementation::GetDescriptorInfo(
     intptr_t fd,
     bool is_listening) {
@@ -228,6 +593,13 @@ void EventHandlerImplementation::HandleInterruptFd() {
         }
         intptr_t new_mask = di->Mask();
         UpdateEpollInstance(old_mask, di);
+        if (control_ring_ != NULL) {
+          // The descriptor has to leave the epoll instance before it is
+          // closed and its number can be reused. Submit only returns once
+          // the removal has completed.
+          control_ring_->Submit(false);
+          HandleFailedEpollAdds();
+        }
 
         intptr_t fd = di->fd();
         ASSERT(fd == socket->fd());
@@ -384,32 +756,59 @@ void EventHandlerImplementation::Poll(uword args) {
   ThreadSignalBlocker signal_blocker(SIGPROF);
   static const intptr_t kMaxEvents = 16;
   struct epoll_event events[kMaxEvents];
-  EventHandler* handler = reinterpret_cast<EventHandler*>(args);
-  EventHandlerImplementation* handler_impl = &handler->delegate_;
+  EventHandlerImplementation* handler_impl =
+      reinterpret_cast<EventHandlerImplementation*>(args);
   ASSERT(handler_impl != NULL);
+  EventHandler* handler = handler_impl->handler_;
+  EventHandlerImplementation* first_loop = &handler->delegate_;
+
+  EpollControlRing* control_ring = handler_impl->control_ring_;
 
   while (!handler_impl->shutdown_) {
+    intptr_t timeout = -1;
+    if ((control_ring != NULL) && control_ring->has_pending()) {
+      // Submit the queued epoll_ctl operations and wait for events with a
+      // single system call, then harvest the events without blocking.
+      control_ring->Submit(true);
+      handler_impl->HandleFailedEpollAdds();
+      timeout = 0;
+    }
     intptr_t result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
-        epoll_wait(handler_impl->epoll_fd_, events, kMaxEvents, -1));
+        epoll_wait(handler_impl->epoll_fd_, events, kMaxEvents, timeout));
     ASSERT(EAGAIN == EWOULDBLOCK);
-    if (result <= 0) {
+    if (result < 0) {
       if (errno != EWOULDBLOCK) {
         perror("Poll failed");
       }
-    } else {
+    } else if (result > 0) {
       handler_impl->HandleEvents(events, result);
     }
   }
-  DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
-  handler->NotifyShutdownDone();
+  // The last loop to stop reports the shutdown. Loops must not be touched
+  // afterwards as they are deleted together with the event handler.
+  if (first_loop->running_loops_.fetch_sub(1) == 1) {
+    DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
+    handler->NotifyShutdownDone();
+  }
 }
 
 void EventHandlerImplementation::Start(EventHandler* handler) {
-  int result =
-      Thread::Start("dart:io EventHandler", &EventHandlerImplementation::Poll,
-                    reinterpret_cast<uword>(handler));
-  if (result != 0) {
-    FATAL1("Failed to start event handler thread %d", result);
+  ASSERT(this == &handler->delegate_);
+  loop_count_ = EventHandler::loop_count();
+  loops_ = new EventHandlerImplementation*[loop_count_];
+  loops_[0] = this;
+  for (intptr_t i = 1; i < loop_count_; i++) {
+    loops_[i] = new EventHandlerImplementation();
+  }
+  running_loops_ = loop_count_;
+  for (intptr_t i = 0; i < loop_count_; i++) {
+    loops_[i]->handler_ = handler;
+    int result =
+        Thread::Start("dart:io EventHandler", &EventHandlerImplementation::Poll,
+                      reinterpret_cast<uword>(loops_[i]));
+    if (result != 0) {
+      FATAL1("Failed to start event handler thread %d", result);
+    }
   }
 }
 
@@ -417,10 +816,37 @@ void EventHandlerImplementation::Shutdown() {
   SendData(kShutdownId, 0, 0);
 }
 
+EventHandlerImplementation* EventHandlerImplementation::LoopFor(
+    intptr_t id,
+    Dart_Port dart_port) {
+  if (loop_count_ <= 1) {
+    return this;
+  }
+  // All messages for a descriptor have to be handled by the same loop, so
+  // sockets are assigned by the descriptor they were created with. The
+  // current one is reset when the socket is closed, possibly concurrently.
+  // Listening sockets shared between isolates use a single descriptor and
+  // therefore end up in the same loop. Timers are assigned by the port they
+  // notify.
+  uword key;
+  if (id == kTimerId) {
+    key = static_cast<uword>(dart_port);
+  } else {
+    key = static_cast<uword>(reinterpret_cast<Socket*>(id)->initial_fd());
+  }
+  return loops_[dart::Utils::WordHash(key) % loop_count_];
+}
+
 void EventHandlerImplementation::SendData(intptr_t id,
                                           Dart_Port dart_port,
                                           int64_t data) {
-  WakeupHandler(id, dart_port, data);
+  if ((id == kShutdownId) && (loop_count_ > 1)) {
+    for (intptr_t i = 0; i < loop_count_; i++) {
+      loops_[i]->WakeupHandler(id, dart_port, data);
+    }
+    return;
+  }
+  LoopFor(id, dart_port)->WakeupHandler(id, dart_port, data);
 }
 
 void* EventHandlerImplementation::GetHashmapKeyFromFd(intptr_t fd) {
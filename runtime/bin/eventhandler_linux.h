@@ -14,6 +14,8 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <atomic>
+
 #include "platform/hashmap.h"
 #include "platform/signal_blocker.h"
 
@@ -58,6 +60,8 @@ class DescriptorInfoMultiple
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfoMultiple);
 };
 
+class EpollControlRing;
+
 class EventHandlerImplementation {
  public:
   EventHandlerImplementation();
@@ -74,6 +78,11 @@ class EventHandlerImplementation {
 
  private:
   void HandleEvents(struct epoll_event* events, int size);
+  void QueueEpollUpdate(intptr_t old_mask,
+                        intptr_t new_mask,
+                        DescriptorInfo* di);
+  void HandleFailedEpollAdds();
+  EventHandlerImplementation* LoopFor(intptr_t id, Dart_Port dart_port);
   static void Poll(uword args);
   void WakeupHandler(intptr_t id, Dart_Port dart_port, int64_t data);
   void HandleInterruptFd();
@@ -89,6 +98,17 @@ class EventHandlerImplementation {
   int interrupt_fds_[2];
   int epoll_fd_;
   int timer_fd_;
+  // Batches epoll_ctl operations through io_uring when it is enabled and
+  // supported by the kernel, NULL otherwise.
+  EpollControlRing* control_ring_;
+
+  // With EventHandler::loop_count() > 1 every loop runs on its own thread
+  // with its own epoll instance, timer and descriptor map. The first loop
+  // owns the others and routes messages to them.
+  EventHandler* handler_;
+  EventHandlerImplementation** loops_;
+  intptr_t loop_count_;
+  std::atomic<intptr_t> running_loops_;
 
   DISALLOW_COPY_AND_ASSIGN(EventHandlerImplementation);
 };
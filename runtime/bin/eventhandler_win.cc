@@ -684,6 +684,39 @@ intptr_t Handle::Write(const void* buffer, intptr_t num_bytes) {
   return truncated_bytes;
 }
 
+intptr_t Handle::WriteV(const void* const* buffers,
+                        const intptr_t* lengths,
+                        intptr_t count) {
+  MonitorLocker ml(&monitor_);
+  if (HasPendingWrite()) {
+    return 0;
+  }
+  intptr_t num_bytes = 0;
+  for (intptr_t i = 0; (i < count) && (num_bytes < kBufferSize); i++) {
+    num_bytes += lengths[i];
+  }
+  if (num_bytes > kBufferSize) {
+    num_bytes = kBufferSize;
+  }
+  ASSERT(SupportsOverlappedIO());
+  if (completion_port_ == INVALID_HANDLE_VALUE) {
+    return 0;
+  }
+  pending_write_ = OverlappedBuffer::AllocateWriteBuffer(num_bytes);
+  char* data = pending_write_->GetBufferStart();
+  intptr_t copied = 0;
+  for (intptr_t i = 0; (i < count) && (copied < num_bytes); i++) {
+    intptr_t length = Utils::Minimum(lengths[i], num_bytes - copied);
+    memmove(data + copied, buffers[i], length);
+    copied += length;
+  }
+  pending_write_->set_data_length(num_bytes);
+  if (!IssueWrite()) {
+    return -1;
+  }
+  return num_bytes;
+}
+
 intptr_t Handle::SendTo(const void* buffer,
                         intptr_t num_bytes,
                         struct sockaddr* sa,
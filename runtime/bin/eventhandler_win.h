@@ -179,6 +179,10 @@ class Handle : public ReferenceCounted<Handle>, public DescriptorInfoBase {
                     struct sockaddr* sa,
                     socklen_t addr_len);
   virtual intptr_t Write(const void* buffer, intptr_t num_bytes);
+  // Gathers the [count] buffers into a single pending write.
+  intptr_t WriteV(const void* const* buffers,
+                  const intptr_t* lengths,
+                  intptr_t count);
   virtual intptr_t SendTo(const void* buffer,
                           intptr_t num_bytes,
                           struct sockaddr* sa,
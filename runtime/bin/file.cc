@@ -498,6 +498,56 @@ void FUNCTION_NAME(File_Lock)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
 }
 
+static void MappedMemoryFinalizer(void* isolate_callback_data,
+                                  Dart_WeakPersistentHandle handle,
+                                  void* peer) {
+  delete reinterpret_cast<MappedMemory*>(peer);
+}
+
+void FUNCTION_NAME(File_Map)(Dart_NativeArguments args) {
+  File* file = GetFile(args);
+  ASSERT(file != NULL);
+  int64_t start;
+  int64_t end;
+  int64_t advice;
+  if (!DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 1), &start) ||
+      !DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 2), &end) ||
+      !DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 3), &advice) ||
+      (start < 0) || (end <= start) || (end - start > kIntptrMax) ||
+      (advice < MappedMemory::kAdviceNormal) ||
+      (advice > MappedMemory::kAdviceWillNeed)) {
+    OSError os_error(-1, "Invalid argument", OSError::kUnknown);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    return;
+  }
+  // The mapping has to start at an aligned position, so it may begin a bit
+  // before the requested range.
+  const int64_t offset = start % File::MapAlignment();
+  const intptr_t length = static_cast<intptr_t>(end - start);
+  // Map may move the file position on platforms that copy the contents.
+  const int64_t position = file->Position();
+  // Mapped read-only. The Dart side only hands out an unmodifiable view.
+  MappedMemory* mapping =
+      file->Map(File::kReadOnly, start - offset, length + offset);
+  if ((position >= 0) && (file->Position() != position)) {
+    file->SetPosition(position);
+  }
+  if (mapping == NULL) {
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    return;
+  }
+  mapping->Advise(static_cast<MappedMemory::Advice>(advice));
+  Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8,
+      reinterpret_cast<uint8_t*>(mapping->address()) + offset, length,
+      mapping, length, MappedMemoryFinalizer);
+  if (Dart_IsError(result)) {
+    delete mapping;
+    Dart_PropagateError(result);
+  }
+  Dart_SetReturnValue(args, result);
+}
+
 void FUNCTION_NAME(File_Create)(Dart_NativeArguments args) {
   Namespace* namespc = Namespace::GetNamespace(args, 0);
   Dart_Handle path_handle = Dart_GetNativeArgument(args, 1);
@@ -1510,6 +1560,88 @@ CObject* File::LockRequest(const CObjectArray& request) {
              : CObject::NewOSError();
 }
 
+// The status of a ReadAll request, sent as the first element of the
+// response. Keep in sync with _File in sdk/lib/io/file_impl.dart.
+enum ReadAllStatus {
+  kReadAllSuccess = 0,
+  kReadAllUnsupported = 1,
+  kReadAllOpenFailed = 2,
+  kReadAllLengthFailed = 3,
+  kReadAllReadFailed = 4,
+};
+
+static CObject* ReadAllResponse(ReadAllStatus status, CObject* payload) {
+  CObjectArray* result = new CObjectArray(CObject::NewArray(2));
+  result->SetAt(0, new CObjectInt32(CObject::NewInt32(status)));
+  result->SetAt(1, payload);
+  return result;
+}
+
+CObject* File::ReadAllRequest(const CObjectArray& request) {
+  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
+    return ReadAllResponse(kReadAllOpenFailed, CObject::IllegalArgumentError());
+  }
+  Namespace* namespc = CObjectToNamespacePointer(request[0]);
+  RefCntReleaseScope<Namespace> rs(namespc);
+  if ((request.Length() != 2) || !request[1]->IsUint8Array()) {
+    return ReadAllResponse(kReadAllOpenFailed, CObject::IllegalArgumentError());
+  }
+  CObjectUint8Array filename(request[1]);
+  File* file = File::Open(
+      namespc, reinterpret_cast<const char*>(filename.Buffer()), File::kRead);
+  if (file == NULL) {
+    return ReadAllResponse(kReadAllOpenFailed, CObject::NewOSError());
+  }
+  // Dropping the only reference closes the file.
+  RefCntReleaseScope<File> file_scope(file);
+  const int64_t length = file->Length();
+  if (length < 0) {
+    return ReadAllResponse(kReadAllLengthFailed, CObject::NewOSError());
+  }
+  if (length > kIntptrMax) {
+    // Too large for a single buffer, let the caller read it in parts.
+    return ReadAllResponse(kReadAllUnsupported, CObject::Null());
+  }
+  // A length of zero may be a character device, in which case the data is
+  // read in growing chunks until the end of the file.
+  const intptr_t kChunkSize = 64 * KB;
+  intptr_t capacity =
+      (length > 0) ? static_cast<intptr_t>(length) : kChunkSize;
+  uint8_t* data = IOBuffer::Allocate(capacity);
+  if (data == NULL) {
+    return ReadAllResponse(kReadAllReadFailed, CObject::NewOSError());
+  }
+  intptr_t size = 0;
+  while (true) {
+    if (size == capacity) {
+      if (length > 0) {
+        // Like File.read(length), do not read past the length seen above.
+        break;
+      }
+      uint8_t* new_data = IOBuffer::Reallocate(data, capacity * 2);
+      if (new_data == NULL) {
+        IOBuffer::Free(data);
+        return ReadAllResponse(kReadAllReadFailed, CObject::NewOSError());
+      }
+      data = new_data;
+      capacity *= 2;
+    }
+    const int64_t bytes_read = file->Read(data + size, capacity - size);
+    if (bytes_read < 0) {
+      IOBuffer::Free(data);
+      return ReadAllResponse(kReadAllReadFailed, CObject::NewOSError());
+    }
+    if (bytes_read == 0) {
+      break;
+    }
+    size += bytes_read;
+  }
+  return ReadAllResponse(
+      kReadAllSuccess,
+      new CObjectExternalUint8Array(CObject::NewExternalUint8Array(
+          size, data, data, IOBuffer::Finalizer)));
+}
+
 // Inspired by sdk/lib/core/uri.dart
 UriDecoder::UriDecoder(const char* uri) : uri_(uri) {
   const char* ch = uri;
@@ -31,10 +31,22 @@ class MappedMemory {
     if (should_unmap_) Unmap();
   }
 
+  // Keep in sync with FileMapAdvice in sdk/lib/io/file.dart.
+  enum Advice {
+    kAdviceNormal = 0,
+    kAdviceSequential = 1,
+    kAdviceRandom = 2,
+    kAdviceWillNeed = 3,
+  };
+
   void* address() const { return address_; }
   intptr_t size() const { return size_; }
   uword start() const { return reinterpret_cast<uword>(address()); }
 
+  // Tells the OS how the mapping is going to be accessed. This is only a
+  // hint and is ignored on platforms without madvise.
+  void Advise(Advice advice);
+
  private:
   void Unmap();
 
@@ -136,6 +148,9 @@ class File : public ReferenceCounted<File> {
                     int64_t length,
                     void* start = nullptr);
 
+  // The alignment required for the 'position' passed to Map.
+  static intptr_t MapAlignment();
+
   // Read/Write attempt to transfer num_bytes to/from buffer. It returns
   // the number of bytes read/written.
   int64_t Read(void* buffer, int64_t num_bytes);
@@ -175,6 +190,15 @@ class File : public ReferenceCounted<File> {
   // Flush contents of file.
   bool Flush();
 
+  // Send up to [length] bytes of the file, starting at [offset], to the
+  // non-blocking socket [socket_fd] without copying them through user space.
+  // The file position is not changed. Returns the number of bytes sent, 0 if
+  // the socket would block, kSendToSocketEndOfFile if [offset] is at or past
+  // the end of the file, or -1 on error. errno is ENOSYS on platforms where
+  // this is not supported.
+  static const int64_t kSendToSocketEndOfFile = -2;
+  int64_t SendToSocket(intptr_t socket_fd, int64_t offset, int64_t length);
+
   // Lock range of a file.
   bool Lock(LockType lock, int64_t start, int64_t end);
 
@@ -318,6 +342,7 @@ class File : public ReferenceCounted<File> {
   static CObject* IdenticalRequest(const CObjectArray& request);
   static CObject* StatRequest(const CObjectArray& request);
   static CObject* LockRequest(const CObjectArray& request);
+  static CObject* ReadAllRequest(const CObjectArray& request);
 
  private:
   explicit File(FileHandle* handle)
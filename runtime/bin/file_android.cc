@@ -109,6 +109,30 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::Advise(Advice advice) {
+  int hint = MADV_NORMAL;
+  switch (advice) {
+    case kAdviceNormal:
+      hint = MADV_NORMAL;
+      break;
+    case kAdviceSequential:
+      hint = MADV_SEQUENTIAL;
+      break;
+    case kAdviceRandom:
+      hint = MADV_RANDOM;
+      break;
+    case kAdviceWillNeed:
+      hint = MADV_WILLNEED;
+      break;
+  }
+  // The advice is only a hint, so failures are ignored.
+  VOID_NO_RETRY_EXPECTED(madvise(address_, size_, hint));
+}
+
+intptr_t File::MapAlignment() {
+  return sysconf(_SC_PAGESIZE);
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
@@ -159,6 +183,28 @@ bool File::Flush() {
   return NO_RETRY_EXPECTED(fsync(handle_->fd()) != -1);
 }
 
+int64_t File::SendToSocket(intptr_t socket_fd,
+                           int64_t offset,
+                           int64_t length) {
+  ASSERT(handle_->fd() >= 0);
+  ASSERT(length > 0);
+  // off_t is 32 bits wide on 32-bit Android, so use the 64-bit variant.
+  off64_t file_offset = offset;
+  // sendfile sends at most 2GB at once anyway, and the count is a size_t.
+  const size_t count = (length < kMaxInt32) ? length : kMaxInt32;
+  int64_t sent = TEMP_FAILURE_RETRY(
+      sendfile64(socket_fd, handle_->fd(), &file_offset, count));
+  if ((sent == -1) && (errno == EAGAIN)) {
+    // The socket would block, so the caller needs to wait for it to become
+    // writable again.
+    sent = 0;
+  } else if (sent == 0) {
+    // The file is shorter than expected.
+    sent = kSendToSocketEndOfFile;
+  }
+  return sent;
+}
+
 bool File::Lock(File::LockType lock, int64_t start, int64_t end) {
   ASSERT(handle_->fd() >= 0);
   ASSERT((end == -1) || (end > start));
@@ -111,6 +111,14 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::Advise(Advice advice) {
+  // madvise is not supported on Fuchsia.
+}
+
+intptr_t File::MapAlignment() {
+  return sysconf(_SC_PAGESIZE);
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return NO_RETRY_EXPECTED(read(handle_->fd(), buffer, num_bytes));
@@ -161,6 +169,13 @@ bool File::Flush() {
   return NO_RETRY_EXPECTED(fsync(handle_->fd())) != -1;
 }
 
+int64_t File::SendToSocket(intptr_t socket_fd,
+                           int64_t offset,
+                           int64_t length) {
+  errno = ENOSYS;
+  return -1;
+}
+
 bool File::Lock(File::LockType lock, int64_t start, int64_t end) {
   ASSERT(handle_->fd() >= 0);
   ASSERT((end == -1) || (end > start));
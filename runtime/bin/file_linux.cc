@@ -13,6 +13,7 @@
 #include <sys/mman.h>      // NOLINT
 #include <sys/sendfile.h>  // NOLINT
 #include <sys/stat.h>      // NOLINT
+#include <sys/syscall.h>   // NOLINT
 #include <sys/types.h>     // NOLINT
 #include <unistd.h>        // NOLINT
 #include <utime.h>         // NOLINT
@@ -108,6 +109,30 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::Advise(Advice advice) {
+  int hint = MADV_NORMAL;
+  switch (advice) {
+    case kAdviceNormal:
+      hint = MADV_NORMAL;
+      break;
+    case kAdviceSequential:
+      hint = MADV_SEQUENTIAL;
+      break;
+    case kAdviceRandom:
+      hint = MADV_RANDOM;
+      break;
+    case kAdviceWillNeed:
+      hint = MADV_WILLNEED;
+      break;
+  }
+  // The advice is only a hint, so failures are ignored.
+  VOID_NO_RETRY_EXPECTED(madvise(address_, size_, hint));
+}
+
+intptr_t File::MapAlignment() {
+  return sysconf(_SC_PAGESIZE);
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
@@ -158,6 +183,26 @@ bool File::Flush() {
   return NO_RETRY_EXPECTED(fsync(handle_->fd())) != -1;
 }
 
+int64_t File::SendToSocket(intptr_t socket_fd,
+                           int64_t offset,
+                           int64_t length) {
+  ASSERT(handle_->fd() >= 0);
+  ASSERT(length > 0);
+  // sendfile sends at most 2GB at once anyway, and the count is a size_t.
+  const size_t count = (length < kMaxInt32) ? length : kMaxInt32;
+  int64_t sent = TEMP_FAILURE_RETRY(
+      sendfile64(socket_fd, handle_->fd(), &offset, count));
+  if ((sent == -1) && (errno == EAGAIN)) {
+    // The socket would block, so the caller needs to wait for it to become
+    // writable again.
+    sent = 0;
+  } else if (sent == 0) {
+    // The file is shorter than expected.
+    sent = kSendToSocketEndOfFile;
+  }
+  return sent;
+}
+
 bool File::Lock(File::LockType lock, int64_t start, int64_t end) {
   ASSERT(handle_->fd() >= 0);
   ASSERT((end == -1) || (end > start));
@@ -426,6 +471,25 @@ bool File::Copy(Namespace* namespc,
   }
   int64_t offset = 0;
   intptr_t result = 1;
+#if defined(__NR_copy_file_range)
+  // copy_file_range lets the file system do the copy itself, e.g. by sharing
+  // extents on file systems that support reflinks, without the data passing
+  // through a pipe. Files that report a zero size, such as those in /proc, are
+  // left to sendfile as some kernels copy nothing from them.
+  if (st.st_size > 0) {
+    while ((result > 0) && (offset < st.st_size)) {
+      result = NO_RETRY_EXPECTED(syscall(__NR_copy_file_range, old_fd, &offset,
+                                         new_fd, NULL, kMaxUint32, 0));
+    }
+    // Older kernels do not support copying between file systems or do not
+    // support the system call at all. Let sendfile copy whatever is left,
+    // which normally is nothing.
+    if ((result >= 0) || (errno == EXDEV) || (errno == ENOSYS) ||
+        (errno == EINVAL) || (errno == EOPNOTSUPP)) {
+      result = 1;
+    }
+  }
+#endif
   while (result > 0) {
     // Loop to ensure we copy everything, and not only up to 2GB.
     result = NO_RETRY_EXPECTED(sendfile64(new_fd, old_fd, &offset, kMaxUint32));
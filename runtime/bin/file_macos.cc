@@ -155,6 +155,30 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::Advise(Advice advice) {
+  int hint = MADV_NORMAL;
+  switch (advice) {
+    case kAdviceNormal:
+      hint = MADV_NORMAL;
+      break;
+    case kAdviceSequential:
+      hint = MADV_SEQUENTIAL;
+      break;
+    case kAdviceRandom:
+      hint = MADV_RANDOM;
+      break;
+    case kAdviceWillNeed:
+      hint = MADV_WILLNEED;
+      break;
+  }
+  // The advice is only a hint, so failures are ignored.
+  VOID_NO_RETRY_EXPECTED(madvise(address_, size_, hint));
+}
+
+intptr_t File::MapAlignment() {
+  return sysconf(_SC_PAGESIZE);
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
@@ -206,6 +230,13 @@ bool File::Flush() {
   return NO_RETRY_EXPECTED(fsync(handle_->fd())) != -1;
 }
 
+int64_t File::SendToSocket(intptr_t socket_fd,
+                           int64_t offset,
+                           int64_t length) {
+  errno = ENOSYS;
+  return -1;
+}
+
 bool File::Lock(File::LockType lock, int64_t start, int64_t end) {
   ASSERT(handle_->fd() >= 0);
   ASSERT((end == -1) || (end > start));
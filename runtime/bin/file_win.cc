@@ -145,6 +145,15 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::Advise(Advice advice) {
+  // The mapping is a copy of the file contents, so there is nothing to advise.
+}
+
+intptr_t File::MapAlignment() {
+  // Map copies the file contents, so any position can be used.
+  return 1;
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return Utils::Read(handle_->fd(), buffer, num_bytes);
@@ -223,6 +232,13 @@ bool File::Flush() {
   return _commit(handle_->fd()) != -1;
 }
 
+int64_t File::SendToSocket(intptr_t socket_fd,
+                           int64_t offset,
+                           int64_t length) {
+  errno = ENOSYS;
+  return -1;
+}
+
 bool File::Lock(File::LockType lock, int64_t start, int64_t end) {
   ASSERT(handle_->fd() >= 0);
   ASSERT((end == -1) || (end > start));
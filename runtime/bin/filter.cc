@@ -8,6 +8,7 @@
 #include "bin/io_buffer.h"
 
 #include "include/dart_api.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -256,6 +257,199 @@ void FUNCTION_NAME(Filter_Processed)(Dart_NativeArguments args) {
   }
 }
 
+// Runs all of [data] through [filter], into an IO buffer starting with
+// [capacity] bytes and growing as needed.
+static CObject* FilterAll(Filter* filter,
+                          const CObjectUint8Array& data,
+                          intptr_t capacity) {
+  // Process takes ownership of the copy, if successful.
+  uint8_t* input = new uint8_t[data.Length()];
+  memmove(input, data.Buffer(), data.Length());
+  if (!filter->Process(input, data.Length())) {
+    delete[] input;
+    return CObject::IllegalArgumentError();
+  }
+  uint8_t* buffer = IOBuffer::Allocate(capacity);
+  if (buffer == NULL) {
+    return CObject::NewOSError();
+  }
+  intptr_t size = 0;
+  while (true) {
+    if (size == capacity) {
+      uint8_t* new_buffer = IOBuffer::Reallocate(buffer, capacity * 2);
+      if (new_buffer == NULL) {
+        IOBuffer::Free(buffer);
+        return CObject::NewOSError();
+      }
+      buffer = new_buffer;
+      capacity *= 2;
+    }
+    intptr_t processed =
+        filter->Processed(buffer + size, capacity - size, false, true);
+    if (processed < 0) {
+      IOBuffer::Free(buffer);
+      return CObject::IllegalArgumentError();
+    }
+    if (processed == 0) {
+      break;
+    }
+    size += processed;
+  }
+  CObjectArray* result = new CObjectArray(CObject::NewArray(2));
+  result->SetAt(0, new CObjectIntptr(CObject::NewInt32(0)));
+  result->SetAt(1, new CObjectExternalUint8Array(CObject::NewExternalUint8Array(
+                       size, buffer, buffer, IOBuffer::Finalizer)));
+  return result;
+}
+
+static uint8_t* CopyDictionary(CObject* dictionary_object,
+                               intptr_t* dictionary_length) {
+  *dictionary_length = 0;
+  if (!dictionary_object->IsUint8Array()) {
+    return NULL;
+  }
+  CObjectUint8Array dictionary(dictionary_object);
+  uint8_t* result = new uint8_t[dictionary.Length()];
+  memmove(result, dictionary.Buffer(), dictionary.Length());
+  *dictionary_length = dictionary.Length();
+  return result;
+}
+
+CObject* Filter::DeflateRequest(const CObjectArray& request) {
+  if ((request.Length() != 8) || !request[0]->IsUint8Array() ||
+      !request[1]->IsBool() || !request[2]->IsInt32() ||
+      !request[3]->IsInt32() || !request[4]->IsInt32() ||
+      !request[5]->IsInt32() ||
+      !(request[6]->IsNull() || request[6]->IsUint8Array()) ||
+      !request[7]->IsBool()) {
+    return CObject::IllegalArgumentError();
+  }
+  CObjectUint8Array data(request[0]);
+  intptr_t dictionary_length;
+  uint8_t* dictionary = CopyDictionary(request[6], &dictionary_length);
+  ZLibDeflateFilter* filter = new ZLibDeflateFilter(
+      CObjectBool(request[1]).Value(), CObjectInt32(request[2]).Value(),
+      CObjectInt32(request[3]).Value(), CObjectInt32(request[4]).Value(),
+      CObjectInt32(request[5]).Value(), dictionary, dictionary_length,
+      CObjectBool(request[7]).Value());
+  CObject* result;
+  if (filter->Init()) {
+    // Large enough for the whole output, including a gzip header and trailer.
+    result = FilterAll(filter, data, deflateBound(NULL, data.Length()) + 32);
+  } else {
+    result = CObject::IllegalArgumentError();
+  }
+  delete filter;
+  return result;
+}
+
+CObject* Filter::InflateRequest(const CObjectArray& request) {
+  if ((request.Length() != 4) || !request[0]->IsUint8Array() ||
+      !request[1]->IsInt32() ||
+      !(request[2]->IsNull() || request[2]->IsUint8Array()) ||
+      !request[3]->IsBool()) {
+    return CObject::IllegalArgumentError();
+  }
+  CObjectUint8Array data(request[0]);
+  intptr_t dictionary_length;
+  uint8_t* dictionary = CopyDictionary(request[2], &dictionary_length);
+  ZLibInflateFilter* filter =
+      new ZLibInflateFilter(CObjectInt32(request[1]).Value(), dictionary,
+                            dictionary_length, CObjectBool(request[3]).Value());
+  CObject* result;
+  if (filter->Init()) {
+    // Guess a typical compression ratio, the buffer grows as needed.
+    result = FilterAll(filter, data,
+                       Utils::Maximum<intptr_t>(4 * data.Length(), 4 * KB));
+  } else {
+    result = CObject::IllegalArgumentError();
+  }
+  delete filter;
+  return result;
+}
+
+// The request is the block preceded by up to 32KB of the data before it, as
+// the dictionary, so that blocks compress almost as well as a single stream.
+// Blocks are compressed as raw deflate data, flushed to a byte boundary
+// unless [last], so that they can be concatenated. The reply is the
+// compressed block and the CRC-32 or Adler-32 checksum of its data.
+CObject* Filter::DeflateBlockRequest(const CObjectArray& request) {
+  if ((request.Length() != 7) || !request[0]->IsUint8Array() ||
+      !request[1]->IsInt32() || !request[2]->IsInt32() ||
+      !request[3]->IsInt32() || !request[4]->IsInt32() ||
+      !request[5]->IsBool() || !request[6]->IsBool()) {
+    return CObject::IllegalArgumentError();
+  }
+  CObjectUint8Array data(request[0]);
+  const intptr_t dictionary_length = CObjectInt32(request[1]).Value();
+  const int32_t level = CObjectInt32(request[2]).Value();
+  const int32_t mem_level = CObjectInt32(request[3]).Value();
+  const int32_t strategy = CObjectInt32(request[4]).Value();
+  const bool last = CObjectBool(request[5]).Value();
+  const bool gzip = CObjectBool(request[6]).Value();
+  if ((dictionary_length < 0) || (dictionary_length > data.Length())) {
+    return CObject::IllegalArgumentError();
+  }
+  uint8_t* block = data.Buffer() + dictionary_length;
+  const intptr_t block_length = data.Length() - dictionary_length;
+
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, mem_level,
+                   strategy) != Z_OK) {
+    return CObject::IllegalArgumentError();
+  }
+  if ((dictionary_length > 0) &&
+      (deflateSetDictionary(&stream, data.Buffer(), dictionary_length) !=
+       Z_OK)) {
+    deflateEnd(&stream);
+    return CObject::IllegalArgumentError();
+  }
+  // A sync flush adds an empty stored block to the bound.
+  intptr_t capacity = deflateBound(&stream, block_length) + 16;
+  uint8_t* buffer = IOBuffer::Allocate(capacity);
+  if (buffer == NULL) {
+    deflateEnd(&stream);
+    return CObject::NewOSError();
+  }
+  stream.next_in = block;
+  stream.avail_in = block_length;
+  stream.next_out = buffer;
+  stream.avail_out = capacity;
+  int status = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+  const intptr_t size = capacity - stream.avail_out;
+  deflateEnd(&stream);
+  if ((status != (last ? Z_STREAM_END : Z_OK)) || (stream.avail_in != 0)) {
+    IOBuffer::Free(buffer);
+    return CObject::IllegalArgumentError();
+  }
+  uLong checksum = gzip ? crc32(0, Z_NULL, 0) : adler32(0, Z_NULL, 0);
+  checksum = gzip ? crc32(checksum, block, block_length)
+                  : adler32(checksum, block, block_length);
+
+  CObjectArray* result = new CObjectArray(CObject::NewArray(3));
+  result->SetAt(0, new CObjectIntptr(CObject::NewInt32(0)));
+  result->SetAt(1, new CObjectExternalUint8Array(CObject::NewExternalUint8Array(
+                       size, buffer, buffer, IOBuffer::Finalizer)));
+  result->SetAt(2, new CObjectInt64(CObject::NewInt64(checksum)));
+  return result;
+}
+
+void FUNCTION_NAME(Filter_CombineChecksums)(Dart_NativeArguments args) {
+  bool gzip = DartUtils::GetNativeBooleanArgument(args, 0);
+  int64_t checksum1 = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 1), 0, kMaxUint32);
+  int64_t checksum2 = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 2), 0, kMaxUint32);
+  int64_t length2 = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 3), 0, kMaxInt64);
+  uLong checksum = gzip ? crc32_combine(checksum1, checksum2, length2)
+                        : adler32_combine(checksum1, checksum2, length2);
+  Dart_SetIntegerReturnValue(args, checksum);
+}
+
 static void DeleteFilter(void* isolate_data, void* filter_pointer) {
   Filter* filter = reinterpret_cast<Filter*>(filter_pointer);
   delete filter;
@@ -6,6 +6,7 @@
 #define RUNTIME_BIN_FILTER_H_
 
 #include "bin/builtin.h"
+#include "bin/dartutils.h"
 #include "bin/utils.h"
 
 #include "zlib/zlib.h"
@@ -36,6 +37,13 @@ class Filter {
   static Dart_Handle GetFilterNativeField(Dart_Handle filter,
                                           Filter** filter_pointer);
 
+  // IO service requests filtering a whole buffer on an IO service thread.
+  static CObject* DeflateRequest(const CObjectArray& request);
+  static CObject* InflateRequest(const CObjectArray& request);
+  // Compresses one block of a buffer split for parallel compression, see
+  // ZLibEncoder.convertAsync.
+  static CObject* DeflateBlockRequest(const CObjectArray& request);
+
   bool initialized() const { return initialized_; }
   void set_initialized(bool value) { initialized_ = value; }
   uint8_t* processed_buffer() { return processed_buffer_; }
@@ -20,6 +20,14 @@ class IOBuffer {
   // Allocate IO buffer storage.
   static uint8_t* Allocate(intptr_t size);
 
+  // Create an IO buffer dart object (of type Uint8List) which takes ownership
+  // of storage allocated with Allocate.
+  static Dart_Handle Wrap(uint8_t* data, intptr_t size);
+
+  // Resize IO buffer storage. Returns NULL and leaves the storage untouched
+  // on failure.
+  static uint8_t* Reallocate(uint8_t* buffer, intptr_t new_size);
+
   // Function for disposing of IO buffer storage. All backing storage
   // for IO buffers must be freed using this function.
   static void Free(void* buffer) { free(buffer); }
@@ -53,6 +53,7 @@ namespace bin {
   V(File_LengthFromPath, 2)                                                    \
   V(File_LinkTarget, 2)                                                        \
   V(File_Lock, 4)                                                              \
+  V(File_Map, 4)                                                               \
   V(File_Open, 3)                                                              \
   V(File_OpenStdio, 1)                                                         \
   V(File_Position, 1)                                                          \
@@ -77,6 +78,7 @@ namespace bin {
   V(FileSystemWatcher_ReadEvents, 2)                                           \
   V(FileSystemWatcher_UnwatchPath, 2)                                          \
   V(FileSystemWatcher_WatchPath, 5)                                            \
+  V(Filter_CombineChecksums, 4)                                                \
   V(Filter_CreateZLibDeflate, 8)                                               \
   V(Filter_CreateZLibInflate, 4)                                               \
   V(Filter_Process, 4)                                                         \
@@ -122,12 +124,17 @@ namespace bin {
   V(SecureSocket_NewX509CertificateWrapper, 1)                                 \
   V(SecureSocket_Init, 1)                                                      \
   V(SecureSocket_PeerCertificate, 1)                                           \
+  V(SecureSocket_ProcessAllBuffers, 3)                                         \
   V(SecureSocket_RegisterBadCertificateCallback, 2)                            \
   V(SecureSocket_RegisterHandshakeCompleteCallback, 2)                         \
   V(SecureSocket_Renegotiate, 4)                                               \
+  V(SecureSocket_UseLargeBuffers, 0)                                           \
   V(SecurityContext_Allocate, 1)                                               \
+  V(SecurityContext_ConfigureServerSessionCache, 3)                            \
   V(SecurityContext_UsePrivateKeyBytes, 3)                                     \
   V(SecurityContext_SetAlpnProtocols, 3)                                       \
+  V(SecurityContext_RotateSessionTicketKey, 1)                                 \
+  V(SecurityContext_ServerSessionStatistics, 0)                                \
   V(SecurityContext_SetClientAuthoritiesBytes, 3)                              \
   V(SecurityContext_SetTrustedCertificatesBytes, 3)                            \
   V(SecurityContext_TrustBuiltinRoots, 1)                                      \
@@ -154,12 +161,17 @@ namespace bin {
   V(Socket_JoinMulticast, 4)                                                   \
   V(Socket_LeaveMulticast, 4)                                                  \
   V(Socket_Read, 2)                                                            \
+  V(Socket_ReadInto, 4)                                                        \
   V(Socket_RecvFrom, 1)                                                        \
+  V(Socket_RecvFromBatch, 2)                                                   \
+  V(Socket_SendFile, 4)                                                        \
   V(Socket_SendTo, 6)                                                          \
+  V(Socket_SendToBatch, 4)                                                     \
   V(Socket_SetOption, 4)                                                       \
   V(Socket_SetRawOption, 4)                                                    \
   V(Socket_SetSocketId, 3)                                                     \
   V(Socket_WriteList, 4)                                                       \
+  V(Socket_WriteBuffers, 3)                                                    \
   V(Stdin_ReadByte, 1)                                                         \
   V(Stdin_GetEchoMode, 1)                                                      \
   V(Stdin_SetEchoMode, 2)                                                      \
@@ -9,6 +9,7 @@
 #include "bin/dartutils.h"
 #include "bin/directory.h"
 #include "bin/file.h"
+#include "bin/filter.h"
 #include "bin/io_buffer.h"
 #include "bin/secure_socket_filter.h"
 #include "bin/security_context.h"
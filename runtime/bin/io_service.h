@@ -59,7 +59,11 @@ namespace bin {
   V(Directory, ListNext, 39)                                                   \
   V(Directory, ListStop, 40)                                                   \
   V(Directory, Rename, 41)                                                     \
-  V(SSLFilter, ProcessFilter, 42)
+  V(SSLFilter, ProcessFilter, 42)                                              \
+  V(File, ReadAll, 43)                                                         \
+  V(Filter, Deflate, 44)                                                       \
+  V(Filter, DeflateBlock, 45)                                                  \
+  V(Filter, Inflate, 46)
 
 #define DECLARE_REQUEST(type, method, id) k##type##method##Request = id,
 
@@ -9,6 +9,7 @@
 #include "bin/dartutils.h"
 #include "bin/directory.h"
 #include "bin/file.h"
+#include "bin/filter.h"
 #include "bin/io_buffer.h"
 #include "bin/socket.h"
 #include "bin/utils.h"
@@ -60,7 +60,11 @@ namespace bin {
   V(Directory, ListStart, 38)                                                  \
   V(Directory, ListNext, 39)                                                   \
   V(Directory, ListStop, 40)                                                   \
-  V(Directory, Rename, 41)
+  V(Directory, Rename, 41)                                                     \
+  V(File, ReadAll, 43)                                                         \
+  V(Filter, Deflate, 44)                                                       \
+  V(Filter, DeflateBlock, 45)                                                  \
+  V(Filter, Inflate, 46)
 
 #define DECLARE_REQUEST(type, method, id) k##type##method##Request = id,
 
@@ -10,11 +10,13 @@
 
 #include "bin/dartdev_isolate.h"
 #include "bin/error_exit.h"
+#include "bin/eventhandler.h"
 #include "bin/options.h"
 #include "bin/platform.h"
 #include "bin/utils.h"
 #include "platform/syslog.h"
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
+#include "bin/secure_socket_filter.h"
 #include "bin/security_context.h"
 #endif  // !defined(DART_IO_SECURE_SOCKET_DISABLED)
 #include "bin/socket.h"
@@ -81,6 +83,20 @@ DFE* Options::dfe_ = NULL;
 DEFINE_STRING_OPTION_CB(dfe, { Options::dfe()->set_frontend_filename(value); });
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
+DEFINE_STRING_OPTION_CB(event_handler_loops, {
+  char* end = NULL;
+  const intptr_t loop_count = strtol(value, &end, 10);
+  if ((*end != '\0') || (loop_count < 1) ||
+      (loop_count > EventHandler::kMaxLoopCount)) {
+    Syslog::PrintErr(
+        "Invalid value for event_handler_loops: '%s'\n"
+        "Valid values are 1 to %" Pd "\n",
+        value, EventHandler::kMaxLoopCount);
+    return false;
+  }
+  EventHandler::set_loop_count(loop_count);
+});
+
 static void hot_reload_test_mode_callback(CommandLineOptions* vm_options) {
   // Identity reload.
   vm_options->AddArgument("--identity_reload");
@@ -477,11 +493,14 @@ int Options::ParseArguments(int argc,
 
   Socket::set_short_socket_read(Options::short_socket_read());
   Socket::set_short_socket_write(Options::short_socket_write());
+  EventHandler::set_use_io_uring(Options::use_io_uring());
+  Socket::set_listen_reuse_port(Options::listen_reuse_port());
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLCertContext::set_root_certs_file(Options::root_certs_file());
   SSLCertContext::set_root_certs_cache(Options::root_certs_cache());
   SSLCertContext::set_long_ssl_cert_evaluation(
       Options::long_ssl_cert_evaluation());
+  SSLFilter::set_large_buffers(Options::large_tls_buffers());
 #endif  // !defined(DART_IO_SECURE_SOCKET_DISABLED)
 
   // The arguments to the VM are at positions 1 through i-1 in argv.
@@ -48,7 +48,10 @@ namespace bin {
   V(suppress_core_dump, suppress_core_dump)                                    \
   V(enable_service_port_fallback, enable_service_port_fallback)                \
   V(disable_dart_dev, disable_dart_dev)                                        \
-  V(long_ssl_cert_evaluation, long_ssl_cert_evaluation)
+  V(long_ssl_cert_evaluation, long_ssl_cert_evaluation)                        \
+  V(large_tls_buffers, large_tls_buffers)                                      \
+  V(io_uring, use_io_uring)                                                    \
+  V(listen_reuse_port, listen_reuse_port)
 
 // Boolean flags that have a short form.
 #define SHORT_BOOL_OPTIONS_LIST(V)                                             \
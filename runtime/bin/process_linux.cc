@@ -7,9 +7,11 @@
 
 #include "bin/process.h"
 
+#include <dlfcn.h>         // NOLINT
 #include <errno.h>         // NOLINT
 #include <fcntl.h>         // NOLINT
 #include <poll.h>          // NOLINT
+#include <spawn.h>         // NOLINT
 #include <stdio.h>         // NOLINT
 #include <stdlib.h>        // NOLINT
 #include <string.h>        // NOLINT
@@ -73,11 +75,20 @@ class ProcessInfoList {
 
   static void AddProcess(pid_t pid, intptr_t fd) {
     MutexLocker locker(mutex_);
+    AddProcessLocked(pid, fd);
+  }
+
+  // Adds a process while the caller holds [mutex]. Holding the lock from
+  // before the process is started keeps the exit code handler from looking
+  // up the process before it has been added.
+  static void AddProcessLocked(pid_t pid, intptr_t fd) {
     ProcessInfo* info = new ProcessInfo(pid, fd);
     info->set_next(active_processes_);
     active_processes_ = info;
   }
 
+  static Mutex* mutex() { return mutex_; }
+
   static intptr_t LookupProcessExitFd(pid_t pid) {
     MutexLocker locker(mutex_);
     ProcessInfo* current = active_processes_;
@@ -251,6 +262,34 @@ int ExitCodeHandler::process_count_ = 0;
 bool ExitCodeHandler::terminate_done_ = false;
 Monitor* ExitCodeHandler::monitor_ = nullptr;
 
+// posix_spawn_file_actions_addchdir_np was added in glibc 2.29, so it is
+// looked up when the process support is initialized. NULL if not available.
+typedef int (*SpawnAddChdirFunction)(posix_spawn_file_actions_t* actions,
+                                     const char* path);
+static SpawnAddChdirFunction spawn_add_chdir = NULL;
+
+// Whether posix_spawn reports exec failures, which glibc only does since
+// 2.24. The C library the process runs with can differ from the one it was
+// built against, so this is also determined when the process support is
+// initialized. Other C libraries keep using fork.
+typedef const char* (*GnuGetLibcVersionFunction)();
+static bool use_posix_spawn = false;
+
+static bool PosixSpawnReportsExecFailures() {
+  GnuGetLibcVersionFunction get_version =
+      reinterpret_cast<GnuGetLibcVersionFunction>(
+          dlsym(RTLD_DEFAULT, "gnu_get_libc_version"));
+  if (get_version == NULL) {
+    return false;
+  }
+  int major = 0;
+  int minor = 0;
+  if (sscanf(get_version(), "%d.%d", &major, &minor) != 2) {
+    return false;
+  }
+  return (major > 2) || ((major == 2) && (minor >= 24));
+}
+
 class ProcessStarter {
  public:
   ProcessStarter(Namespace* namespc,
@@ -312,6 +351,146 @@ class ProcessStarter {
       return err;
     }
 
+    pid_t pid;
+    if (!SpawnProcess(&pid)) {
+      err = ForkProcess(&pid);
+      if (err != 0) {
+        return err;
+      }
+    }
+
+    if (Process::ModeHasStdio(mode_)) {
+      // Connect stdio, stdout and stderr.
+      FDUtils::SetNonBlocking(read_in_[0]);
+      *in_ = read_in_[0];
+      close(read_in_[1]);
+      FDUtils::SetNonBlocking(write_out_[1]);
+      *out_ = write_out_[1];
+      close(write_out_[0]);
+      FDUtils::SetNonBlocking(read_err_[0]);
+      *err_ = read_err_[0];
+      close(read_err_[1]);
+    } else {
+      // Close all fds.
+      close(read_in_[0]);
+      close(read_in_[1]);
+      ASSERT(write_out_[0] == -1);
+      ASSERT(write_out_[1] == -1);
+      ASSERT(read_err_[0] == -1);
+      ASSERT(read_err_[1] == -1);
+    }
+    ASSERT(exec_control_[0] == -1);
+    ASSERT(exec_control_[1] == -1);
+
+    *id_ = pid;
+    return 0;
+  }
+
+ private:
+  // Starts an attached process with posix_spawn. glibc implements it with
+  // CLONE_VFORK, so unlike fork it does not copy the page tables of this
+  // process, which gets expensive for large heaps. Returns false if the
+  // process has to be started with fork instead. The fork path is also used
+  // when posix_spawn fails, so that errors are reported the same way.
+  bool SpawnProcess(pid_t* pid) {
+    if (!use_posix_spawn || !Process::ModeIsAttached(mode_) ||
+        !Namespace::IsDefault(namespc_)) {
+      return false;
+    }
+    const bool search_path = strchr(path_, '/') == NULL;
+    if (working_directory_ != NULL) {
+      // A relative path is resolved after changing the working directory.
+      if ((spawn_add_chdir == NULL) || (!search_path && (path_[0] != '/'))) {
+        return false;
+      }
+    }
+    if (search_path && (program_environment_ != NULL) &&
+        !EnvironmentHasSamePath()) {
+      // posix_spawnp searches the PATH of this process, not the PATH of the
+      // new environment as execvp in the forked process does.
+      return false;
+    }
+    if (mode_ == kNormal) {
+      if ((write_out_[0] <= STDERR_FILENO) || (read_in_[1] <= STDERR_FILENO) ||
+          (read_err_[1] <= STDERR_FILENO)) {
+        // dup2 would not clear O_CLOEXEC on a pipe already at the target.
+        return false;
+      }
+    }
+    char realpath[PATH_MAX];
+    if (!FindPathInNamespace(realpath, PATH_MAX)) {
+      return false;
+    }
+
+    posix_spawn_file_actions_t actions;
+    if (posix_spawn_file_actions_init(&actions) != 0) {
+      return false;
+    }
+    bool actions_added = true;
+    if (mode_ == kNormal) {
+      actions_added =
+          (posix_spawn_file_actions_adddup2(&actions, write_out_[0],
+                                            STDIN_FILENO) == 0) &&
+          (posix_spawn_file_actions_adddup2(&actions, read_in_[1],
+                                            STDOUT_FILENO) == 0) &&
+          (posix_spawn_file_actions_adddup2(&actions, read_err_[1],
+                                            STDERR_FILENO) == 0);
+    } else {
+      ASSERT(mode_ == kInheritStdio);
+    }
+    if (actions_added && (working_directory_ != NULL)) {
+      actions_added = spawn_add_chdir(&actions, working_directory_) == 0;
+    }
+    int event_fds[2];
+    if (!actions_added ||
+        (TEMP_FAILURE_RETRY(pipe2(event_fds, O_CLOEXEC)) != 0)) {
+      posix_spawn_file_actions_destroy(&actions);
+      return false;
+    }
+
+    char* const* environment =
+        (program_environment_ != NULL) ? program_environment_ : environ;
+    int result;
+    {
+      // Add the process before the exit code handler can look it up.
+      MutexLocker locker(ProcessInfoList::mutex());
+      result = search_path
+                   ? posix_spawnp(pid, realpath, &actions, NULL,
+                                  program_arguments_, environment)
+                   : posix_spawn(pid, realpath, &actions, NULL,
+                                 program_arguments_, environment);
+      if (result == 0) {
+        ProcessInfoList::AddProcessLocked(*pid, event_fds[1]);
+      }
+    }
+    posix_spawn_file_actions_destroy(&actions);
+    if (result != 0) {
+      close(event_fds[0]);
+      close(event_fds[1]);
+      return false;
+    }
+    ExitCodeHandler::ProcessStarted();
+    *exit_event_ = event_fds[0];
+    FDUtils::SetNonBlocking(event_fds[0]);
+    ClosePipe(exec_control_);
+    return true;
+  }
+
+  // Whether the PATH in the environment for the new process is the same as
+  // the PATH of this process.
+  bool EnvironmentHasSamePath() {
+    const char* path = getenv("PATH");
+    for (intptr_t i = 0; program_environment_[i] != NULL; i++) {
+      if (strncmp(program_environment_[i], "PATH=", 5) == 0) {
+        return (path != NULL) &&
+               (strcmp(program_environment_[i] + 5, path) == 0);
+      }
+    }
+    return path == NULL;
+  }
+
+  int ForkProcess(pid_t* pid_result) {
+    int err;
     // Fork to create the new process.
     pid_t pid = TEMP_FAILURE_RETRY(fork());
     if (pid < 0) {
@@ -371,34 +550,10 @@ class ProcessStarter {
       return err;
     }
 
-    if (Process::ModeHasStdio(mode_)) {
-      // Connect stdio, stdout and stderr.
-      FDUtils::SetNonBlocking(read_in_[0]);
-      *in_ = read_in_[0];
-      close(read_in_[1]);
-      FDUtils::SetNonBlocking(write_out_[1]);
-      *out_ = write_out_[1];
-      close(write_out_[0]);
-      FDUtils::SetNonBlocking(read_err_[0]);
-      *err_ = read_err_[0];
-      close(read_err_[1]);
-    } else {
-      // Close all fds.
-      close(read_in_[0]);
-      close(read_in_[1]);
-      ASSERT(write_out_[0] == -1);
-      ASSERT(write_out_[1] == -1);
-      ASSERT(read_err_[0] == -1);
-      ASSERT(read_err_[1] == -1);
-    }
-    ASSERT(exec_control_[0] == -1);
-    ASSERT(exec_control_[1] == -1);
-
-    *id_ = pid;
+    *pid_result = pid;
     return 0;
   }
 
- private:
   int CreatePipes() {
     int result;
     result = TEMP_FAILURE_RETRY(pipe2(exec_control_, O_CLOEXEC));
@@ -1120,6 +1275,10 @@ void Process::Init() {
   ExitCodeHandler::Init();
   ProcessInfoList::Init();
 
+  spawn_add_chdir = reinterpret_cast<SpawnAddChdirFunction>(
+      dlsym(RTLD_DEFAULT, "posix_spawn_file_actions_addchdir_np"));
+  use_posix_spawn = PosixSpawnReportsExecFailures();
+
   ASSERT(signal_mutex == nullptr);
   signal_mutex = new Mutex();
 
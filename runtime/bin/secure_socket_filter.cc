@@ -28,6 +28,7 @@
 namespace dart {
 namespace bin {
 
+bool SSLFilter::large_buffers_ = false;
 bool SSLFilter::library_initialized_ = false;
 // To protect library initialization.
 Mutex* SSLFilter::mutex_ = nullptr;
@@ -37,17 +38,26 @@ int SSLFilter::ssl_cert_context_index;
 void SSLFilter::Init() {
   ASSERT(SSLFilter::mutex_ == nullptr);
   SSLFilter::mutex_ = new Mutex();
+  SSLSessionCache::Init();
 }
 
 void SSLFilter::Cleanup() {
   ASSERT(SSLFilter::mutex_ != nullptr);
+  SSLSessionCache::Cleanup();
   delete SSLFilter::mutex_;
   SSLFilter::mutex_ = nullptr;
 }
 
-const intptr_t SSLFilter::kInternalBIOSize = 10 * KB;
-const intptr_t SSLFilter::kApproximateSize =
-    sizeof(SSLFilter) + (2 * SSLFilter::kInternalBIOSize);
+// Matches ENCRYPTED_SIZE in secure_socket_patch.dart. With large buffers it
+// holds two full TLS records, so that a filter request can pass several
+// records at a time.
+intptr_t SSLFilter::InternalBIOSize() {
+  return large_buffers_ ? 34 * KB : 10 * KB;
+}
+
+intptr_t SSLFilter::ApproximateSize() {
+  return sizeof(SSLFilter) + (2 * InternalBIOSize());
+}
 
 static SSLFilter* GetFilter(Dart_NativeArguments args) {
   SSLFilter* filter = NULL;
@@ -78,7 +88,7 @@ static Dart_Handle SetFilter(Dart_NativeArguments args, SSLFilter* filter) {
       reinterpret_cast<intptr_t>(filter));
   RETURN_IF_ERROR(err);
   Dart_NewFinalizableHandle(dart_this, reinterpret_cast<void*>(filter),
-                            SSLFilter::kApproximateSize, DeleteFilter);
+                            SSLFilter::ApproximateSize(), DeleteFilter);
   return Dart_Null();
 }
 
@@ -208,6 +218,10 @@ void FUNCTION_NAME(SecureSocket_PeerCertificate)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, cert);
 }
 
+void FUNCTION_NAME(SecureSocket_UseLargeBuffers)(Dart_NativeArguments args) {
+  Dart_SetBooleanReturnValue(args, SSLFilter::large_buffers());
+}
+
 void FUNCTION_NAME(SecureSocket_FilterPointer)(Dart_NativeArguments args) {
   SSLFilter* filter = GetFilter(args);
   // This filter pointer is passed to the IO Service thread. The IO Service
@@ -217,6 +231,44 @@ void FUNCTION_NAME(SecureSocket_FilterPointer)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, Dart_NewInteger(filter_pointer));
 }
 
+// Processes the buffers like ProcessFilterRequest, but synchronously on the
+// isolate's thread, which avoids the round trip to the IO service for small
+// amounts of data. Returns the same response as ProcessFilterRequest.
+void FUNCTION_NAME(SecureSocket_ProcessAllBuffers)(
+    Dart_NativeArguments args) {
+  SSLFilter* filter = GetFilter(args);
+  bool in_handshake =
+      DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 1));
+  Dart_Handle positions = ThrowIfError(Dart_GetNativeArgument(args, 2));
+  int starts[SSLFilter::kNumBuffers];
+  int ends[SSLFilter::kNumBuffers];
+  for (int i = 0; i < SSLFilter::kNumBuffers; ++i) {
+    starts[i] = static_cast<int>(DartUtils::GetIntegerValue(
+        ThrowIfError(Dart_ListGetAt(positions, 2 * i))));
+    ends[i] = static_cast<int>(DartUtils::GetIntegerValue(
+        ThrowIfError(Dart_ListGetAt(positions, 2 * i + 1))));
+  }
+  Dart_Handle result;
+  if (filter->ProcessAllBuffers(starts, ends, in_handshake)) {
+    result = ThrowIfError(Dart_NewList(SSLFilter::kNumBuffers * 2));
+    for (int i = 0; i < SSLFilter::kNumBuffers; ++i) {
+      ThrowIfError(
+          Dart_ListSetAt(result, 2 * i, Dart_NewInteger(starts[i])));
+      ThrowIfError(
+          Dart_ListSetAt(result, 2 * i + 1, Dart_NewInteger(ends[i])));
+    }
+  } else {
+    int32_t error_code = static_cast<int32_t>(ERR_peek_error());
+    TextBuffer error_string(SecureSocketUtils::SSL_ERROR_MESSAGE_BUFFER_SIZE);
+    SecureSocketUtils::FetchErrorString(filter->ssl(), &error_string);
+    result = ThrowIfError(Dart_NewList(2));
+    ThrowIfError(Dart_ListSetAt(result, 0, Dart_NewInteger(error_code)));
+    ThrowIfError(Dart_ListSetAt(
+        result, 1, DartUtils::NewString(error_string.buffer())));
+  }
+  Dart_SetReturnValue(args, result);
+}
+
 /**
  * Pushes data through the SSL filter, reading and writing from circular
  * buffers shared with Dart.
@@ -274,6 +326,23 @@ CObject* SSLFilter::ProcessFilterRequest(const CObjectArray& request) {
 bool SSLFilter::ProcessAllBuffers(int starts[kNumBuffers],
                                   int ends[kNumBuffers],
                                   bool in_handshake) {
+  // Keep passing data through the stages while any of them makes progress,
+  // so that encrypted data read from the socket is decrypted, and plaintext
+  // is encrypted and ready to be written, without another request.
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    if (!ProcessAllBuffersOnce(starts, ends, in_handshake, &progress)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SSLFilter::ProcessAllBuffersOnce(int starts[kNumBuffers],
+                                      int ends[kNumBuffers],
+                                      bool in_handshake,
+                                      bool* progress) {
   for (int i = 0; i < kNumBuffers; ++i) {
     if (in_handshake && (i == kReadPlaintext || i == kWritePlaintext)) continue;
     int start = starts[i];
@@ -309,6 +378,7 @@ bool SSLFilter::ProcessAllBuffers(int starts[kNumBuffers],
           end += bytes;
           ASSERT(end < start);
         }
+        if (ends[i] != end) *progress = true;
         ends[i] = end;
         break;
       case kReadEncrypted:
@@ -334,6 +404,7 @@ bool SSLFilter::ProcessAllBuffers(int starts[kNumBuffers],
           start += bytes;
           ASSERT(start <= end);
         }
+        if (starts[i] != start) *progress = true;
         starts[i] = start;
         break;
       default:
@@ -487,8 +558,8 @@ void SSLFilter::Connect(const char* hostname,
   int status;
   int error;
   BIO* ssl_side;
-  status = BIO_new_bio_pair(&ssl_side, kInternalBIOSize, &socket_side_,
-                            kInternalBIOSize);
+  status = BIO_new_bio_pair(&ssl_side, InternalBIOSize(), &socket_side_,
+                            InternalBIOSize());
   SecureSocketUtils::CheckStatusSSL(status, "TlsException", "BIO_new_bio_pair",
                                     ssl_);
 
@@ -515,6 +586,7 @@ void SSLFilter::Connect(const char* hostname,
       certificate_mode |= SSL_VERIFY_FAIL_IF_NO_PEER_CERT;
     }
     SSL_set_verify(ssl_, certificate_mode, NULL);
+    SSLSessionCache::ConfigureServerConnection(ssl_, context, certificate_mode);
   } else {
     SSLCertContext::SetAlpnProtocolList(protocols_handle, ssl_, NULL, false);
     status = SSL_set_tlsext_host_name(ssl_, hostname);
@@ -622,6 +694,9 @@ int SSLFilter::Handshake(Dart_Port reply_port) {
         printf("\n");
       }
     }
+    if (is_server_) {
+      SSLSessionCache::RecordHandshake(ssl_);
+    }
     ThrowIfError(Dart_InvokeClosure(
         Dart_HandleFromPersistent(handshake_complete_), 0, NULL));
     in_handshake_ = false;
@@ -715,17 +790,23 @@ int SSLFilter::ProcessReadPlaintextBuffer(int start, int end) {
     Syslog::Print("Entering ProcessReadPlaintextBuffer with %d bytes\n",
                   length);
   }
-  if (length > 0) {
-    bytes_processed = SSL_read(
-        ssl_, reinterpret_cast<char*>((buffers_[kReadPlaintext] + start)),
-        length);
-    if (bytes_processed < 0) {
-      int error = SSL_get_error(ssl_, bytes_processed);
-      if (SSL_LOG_DATA) {
-        Syslog::Print("SSL_read returned error %d\n", error);
+  // SSL_read returns at most one record, so keep reading until the buffer is
+  // full or no complete record is left.
+  while (bytes_processed < length) {
+    int bytes = SSL_read(ssl_,
+                         reinterpret_cast<char*>(buffers_[kReadPlaintext] +
+                                                 start + bytes_processed),
+                         length - bytes_processed);
+    if (bytes <= 0) {
+      if (bytes < 0) {
+        int error = SSL_get_error(ssl_, bytes);
+        if (SSL_LOG_DATA) {
+          Syslog::Print("SSL_read returned error %d\n", error);
+        }
       }
-      bytes_processed = 0;
+      break;
     }
+    bytes_processed += bytes;
   }
   if (SSL_LOG_DATA) {
     Syslog::Print("Leaving ProcessReadPlaintextBuffer read %d bytes\n",
@@ -53,7 +53,6 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
     kFirstEncrypted = kReadEncrypted
   };
 
-  static const intptr_t kApproximateSize;
   static const int kSSLFilterNativeFieldIndex = 0;
 
   SSLFilter()
@@ -70,6 +69,7 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   ~SSLFilter();
 
   char* hostname() const { return hostname_; }
+  SSL* ssl() const { return ssl_; }
   bool is_server() const { return is_server_; }
   bool is_client() const { return !is_server_; }
 
@@ -100,6 +100,10 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   bool ProcessAllBuffers(int starts[kNumBuffers],
                          int ends[kNumBuffers],
                          bool in_handshake);
+  bool ProcessAllBuffersOnce(int starts[kNumBuffers],
+                             int ends[kNumBuffers],
+                             bool in_handshake,
+                             bool* progress);
   Dart_Handle PeerCertificate();
   static void InitializeLibrary();
   Dart_Handle callback_error;
@@ -120,8 +124,19 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
     return trust_evaluate_reply_port_;
   }
 
+  // Whether the buffers of new filters hold whole TLS records, so that
+  // several records can be passed per filter request. This makes bulk
+  // transfers faster but triples the memory used by each connection.
+  static bool large_buffers() { return large_buffers_; }
+  static void set_large_buffers(bool large_buffers) {
+    large_buffers_ = large_buffers;
+  }
+  static intptr_t ApproximateSize();
+
  private:
-  static const intptr_t kInternalBIOSize;
+  static intptr_t InternalBIOSize();
+
+  static bool large_buffers_;
   static bool library_initialized_;
   static Mutex* mutex_;  // To protect library initialization.
 
@@ -9,6 +9,8 @@
 #include <openssl/bio.h>
 #include <openssl/err.h>
 #include <openssl/pkcs12.h>
+#include <openssl/rand.h>
+#include <openssl/sha.h>
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 
@@ -613,6 +615,286 @@ int SSLCertContext::UseCertificateChainBytes(Dart_Handle cert_chain_bytes,
   return UseChainBytes(context(), &bio, password);
 }
 
+Mutex* SSLSessionCache::mutex_ = nullptr;
+SimpleHashMap* SSLSessionCache::sessions_ = nullptr;
+SSLSessionCache::CachedSession* SSLSessionCache::oldest_ = nullptr;
+SSLSessionCache::CachedSession* SSLSessionCache::newest_ = nullptr;
+intptr_t SSLSessionCache::max_sessions_ = SSLSessionCache::kDefaultMaxSessions;
+int64_t SSLSessionCache::timeout_seconds_ = 0;
+bool SSLSessionCache::tickets_ = true;
+bool SSLSessionCache::has_ticket_key_ = false;
+SSLSessionCache::TicketKey SSLSessionCache::current_ticket_key_;
+SSLSessionCache::TicketKey SSLSessionCache::previous_ticket_key_;
+RelaxedAtomic<intptr_t> SSLSessionCache::hits_ = {0};
+RelaxedAtomic<intptr_t> SSLSessionCache::misses_ = {0};
+
+void SSLSessionCache::Init() {
+  ASSERT(mutex_ == nullptr);
+  mutex_ = new Mutex();
+  sessions_ = new SimpleHashMap(&SameSessionId, 64);
+}
+
+void SSLSessionCache::Cleanup() {
+  ASSERT(mutex_ != nullptr);
+  while (oldest_ != nullptr) {
+    RemoveLocked(oldest_);
+  }
+  delete sessions_;
+  sessions_ = nullptr;
+  delete mutex_;
+  mutex_ = nullptr;
+}
+
+bool SSLSessionCache::SameSessionId(void* key1, void* key2) {
+  CachedSession* cached1 = reinterpret_cast<CachedSession*>(key1);
+  CachedSession* cached2 = reinterpret_cast<CachedSession*>(key2);
+  return (cached1->id_length == cached2->id_length) &&
+         (memcmp(cached1->id, cached2->id, cached1->id_length) == 0);
+}
+
+uint32_t SSLSessionCache::SessionIdHash(const CachedSession* cached) {
+  // Session ids are random, so any of their bytes make a good hash.
+  uint32_t hash = 0;
+  for (unsigned i = 0; i < cached->id_length; i++) {
+    hash = (hash << 5) - hash + cached->id[i];
+  }
+  return hash;
+}
+
+SSLSessionCache::CachedSession* SSLSessionCache::LookupLocked(
+    const uint8_t* id,
+    unsigned id_length) {
+  if (id_length > SSL_MAX_SSL_SESSION_ID_LENGTH) {
+    return nullptr;
+  }
+  CachedSession key;
+  memmove(key.id, id, id_length);
+  key.id_length = id_length;
+  SimpleHashMap::Entry* entry =
+      sessions_->Lookup(&key, SessionIdHash(&key), false);
+  return entry == nullptr ? nullptr
+                          : reinterpret_cast<CachedSession*>(entry->value);
+}
+
+void SSLSessionCache::RemoveLocked(CachedSession* cached) {
+  if (cached->older != nullptr) {
+    cached->older->newer = cached->newer;
+  } else {
+    oldest_ = cached->newer;
+  }
+  if (cached->newer != nullptr) {
+    cached->newer->older = cached->older;
+  } else {
+    newest_ = cached->older;
+  }
+  sessions_->Remove(cached, SessionIdHash(cached));
+  SSL_SESSION_free(cached->session);
+  delete cached;
+}
+
+void SSLSessionCache::Configure(intptr_t max_sessions,
+                                int64_t timeout_seconds,
+                                bool tickets) {
+  MutexLocker locker(mutex_);
+  max_sessions_ = max_sessions;
+  timeout_seconds_ = timeout_seconds;
+  tickets_ = tickets;
+  while (sessions_->size() > max_sessions_) {
+    RemoveLocked(oldest_);
+  }
+}
+
+void SSLSessionCache::SetTicketKeyLocked(const uint8_t* key) {
+  if (has_ticket_key_) {
+    previous_ticket_key_ = current_ticket_key_;
+  }
+  if (key != NULL) {
+    memmove(&current_ticket_key_, key, sizeof(current_ticket_key_));
+  } else {
+    RAND_bytes(reinterpret_cast<uint8_t*>(&current_ticket_key_),
+               sizeof(current_ticket_key_));
+  }
+  if (!has_ticket_key_) {
+    // Nothing was encrypted with the previous key, so make it unusable.
+    previous_ticket_key_ = current_ticket_key_;
+    has_ticket_key_ = true;
+  }
+}
+
+void SSLSessionCache::RotateTicketKey(const uint8_t* key) {
+  COMPILE_ASSERT(sizeof(TicketKey) == kTicketKeyLength);
+  MutexLocker locker(mutex_);
+  SetTicketKeyLocked(key);
+}
+
+intptr_t SSLSessionCache::size() {
+  MutexLocker locker(mutex_);
+  return sessions_->size();
+}
+
+void SSLSessionCache::RegisterCallbacks(SSL_CTX* context) {
+  SSL_CTX_set_session_cache_mode(
+      context, SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+  SSL_CTX_sess_set_new_cb(context, NewSessionCallback);
+  SSL_CTX_sess_set_get_cb(context, GetSessionCallback);
+  SSL_CTX_sess_set_remove_cb(context, RemoveSessionCallback);
+  SSL_CTX_set_tlsext_ticket_key_cb(context, TicketKeyCallback);
+}
+
+void SSLSessionCache::ConfigureServerConnection(SSL* ssl,
+                                                const SSLCertContext* context,
+                                                int verify_mode) {
+  uint8_t digest[EVP_MAX_MD_SIZE];
+  unsigned digest_length = 0;
+  X509* certificate = SSL_get_certificate(ssl);
+  if ((certificate == NULL) ||
+      (X509_digest(certificate, EVP_sha256(), digest, &digest_length) != 1)) {
+    return;
+  }
+  SHA256_CTX sha256;
+  SHA256_Init(&sha256);
+  SHA256_Update(&sha256, digest, digest_length);
+  SHA256_Update(&sha256, &verify_mode, sizeof(verify_mode));
+  if (verify_mode != SSL_VERIFY_NONE) {
+    // The trusted client certificates are part of the context.
+    SHA256_Update(&sha256, context->id(), SSLCertContext::kIdLength);
+  }
+  uint8_t session_id_context[SHA256_DIGEST_LENGTH];
+  SHA256_Final(session_id_context, &sha256);
+  COMPILE_ASSERT(SHA256_DIGEST_LENGTH <= SSL_MAX_SID_CTX_LENGTH);
+  SSL_set_session_id_context(ssl, session_id_context,
+                             sizeof(session_id_context));
+  bool tickets;
+  {
+    MutexLocker locker(mutex_);
+    tickets = tickets_;
+  }
+  if (!tickets) {
+    SSL_set_options(ssl, SSL_OP_NO_TICKET);
+  }
+}
+
+void SSLSessionCache::RecordHandshake(SSL* ssl) {
+  if (SSL_session_reused(ssl)) {
+    hits_.fetch_add(1);
+  } else {
+    misses_.fetch_add(1);
+  }
+}
+
+int SSLSessionCache::NewSessionCallback(SSL* ssl, SSL_SESSION* session) {
+  unsigned id_length;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_length);
+  if ((id_length == 0) || (id_length > SSL_MAX_SSL_SESSION_ID_LENGTH)) {
+    return 0;
+  }
+  MutexLocker locker(mutex_);
+  if (max_sessions_ == 0) {
+    return 0;
+  }
+  if (timeout_seconds_ > 0) {
+    SSL_SESSION_set_timeout(session, timeout_seconds_);
+  }
+  CachedSession* cached = LookupLocked(id, id_length);
+  if (cached != nullptr) {
+    RemoveLocked(cached);
+  }
+  while (sessions_->size() >= max_sessions_) {
+    RemoveLocked(oldest_);
+  }
+  cached = new CachedSession();
+  memmove(cached->id, id, id_length);
+  cached->id_length = id_length;
+  cached->session = session;
+  cached->older = newest_;
+  cached->newer = nullptr;
+  if (newest_ != nullptr) {
+    newest_->newer = cached;
+  } else {
+    oldest_ = cached;
+  }
+  newest_ = cached;
+  SimpleHashMap::Entry* entry =
+      sessions_->Lookup(cached, SessionIdHash(cached), true);
+  entry->value = cached;
+  // The cache takes over the reference to the session.
+  return 1;
+}
+
+SSL_SESSION* SSLSessionCache::GetSessionCallback(SSL* ssl,
+                                                 const uint8_t* id,
+                                                 int id_length,
+                                                 int* copy) {
+  *copy = 0;
+  MutexLocker locker(mutex_);
+  CachedSession* cached = LookupLocked(id, id_length);
+  if (cached == nullptr) {
+    return NULL;
+  }
+  // The caller takes over the new reference.
+  SSL_SESSION_up_ref(cached->session);
+  return cached->session;
+}
+
+void SSLSessionCache::RemoveSessionCallback(SSL_CTX* context,
+                                            SSL_SESSION* session) {
+  unsigned id_length;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_length);
+  MutexLocker locker(mutex_);
+  CachedSession* cached = LookupLocked(id, id_length);
+  if ((cached != nullptr) && (cached->session == session)) {
+    RemoveLocked(cached);
+  }
+}
+
+int SSLSessionCache::TicketKeyCallback(SSL* ssl,
+                                       uint8_t* key_name,
+                                       uint8_t* iv,
+                                       EVP_CIPHER_CTX* cipher_context,
+                                       HMAC_CTX* hmac_context,
+                                       int encrypt) {
+  TicketKey key;
+  // 1 means the ticket is accepted, 2 that it is accepted and renewed.
+  int result = 1;
+  {
+    MutexLocker locker(mutex_);
+    if (!has_ticket_key_) {
+      SetTicketKeyLocked(NULL);
+    }
+    if (encrypt) {
+      key = current_ticket_key_;
+    } else if (memcmp(key_name, current_ticket_key_.name,
+                      sizeof(key.name)) == 0) {
+      key = current_ticket_key_;
+    } else if (memcmp(key_name, previous_ticket_key_.name,
+                      sizeof(key.name)) == 0) {
+      key = previous_ticket_key_;
+      result = 2;
+    } else {
+      // Unknown key, fall back to a full handshake.
+      return 0;
+    }
+  }
+  if (encrypt) {
+    memmove(key_name, key.name, sizeof(key.name));
+    if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_128_cbc())) != 1) {
+      return -1;
+    }
+    if (EVP_EncryptInit_ex(cipher_context, EVP_aes_128_cbc(), NULL,
+                           key.aes_key, iv) != 1) {
+      return -1;
+    }
+  } else if (EVP_DecryptInit_ex(cipher_context, EVP_aes_128_cbc(), NULL,
+                                key.aes_key, iv) != 1) {
+    return -1;
+  }
+  if (HMAC_Init_ex(hmac_context, key.hmac_key, sizeof(key.hmac_key),
+                   EVP_sha256(), NULL) != 1) {
+    return -1;
+  }
+  return result;
+}
+
 static X509* GetX509Certificate(Dart_NativeArguments args) {
   X509* certificate = NULL;
   Dart_Handle dart_this = ThrowIfError(Dart_GetNativeArgument(args, 0));
@@ -804,6 +1086,7 @@ void FUNCTION_NAME(SecurityContext_Allocate)(Dart_NativeArguments args) {
   SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, SSLCertContext::CertificateCallback);
   SSL_CTX_set_min_proto_version(ctx, TLS1_VERSION);
   SSL_CTX_set_cipher_list(ctx, "HIGH:MEDIUM");
+  SSLSessionCache::RegisterCallbacks(ctx);
   SSLCertContext* context = new SSLCertContext(ctx);
   Dart_Handle err = SetSecurityContext(args, context);
   if (Dart_IsError(err)) {
@@ -860,6 +1143,40 @@ void FUNCTION_NAME(SecurityContext_TrustBuiltinRoots)(
   context->TrustBuiltinRoots();
 }
 
+void FUNCTION_NAME(SecurityContext_ConfigureServerSessionCache)(
+    Dart_NativeArguments args) {
+  int64_t max_sessions = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 0), 0, kIntptrMax);
+  int64_t timeout_seconds = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 1), 0, kMaxUint32);
+  bool tickets = DartUtils::GetNativeBooleanArgument(args, 2);
+  SSLSessionCache::Configure(max_sessions, timeout_seconds, tickets);
+}
+
+void FUNCTION_NAME(SecurityContext_RotateSessionTicketKey)(
+    Dart_NativeArguments args) {
+  Dart_Handle key_object = ThrowIfError(Dart_GetNativeArgument(args, 0));
+  if (Dart_IsNull(key_object)) {
+    SSLSessionCache::RotateTicketKey(NULL);
+    return;
+  }
+  uint8_t key[SSLSessionCache::kTicketKeyLength];
+  ThrowIfError(Dart_ListGetAsBytes(key_object, 0, key, sizeof(key)));
+  SSLSessionCache::RotateTicketKey(key);
+}
+
+void FUNCTION_NAME(SecurityContext_ServerSessionStatistics)(
+    Dart_NativeArguments args) {
+  Dart_Handle statistics = ThrowIfError(Dart_NewList(3));
+  ThrowIfError(Dart_ListSetAt(statistics, 0,
+                              Dart_NewInteger(SSLSessionCache::hits())));
+  ThrowIfError(Dart_ListSetAt(statistics, 1,
+                              Dart_NewInteger(SSLSessionCache::misses())));
+  ThrowIfError(Dart_ListSetAt(statistics, 2,
+                              Dart_NewInteger(SSLSessionCache::size())));
+  Dart_SetReturnValue(args, statistics);
+}
+
 void FUNCTION_NAME(X509_Der)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, X509Helper::GetDer(args));
 }
@@ -5,12 +5,17 @@
 #ifndef RUNTIME_BIN_SECURITY_CONTEXT_H_
 #define RUNTIME_BIN_SECURITY_CONTEXT_H_
 
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 
 #include "bin/lockers.h"
 #include "bin/reference_counting.h"
 #include "bin/socket.h"
+#include "platform/atomic.h"
+#include "platform/hashmap.h"
 
 namespace dart {
 namespace bin {
@@ -26,12 +31,15 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
   static const intptr_t kApproximateSize;
   static const int kSecurityContextNativeFieldIndex = 0;
   static const int kX509NativeFieldIndex = 0;
+  static const intptr_t kIdLength = 16;
 
   explicit SSLCertContext(SSL_CTX* context)
       : ReferenceCounted(),
         context_(context),
         alpn_protocol_string_(NULL),
-        trust_builtin_(false) {}
+        trust_builtin_(false) {
+    RAND_bytes(id_, sizeof(id_));
+  }
 
   ~SSLCertContext() {
     SSL_CTX_free(context_);
@@ -72,6 +80,10 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
 
   SSL_CTX* context() const { return context_; }
 
+  // A random identifier of this context. Unlike the address of the SSL_CTX,
+  // it is not reused by contexts created after this one is freed.
+  const uint8_t* id() const { return id_; }
+
   uint8_t* alpn_protocol_string() const { return alpn_protocol_string_; }
 
   void set_alpn_protocol_string(uint8_t* protocol_string) {
@@ -103,6 +115,7 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
 
   SSL_CTX* context_;
   uint8_t* alpn_protocol_string_;
+  uint8_t id_[kIdLength];
 
   bool trust_builtin_;
 
@@ -111,6 +124,89 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
   DISALLOW_COPY_AND_ASSIGN(SSLCertContext);
 };
 
+// A process wide cache of the TLS sessions of server connections, used in
+// place of the internal cache of each SSL_CTX so that sessions can be resumed
+// by any security context with the same certificate, in any isolate. Session
+// tickets are encrypted with process wide keys for the same reason.
+class SSLSessionCache : public AllStatic {
+ public:
+  static const intptr_t kDefaultMaxSessions = 20 * KB;
+  // A ticket key is a 16 byte key name, a 16 byte HMAC key and a 16 byte AES
+  // key.
+  static const intptr_t kTicketKeyLength = 48;
+
+  static void Init();
+  static void Cleanup();
+
+  static void Configure(intptr_t max_sessions,
+                        int64_t timeout_seconds,
+                        bool tickets);
+  // Makes [key] the key used to encrypt new session tickets. Tickets
+  // encrypted with the previous key are still accepted and renewed. If [key]
+  // is NULL a random key is used.
+  static void RotateTicketKey(const uint8_t* key);
+
+  static void RegisterCallbacks(SSL_CTX* context);
+  // Sessions are only resumed by server connections with the same
+  // certificate. If client certificates are verified, they are also only
+  // resumed by connections using the same [context].
+  static void ConfigureServerConnection(SSL* ssl,
+                                        const SSLCertContext* context,
+                                        int verify_mode);
+  static void RecordHandshake(SSL* ssl);
+
+  static intptr_t hits() { return hits_; }
+  static intptr_t misses() { return misses_; }
+  static intptr_t size();
+
+ private:
+  struct CachedSession {
+    uint8_t id[SSL_MAX_SSL_SESSION_ID_LENGTH];
+    unsigned id_length;
+    SSL_SESSION* session;
+    CachedSession* older;
+    CachedSession* newer;
+  };
+  struct TicketKey {
+    uint8_t name[16];
+    uint8_t hmac_key[16];
+    uint8_t aes_key[16];
+  };
+
+  static int NewSessionCallback(SSL* ssl, SSL_SESSION* session);
+  static SSL_SESSION* GetSessionCallback(SSL* ssl,
+                                         const uint8_t* id,
+                                         int id_length,
+                                         int* copy);
+  static void RemoveSessionCallback(SSL_CTX* context, SSL_SESSION* session);
+  static int TicketKeyCallback(SSL* ssl,
+                               uint8_t* key_name,
+                               uint8_t* iv,
+                               EVP_CIPHER_CTX* cipher_context,
+                               HMAC_CTX* hmac_context,
+                               int encrypt);
+
+  static bool SameSessionId(void* key1, void* key2);
+  static uint32_t SessionIdHash(const CachedSession* cached);
+  static CachedSession* LookupLocked(const uint8_t* id, unsigned id_length);
+  static void RemoveLocked(CachedSession* cached);
+  static void SetTicketKeyLocked(const uint8_t* key);
+
+  static Mutex* mutex_;
+  static SimpleHashMap* sessions_;
+  // The cached sessions, from the least to the most recently added.
+  static CachedSession* oldest_;
+  static CachedSession* newest_;
+  static intptr_t max_sessions_;
+  static int64_t timeout_seconds_;
+  static bool tickets_;
+  static bool has_ticket_key_;
+  static TicketKey current_ticket_key_;
+  static TicketKey previous_ticket_key_;
+  static RelaxedAtomic<intptr_t> hits_;
+  static RelaxedAtomic<intptr_t> misses_;
+};
+
 class X509Helper : public AllStatic {
  public:
   static Dart_Handle GetDer(Dart_NativeArguments args);
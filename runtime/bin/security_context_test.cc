@@ -0,0 +1,248 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#if !defined(DART_IO_SECURE_SOCKET_DISABLED)
+
+#include <openssl/bio.h>
+#include <openssl/ec_key.h>
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include "bin/security_context.h"
+#include "platform/assert.h"
+#include "platform/globals.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+namespace bin {
+
+static EVP_PKEY* NewKey() {
+  EC_KEY* ec_key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+  EXPECT(ec_key != NULL);
+  EXPECT_EQ(1, EC_KEY_generate_key(ec_key));
+  EVP_PKEY* key = EVP_PKEY_new();
+  EXPECT_EQ(1, EVP_PKEY_assign_EC_KEY(key, ec_key));
+  return key;
+}
+
+static X509* NewSelfSignedCertificate(EVP_PKEY* key) {
+  X509* certificate = X509_new();
+  EXPECT_EQ(1, X509_set_version(certificate, 2));
+  EXPECT_EQ(1, ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1));
+  X509_gmtime_adj(X509_get_notBefore(certificate), 0);
+  X509_gmtime_adj(X509_get_notAfter(certificate), 60 * 60);
+  X509_NAME* name = X509_get_subject_name(certificate);
+  EXPECT_EQ(1, X509_NAME_add_entry_by_txt(
+                   name, "CN", MBSTRING_ASC,
+                   reinterpret_cast<const uint8_t*>("localhost"), -1, -1, 0));
+  EXPECT_EQ(1, X509_set_issuer_name(certificate, name));
+  EXPECT_EQ(1, X509_set_pubkey(certificate, key));
+  EXPECT(X509_sign(certificate, key, EVP_sha256()) > 0);
+  return certificate;
+}
+
+// Creates a server context which uses the process wide session cache, as
+// SecurityContext_Allocate does.
+static SSLCertContext* NewServerContext(EVP_PKEY* key, X509* certificate) {
+  SSL_CTX* ctx = SSL_CTX_new(TLS_method());
+  SSLSessionCache::RegisterCallbacks(ctx);
+  EXPECT_EQ(1, SSL_CTX_use_certificate(ctx, certificate));
+  EXPECT_EQ(1, SSL_CTX_use_PrivateKey(ctx, key));
+  return new SSLCertContext(ctx);
+}
+
+static SSL_CTX* NewClientContext() {
+  SSL_CTX* ctx = SSL_CTX_new(TLS_method());
+  SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, NULL);
+  // In TLS 1.2 renewed tickets and stateful resumption are observable.
+  SSL_CTX_set_max_proto_version(ctx, TLS1_2_VERSION);
+  return ctx;
+}
+
+static bool HandshakeStep(SSL* ssl, bool* done) {
+  if (*done) {
+    return true;
+  }
+  const int result = SSL_do_handshake(ssl);
+  if (result == 1) {
+    *done = true;
+    return true;
+  }
+  return SSL_get_error(ssl, result) == SSL_ERROR_WANT_READ;
+}
+
+// Connects a new client to a new server connection using [server_context],
+// offering [session] if it is not NULL. Returns the session of the client
+// afterwards, and sets [reused] to whether the server resumed a session.
+static SSL_SESSION* Connect(SSL_CTX* client_context,
+                            SSLCertContext* server_context,
+                            int verify_mode,
+                            SSL_SESSION* session,
+                            bool* reused) {
+  SSL* client = SSL_new(client_context);
+  SSL* server = SSL_new(server_context->context());
+  BIO* client_bio;
+  BIO* server_bio;
+  EXPECT_EQ(1, BIO_new_bio_pair(&client_bio, 0, &server_bio, 0));
+  SSL_set_bio(client, client_bio, client_bio);
+  SSL_set_bio(server, server_bio, server_bio);
+  SSL_set_connect_state(client);
+  SSL_set_accept_state(server);
+  if (session != NULL) {
+    EXPECT_EQ(1, SSL_set_session(client, session));
+  }
+  SSL_set_verify(server, verify_mode, NULL);
+  SSLSessionCache::ConfigureServerConnection(server, server_context,
+                                             verify_mode);
+
+  bool client_done = false;
+  bool server_done = false;
+  for (intptr_t i = 0; (i < 100) && !(client_done && server_done); i++) {
+    EXPECT(HandshakeStep(client, &client_done));
+    EXPECT(HandshakeStep(server, &server_done));
+  }
+  EXPECT(client_done && server_done);
+  SSLSessionCache::RecordHandshake(server);
+  *reused = SSL_session_reused(server) != 0;
+  EXPECT_EQ(*reused, SSL_session_reused(client) != 0);
+
+  SSL_SESSION* result = SSL_get1_session(client);
+  SSL_free(client);
+  SSL_free(server);
+  return result;
+}
+
+// Whether the ticket of [session] was encrypted with the key named [name].
+static bool HasTicketFromKey(SSL_SESSION* session, uint8_t name) {
+  const uint8_t* ticket;
+  size_t ticket_length;
+  SSL_SESSION_get0_ticket(session, &ticket, &ticket_length);
+  return (ticket_length > 16) && (ticket[0] == name) && (ticket[15] == name);
+}
+
+static void SetTicketKey(uint8_t name) {
+  uint8_t key[SSLSessionCache::kTicketKeyLength];
+  memset(key, name, sizeof(key));
+  SSLSessionCache::RotateTicketKey(key);
+}
+
+VM_UNIT_TEST_CASE(SSLSessionCache_ResumeCachedSession) {
+  SSLSessionCache::Init();
+  SSLSessionCache::Configure(16, 0, /*tickets=*/false);
+  EVP_PKEY* key = NewKey();
+  X509* certificate = NewSelfSignedCertificate(key);
+  SSLCertContext* server_context = NewServerContext(key, certificate);
+  SSL_CTX* client_context = NewClientContext();
+  const intptr_t hits = SSLSessionCache::hits();
+  const intptr_t misses = SSLSessionCache::misses();
+
+  bool reused;
+  SSL_SESSION* session =
+      Connect(client_context, server_context, SSL_VERIFY_NONE, NULL, &reused);
+  EXPECT(!reused);
+  EXPECT(!SSL_SESSION_has_ticket(session));
+  EXPECT_EQ(1, SSLSessionCache::size());
+
+  // Another context with the same certificate, as used by another isolate,
+  // resumes the session.
+  SSLCertContext* other_context = NewServerContext(key, certificate);
+  SSL_SESSION* resumed =
+      Connect(client_context, other_context, SSL_VERIFY_NONE, session, &reused);
+  EXPECT(reused);
+  EXPECT_EQ(hits + 1, SSLSessionCache::hits());
+  EXPECT_EQ(misses + 1, SSLSessionCache::misses());
+
+  SSL_SESSION_free(resumed);
+  SSL_SESSION_free(session);
+  SSL_CTX_free(client_context);
+  other_context->Release();
+  server_context->Release();
+  X509_free(certificate);
+  EVP_PKEY_free(key);
+  SSLSessionCache::Cleanup();
+}
+
+VM_UNIT_TEST_CASE(SSLSessionCache_ClientCertificatesNeedSameContext) {
+  SSLSessionCache::Init();
+  SSLSessionCache::Configure(16, 0, /*tickets=*/false);
+  EVP_PKEY* key = NewKey();
+  X509* certificate = NewSelfSignedCertificate(key);
+  SSLCertContext* server_context = NewServerContext(key, certificate);
+  SSLCertContext* other_context = NewServerContext(key, certificate);
+  SSL_CTX* client_context = NewClientContext();
+
+  bool reused;
+  SSL_SESSION* session =
+      Connect(client_context, server_context, SSL_VERIFY_PEER, NULL, &reused);
+  EXPECT(!reused);
+  // Another context may trust other client certificates.
+  SSL_SESSION* other =
+      Connect(client_context, other_context, SSL_VERIFY_PEER, session, &reused);
+  EXPECT(!reused);
+  SSL_SESSION* resumed =
+      Connect(client_context, server_context, SSL_VERIFY_PEER, session, &reused);
+  EXPECT(reused);
+
+  SSL_SESSION_free(resumed);
+  SSL_SESSION_free(other);
+  SSL_SESSION_free(session);
+  SSL_CTX_free(client_context);
+  other_context->Release();
+  server_context->Release();
+  X509_free(certificate);
+  EVP_PKEY_free(key);
+  SSLSessionCache::Cleanup();
+}
+
+VM_UNIT_TEST_CASE(SSLSessionCache_RotateTicketKey) {
+  SSLSessionCache::Init();
+  SSLSessionCache::Configure(16, 0, /*tickets=*/true);
+  EVP_PKEY* key = NewKey();
+  X509* certificate = NewSelfSignedCertificate(key);
+  SSLCertContext* server_context = NewServerContext(key, certificate);
+  SSL_CTX* client_context = NewClientContext();
+
+  SetTicketKey('A');
+  bool reused;
+  SSL_SESSION* session_a =
+      Connect(client_context, server_context, SSL_VERIFY_NONE, NULL, &reused);
+  EXPECT(!reused);
+  EXPECT(HasTicketFromKey(session_a, 'A'));
+
+  // A ticket from the previous key is accepted and renewed.
+  SetTicketKey('B');
+  SSL_SESSION* session_b = Connect(client_context, server_context,
+                                   SSL_VERIFY_NONE, session_a, &reused);
+  EXPECT(reused);
+  EXPECT(HasTicketFromKey(session_b, 'B'));
+
+  // A ticket from the current key is accepted as it is.
+  SSL_SESSION* session_b2 = Connect(client_context, server_context,
+                                    SSL_VERIFY_NONE, session_b, &reused);
+  EXPECT(reused);
+  EXPECT(HasTicketFromKey(session_b2, 'B'));
+
+  // A ticket from a key which is no longer known is rejected.
+  SetTicketKey('C');
+  SSL_SESSION* session_c = Connect(client_context, server_context,
+                                   SSL_VERIFY_NONE, session_a, &reused);
+  EXPECT(!reused);
+  EXPECT(HasTicketFromKey(session_c, 'C'));
+
+  SSL_SESSION_free(session_c);
+  SSL_SESSION_free(session_b2);
+  SSL_SESSION_free(session_b);
+  SSL_SESSION_free(session_a);
+  SSL_CTX_free(client_context);
+  server_context->Release();
+  X509_free(certificate);
+  EVP_PKEY_free(key);
+  SSLSessionCache::Cleanup();
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // !defined(DART_IO_SECURE_SOCKET_DISABLED)
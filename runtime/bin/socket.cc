@@ -28,6 +28,7 @@ ListeningSocketRegistry* globalTcpListeningSocketRegistry = nullptr;
 
 bool Socket::short_socket_read_ = false;
 bool Socket::short_socket_write_ = false;
+bool Socket::listen_reuse_port_ = false;
 
 void ListeningSocketRegistry::Initialize() {
   ASSERT(globalTcpListeningSocketRegistry == nullptr);
@@ -97,6 +98,12 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
                                                       bool shared) {
   MutexLocker ml(&mutex_);
 
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+  const bool reuse_port = shared && Socket::listen_reuse_port();
+#else
+  const bool reuse_port = false;
+#endif
+
   OSSocket* first_os_socket = nullptr;
   intptr_t port = SocketAddress::GetAddrPort(addr);
   if (port > 0) {
@@ -126,24 +133,33 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
           return DartUtils::NewDartOSError(&os_error);
         }
 
-        // This socket creation is the exact same as the one which originally
-        // created the socket. Feed same fd and store it into native field
-        // of dart socket_object. Sockets here will share same fd but contain a
-        // different port() through EventHandler_SendData.
-        Socket* socketfd = new Socket(os_socket->fd);
-        os_socket->ref_count++;
-        // We set as a side-effect the file descriptor on the dart
-        // socket_object.
-        Socket::ReuseSocketIdNativeField(socket_object, socketfd,
-                                         Socket::kFinalizerListening);
-        InsertByFd(socketfd, os_socket);
-        return Dart_True();
+        if (!os_socket_same_addr->reuse_port) {
+          // This socket creation is the exact same as the one which
+          // originally created the socket. Feed same fd and store it into
+          // native field of dart socket_object. Sockets here will share same
+          // fd but contain a different port() through EventHandler_SendData.
+          Socket* socketfd = new Socket(os_socket->fd);
+          os_socket->ref_count++;
+          // We set as a side-effect the file descriptor on the dart
+          // socket_object.
+          Socket::ReuseSocketIdNativeField(socket_object, socketfd,
+                                           Socket::kFinalizerListening);
+          InsertByFd(socketfd, os_socket);
+          return Dart_True();
+        }
+        // The existing socket was bound with SO_REUSEPORT. Bind another one
+        // to the same (address, port) below, so that the kernel balances
+        // incoming connections between the listening isolates instead of
+        // delivering them all through a single fd.
+        ASSERT(reuse_port);
       }
     }
   }
 
-  // There is no socket listening on that (address, port), so we create new one.
-  intptr_t fd = ServerSocket::CreateBindListen(addr, backlog, v6_only);
+  // There is no socket listening on that (address, port) we can share, so we
+  // create new one.
+  intptr_t fd =
+      ServerSocket::CreateBindListen(addr, backlog, v6_only, reuse_port);
   if (fd == -5) {
     OSError os_error(-1, "Invalid host", OSError::kUnknown);
     return DartUtils::NewDartOSError(&os_error);
@@ -178,8 +194,8 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
   }
 
   Socket* socketfd = new Socket(fd);
-  OSSocket* os_socket =
-      new OSSocket(addr, allocated_port, v6_only, shared, socketfd, nullptr);
+  OSSocket* os_socket = new OSSocket(addr, allocated_port, v6_only, shared,
+                                     socketfd, nullptr, reuse_port);
   os_socket->ref_count = 1;
   os_socket->next = first_os_socket;
 
@@ -525,38 +541,33 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
     if (Socket::short_socket_read()) {
       length = (length + 1) / 2;
     }
-    uint8_t* buffer = nullptr;
-    Dart_Handle result = IOBuffer::Allocate(length, &buffer);
-    if (Dart_IsNull(result)) {
+    uint8_t* buffer = IOBuffer::Allocate(length);
+    if (buffer == nullptr) {
       Dart_ThrowException(DartUtils::NewDartOSError());
     }
-    if (Dart_IsError(result)) {
-      Dart_PropagateError(result);
-    }
-    ASSERT(buffer != nullptr);
     intptr_t bytes_read =
         SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
-    if (bytes_read == length) {
-      Dart_SetReturnValue(args, result);
-    } else if (bytes_read > 0) {
-      uint8_t* new_buffer = nullptr;
-      Dart_Handle new_result = IOBuffer::Allocate(bytes_read, &new_buffer);
-      if (Dart_IsNull(new_result)) {
-        Dart_ThrowException(DartUtils::NewDartOSError());
-      }
-      if (Dart_IsError(new_result)) {
-        Dart_PropagateError(new_result);
+    if (bytes_read > 0) {
+      if (bytes_read < length) {
+        // Shrink the storage in place rather than copying into a new buffer.
+        uint8_t* new_buffer = IOBuffer::Reallocate(buffer, bytes_read);
+        if (new_buffer != nullptr) {
+          buffer = new_buffer;
+        }
       }
-      ASSERT(new_buffer != nullptr);
-      memmove(new_buffer, buffer, bytes_read);
-      Dart_SetReturnValue(args, new_result);
+      Dart_SetReturnValue(args, IOBuffer::Wrap(buffer, bytes_read));
     } else if (bytes_read == 0) {
       // On MacOS when reading from a tty Ctrl-D will result in reading one
       // less byte then reported as available.
+      IOBuffer::Free(buffer);
       Dart_SetReturnValue(args, Dart_Null());
     } else {
       ASSERT(bytes_read == -1);
-      Dart_ThrowException(DartUtils::NewDartOSError());
+      // Extract OSError before we free the buffer, as it may override the
+      // error.
+      OSError os_error;
+      IOBuffer::Free(buffer);
+      Dart_ThrowException(DartUtils::NewDartOSError(&os_error));
     }
   } else {
     OSError os_error(-1, "Invalid argument", OSError::kUnknown);
@@ -564,38 +575,57 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
   }
 }
 
-void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
-  // TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
-  // handle 64k datagrams.
-  const int kReceiveBufferLen = 65536;
+void FUNCTION_NAME(Socket_ReadInto)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
-
-  // Ensure that a receive buffer for the UDP socket exists.
-  ASSERT(socket != nullptr);
-  uint8_t* recv_buffer = socket->udp_receive_buffer();
-  if (recv_buffer == nullptr) {
-    recv_buffer = reinterpret_cast<uint8_t*>(malloc(kReceiveBufferLen));
-    socket->set_udp_receive_buffer(recv_buffer);
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  // Offset and length are checked in Dart code to be within the bounds of
+  // the buffer.
+  intptr_t offset = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 2));
+  intptr_t length = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 3));
+  if (Socket::short_socket_read()) {
+    length = (length + 1) / 2;
   }
-
-  // Read data into the buffer.
-  RawAddr addr;
-  const intptr_t bytes_read = SocketBase::RecvFrom(
-      socket->fd(), recv_buffer, kReceiveBufferLen, &addr, SocketBase::kAsync);
-  if (bytes_read == 0) {
-    Dart_SetReturnValue(args, Dart_Null());
-    return;
+  Dart_TypedData_Type type;
+  uint8_t* buffer = nullptr;
+  intptr_t len;
+  Dart_Handle result = Dart_TypedDataAcquireData(
+      buffer_obj, &type, reinterpret_cast<void**>(&buffer), &len);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
   }
-  if (bytes_read < 0) {
-    ASSERT(bytes_read == -1);
-    Dart_ThrowException(DartUtils::NewDartOSError());
+  ASSERT(type == Dart_TypedData_kUint8);
+  ASSERT((offset + length) <= len);
+  intptr_t bytes_read = SocketBase::Read(socket->fd(), buffer + offset,
+                                         length, SocketBase::kAsync);
+  if (bytes_read >= 0) {
+    Dart_TypedDataReleaseData(buffer_obj);
+    Dart_SetIntegerReturnValue(args, bytes_read);
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    Dart_Handle error;
+    {
+      OSError os_error;
+      Dart_TypedDataReleaseData(buffer_obj);
+      error = DartUtils::NewDartOSError(&os_error);
+    }
+    Dart_ThrowException(error);
   }
+}
+
+// TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
+// handle 64k datagrams.
+static const intptr_t kDatagramReceiveBufferLen = 65536;
 
+// Creates a Datagram object with a copy of the [length] bytes at [buffer]
+// received from [addr].
+static Dart_Handle NewDatagram(const uint8_t* buffer,
+                               intptr_t length,
+                               RawAddr addr) {
   // Datagram data read. Copy into buffer of the exact size,
-  ASSERT(bytes_read >= 0);
+  ASSERT(length >= 0);
   uint8_t* data_buffer = nullptr;
-  Dart_Handle data = IOBuffer::Allocate(bytes_read, &data_buffer);
+  Dart_Handle data = IOBuffer::Allocate(length, &data_buffer);
   if (Dart_IsNull(data)) {
     Dart_ThrowException(DartUtils::NewDartOSError());
   }
@@ -603,7 +633,7 @@ void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
     Dart_PropagateError(data);
   }
   ASSERT(data_buffer != nullptr);
-  memmove(data_buffer, recv_buffer, bytes_read);
+  memmove(data_buffer, buffer, length);
 
   // Memory Sanitizer complains addr not being initialized, which is done
   // through RecvFrom().
@@ -647,9 +677,83 @@ void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
   if (Dart_IsError(io_lib)) {
     Dart_PropagateError(io_lib);
   }
-  Dart_Handle result = Dart_Invoke(
-      io_lib, DartUtils::NewString("_makeDatagram"), kNumArgs, dart_args);
-  Dart_SetReturnValue(args, result);
+  return Dart_Invoke(io_lib, DartUtils::NewString("_makeDatagram"), kNumArgs,
+                     dart_args);
+}
+
+void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+
+  // Ensure that a receive buffer for the UDP socket exists.
+  ASSERT(socket != nullptr);
+  uint8_t* recv_buffer = socket->udp_receive_buffer();
+  if (recv_buffer == nullptr) {
+    recv_buffer = reinterpret_cast<uint8_t*>(malloc(kDatagramReceiveBufferLen));
+    socket->set_udp_receive_buffer(recv_buffer);
+  }
+
+  // Read data into the buffer.
+  RawAddr addr;
+  const intptr_t bytes_read =
+      SocketBase::RecvFrom(socket->fd(), recv_buffer, kDatagramReceiveBufferLen,
+                           &addr, SocketBase::kAsync);
+  if (bytes_read == 0) {
+    Dart_SetReturnValue(args, Dart_Null());
+    return;
+  }
+  if (bytes_read < 0) {
+    ASSERT(bytes_read == -1);
+    Dart_ThrowException(DartUtils::NewDartOSError());
+  }
+  Dart_SetReturnValue(args, NewDatagram(recv_buffer, bytes_read, addr));
+}
+
+void FUNCTION_NAME(Socket_RecvFromBatch)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  int64_t max_count = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 1), 1, SocketBase::kMaxDatagramBatch);
+
+  // Ensure that a batch receive buffer for the UDP socket exists.
+  ASSERT(socket != nullptr);
+  uint8_t* recv_buffer = socket->udp_batch_receive_buffer();
+  if (recv_buffer == nullptr) {
+    recv_buffer = reinterpret_cast<uint8_t*>(
+        malloc(kDatagramReceiveBufferLen * SocketBase::kMaxDatagramBatch));
+    socket->set_udp_batch_receive_buffer(recv_buffer);
+  }
+
+  RawAddr addrs[SocketBase::kMaxDatagramBatch];
+  intptr_t lengths[SocketBase::kMaxDatagramBatch];
+  const intptr_t count = SocketBase::RecvFromBatch(
+      socket->fd(), recv_buffer, kDatagramReceiveBufferLen, max_count, lengths,
+      addrs, SocketBase::kAsync);
+  if (count == 0) {
+    Dart_SetReturnValue(args, Dart_Null());
+    return;
+  }
+  if (count < 0) {
+    ASSERT(count == -1);
+    Dart_ThrowException(DartUtils::NewDartOSError());
+  }
+  Dart_Handle datagrams = Dart_NewList(count);
+  if (Dart_IsError(datagrams)) {
+    Dart_PropagateError(datagrams);
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_Handle datagram =
+        NewDatagram(recv_buffer + i * kDatagramReceiveBufferLen, lengths[i],
+                    addrs[i]);
+    if (Dart_IsError(datagram)) {
+      Dart_PropagateError(datagram);
+    }
+    Dart_Handle result = Dart_ListSetAt(datagrams, i, datagram);
+    if (Dart_IsError(result)) {
+      Dart_PropagateError(result);
+    }
+  }
+  Dart_SetReturnValue(args, datagrams);
 }
 
 void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
@@ -699,6 +803,154 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
   }
 }
 
+// Releases the typed data acquired for the first [count] buffers of a
+// gathering write or a batch of datagrams. Buffers that occurred earlier in
+// the list share the data acquired for their first occurrence and are not
+// released again.
+static void ReleaseBuffers(const Dart_Handle* handles,
+                           const intptr_t* first_occurrence,
+                           intptr_t count) {
+  for (intptr_t i = 0; i < count; i++) {
+    if (first_occurrence[i] == i) {
+      Dart_TypedDataReleaseData(handles[i]);
+    }
+  }
+}
+
+void FUNCTION_NAME(Socket_WriteBuffers)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffers_obj = Dart_GetNativeArgument(args, 1);
+  ASSERT(Dart_IsList(buffers_obj));
+  intptr_t offset = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 2));
+  intptr_t count = 0;
+  Dart_Handle result = Dart_ListLength(buffers_obj, &count);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT((count > 0) && (count <= SocketBase::kMaxWriteBuffers));
+  bool short_write = false;
+  if (Socket::short_socket_write()) {
+    // Only write part of the first buffer, as Socket_WriteList does.
+    short_write = true;
+    count = 1;
+  }
+  // Look up all the buffers before acquiring any of them, as no other API
+  // calls are allowed while their data is acquired. The same typed data may
+  // be queued more than once but can only be acquired once, so later
+  // occurrences share the data of the first one.
+  Dart_Handle handles[SocketBase::kMaxWriteBuffers];
+  intptr_t first_occurrence[SocketBase::kMaxWriteBuffers];
+  for (intptr_t i = 0; i < count; i++) {
+    handles[i] = Dart_ListGetAt(buffers_obj, i);
+    if (Dart_IsError(handles[i])) {
+      Dart_PropagateError(handles[i]);
+    }
+    first_occurrence[i] = i;
+    for (intptr_t j = 0; j < i; j++) {
+      if (Dart_IdentityEquals(handles[i], handles[j])) {
+        first_occurrence[i] = j;
+        break;
+      }
+    }
+  }
+  const void* buffers[SocketBase::kMaxWriteBuffers];
+  intptr_t lengths[SocketBase::kMaxWriteBuffers];
+  for (intptr_t i = 0; i < count; i++) {
+    if (first_occurrence[i] != i) {
+      buffers[i] = buffers[first_occurrence[i]];
+      lengths[i] = lengths[first_occurrence[i]];
+      continue;
+    }
+    Dart_TypedData_Type type;
+    uint8_t* buffer = nullptr;
+    intptr_t len;
+    result = Dart_TypedDataAcquireData(
+        handles[i], &type, reinterpret_cast<void**>(&buffer), &len);
+    if (Dart_IsError(result)) {
+      ReleaseBuffers(handles, first_occurrence, i);
+      Dart_PropagateError(result);
+    }
+    buffers[i] = buffer;
+    lengths[i] = len;
+  }
+  ASSERT(offset <= lengths[0]);
+  buffers[0] = reinterpret_cast<const uint8_t*>(buffers[0]) + offset;
+  lengths[0] -= offset;
+  if (short_write) {
+    if (lengths[0] <= 1) {
+      short_write = false;
+    }
+    lengths[0] = (lengths[0] + 1) / 2;
+  }
+  intptr_t bytes_written = SocketBase::WriteV(socket->fd(), buffers, lengths,
+                                              count, SocketBase::kAsync);
+  if (bytes_written >= 0) {
+    ReleaseBuffers(handles, first_occurrence, count);
+    // A forced short write is indicated by a negative result, see
+    // Socket_WriteList.
+    Dart_SetIntegerReturnValue(args,
+                               short_write ? -bytes_written : bytes_written);
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    Dart_Handle error;
+    {
+      OSError os_error;
+      ReleaseBuffers(handles, first_occurrence, count);
+      error = DartUtils::NewDartOSError(&os_error);
+    }
+    Dart_ThrowException(error);
+  }
+}
+
+void FUNCTION_NAME(Socket_SendFile)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  intptr_t file_pointer =
+      DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 1));
+  int64_t offset = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 2), 0, kMaxInt64);
+  int64_t length = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 3), 0, kMaxInt64);
+  bool short_write = false;
+  if (Socket::short_socket_write()) {
+    if (length > 1) {
+      short_write = true;
+    }
+    length = (length + 1) / 2;
+  }
+  Dart_Handle result;
+  bool failed = false;
+  {
+    // The file was retained by _RandomAccessFile._pointer().
+    File* file = reinterpret_cast<File*>(file_pointer);
+    RefCntReleaseScope<File> rs(file);
+    int64_t bytes_sent = file->SendToSocket(socket->fd(), offset, length);
+    if (bytes_sent == File::kSendToSocketEndOfFile) {
+      // The file shrank since it was opened. Return null so the caller reads
+      // the rest of the stream instead, which ends where the file ends now.
+      result = Dart_Null();
+    } else if (bytes_sent >= 0) {
+      // A forced short write is indicated by a negative result, see
+      // Socket_WriteList.
+      result = Dart_NewInteger(short_write ? -bytes_sent : bytes_sent);
+    } else if ((errno == ENOSYS) || (errno == EINVAL)) {
+      // The platform or the file does not support sending directly to a
+      // socket. Return null so the caller falls back to reading the file.
+      result = Dart_Null();
+    } else {
+      // Extract OSError before we release the file, as it may override the
+      // error.
+      result = DartUtils::NewDartOSError();
+      failed = true;
+    }
+  }
+  if (failed) {
+    Dart_ThrowException(result);
+  }
+  Dart_SetReturnValue(args, result);
+}
+
 void FUNCTION_NAME(Socket_SendTo)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -739,6 +991,88 @@ void FUNCTION_NAME(Socket_SendTo)(Dart_NativeArguments args) {
   }
 }
 
+void FUNCTION_NAME(Socket_SendToBatch)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffers_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle addresses_obj = Dart_GetNativeArgument(args, 2);
+  Dart_Handle ports_obj = Dart_GetNativeArgument(args, 3);
+  ASSERT(Dart_IsList(buffers_obj));
+  ASSERT(Dart_IsList(addresses_obj));
+  ASSERT(Dart_IsList(ports_obj));
+  intptr_t count = 0;
+  Dart_Handle result = Dart_ListLength(buffers_obj, &count);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT((count > 0) && (count <= SocketBase::kMaxDatagramBatch));
+  // Look up all the buffers and addresses before acquiring any of the
+  // buffers, see Socket_WriteBuffers.
+  RawAddr addrs[SocketBase::kMaxDatagramBatch];
+  Dart_Handle handles[SocketBase::kMaxDatagramBatch];
+  intptr_t first_occurrence[SocketBase::kMaxDatagramBatch];
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_Handle address_obj = Dart_ListGetAt(addresses_obj, i);
+    if (Dart_IsError(address_obj)) {
+      Dart_PropagateError(address_obj);
+    }
+    ASSERT(Dart_IsList(address_obj));
+    SocketAddress::GetSockAddr(address_obj, &addrs[i]);
+    Dart_Handle port_obj = Dart_ListGetAt(ports_obj, i);
+    if (Dart_IsError(port_obj)) {
+      Dart_PropagateError(port_obj);
+    }
+    int64_t port = DartUtils::GetInt64ValueCheckRange(port_obj, 0, 65535);
+    SocketAddress::SetAddrPort(&addrs[i], port);
+    handles[i] = Dart_ListGetAt(buffers_obj, i);
+    if (Dart_IsError(handles[i])) {
+      Dart_PropagateError(handles[i]);
+    }
+    first_occurrence[i] = i;
+    for (intptr_t j = 0; j < i; j++) {
+      if (Dart_IdentityEquals(handles[i], handles[j])) {
+        first_occurrence[i] = j;
+        break;
+      }
+    }
+  }
+  const void* buffers[SocketBase::kMaxDatagramBatch];
+  intptr_t lengths[SocketBase::kMaxDatagramBatch];
+  for (intptr_t i = 0; i < count; i++) {
+    if (first_occurrence[i] != i) {
+      buffers[i] = buffers[first_occurrence[i]];
+      lengths[i] = lengths[first_occurrence[i]];
+      continue;
+    }
+    Dart_TypedData_Type type;
+    uint8_t* buffer = nullptr;
+    intptr_t len;
+    result = Dart_TypedDataAcquireData(
+        handles[i], &type, reinterpret_cast<void**>(&buffer), &len);
+    if (Dart_IsError(result)) {
+      ReleaseBuffers(handles, first_occurrence, i);
+      Dart_PropagateError(result);
+    }
+    buffers[i] = buffer;
+    lengths[i] = len;
+  }
+  intptr_t sent = SocketBase::SendToBatch(socket->fd(), buffers, lengths,
+                                          addrs, count, SocketBase::kAsync);
+  if (sent >= 0) {
+    ReleaseBuffers(handles, first_occurrence, count);
+    Dart_SetIntegerReturnValue(args, sent);
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    Dart_Handle error;
+    {
+      OSError os_error;
+      ReleaseBuffers(handles, first_occurrence, count);
+      error = DartUtils::NewDartOSError(&os_error);
+    }
+    Dart_ThrowException(error);
+  }
+}
+
 void FUNCTION_NAME(Socket_GetPort)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
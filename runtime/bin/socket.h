@@ -50,6 +50,9 @@ class Socket : public ReferenceCounted<Socket> {
   explicit Socket(intptr_t fd);
 
   intptr_t fd() const { return fd_; }
+  // The descriptor the socket was created with. Unlike fd(), it does not
+  // change when the socket is closed, so other threads can read it.
+  intptr_t initial_fd() const { return initial_fd_; }
 
   // Close fd and may need to decrement the count of handle by calling
   // release().
@@ -66,6 +69,15 @@ class Socket : public ReferenceCounted<Socket> {
   uint8_t* udp_receive_buffer() const { return udp_receive_buffer_; }
   void set_udp_receive_buffer(uint8_t* buffer) { udp_receive_buffer_ = buffer; }
 
+  // Buffer for receiving up to SocketBase::kMaxDatagramBatch datagrams at a
+  // time. It is only allocated once a batch is received.
+  uint8_t* udp_batch_receive_buffer() const {
+    return udp_batch_receive_buffer_;
+  }
+  void set_udp_batch_receive_buffer(uint8_t* buffer) {
+    udp_batch_receive_buffer_ = buffer;
+  }
+
   static bool Initialize();
 
   // Creates a socket which is bound and connected. The port to connect to is
@@ -107,6 +119,13 @@ class Socket : public ReferenceCounted<Socket> {
   static void set_short_socket_write(bool short_socket_write) {
     short_socket_write_ = short_socket_write;
   }
+  // Whether listening sockets bound with `shared: true` each get their own
+  // SO_REUSEPORT socket instead of sharing a single one. Only has an effect
+  // on Linux and Android.
+  static bool listen_reuse_port() { return listen_reuse_port_; }
+  static void set_listen_reuse_port(bool listen_reuse_port) {
+    listen_reuse_port_ = listen_reuse_port;
+  }
 
   static bool IsSignalSocketFlag(intptr_t flag) {
     return ((flag & (0x1 << kInternalSignalSocket)) != 0);
@@ -117,17 +136,22 @@ class Socket : public ReferenceCounted<Socket> {
     ASSERT(fd_ == kClosedFd);
     free(udp_receive_buffer_);
     udp_receive_buffer_ = NULL;
+    free(udp_batch_receive_buffer_);
+    udp_batch_receive_buffer_ = NULL;
   }
 
   static const int kClosedFd = -1;
 
   static bool short_socket_read_;
   static bool short_socket_write_;
+  static bool listen_reuse_port_;
 
   intptr_t fd_;
+  const intptr_t initial_fd_;
   Dart_Port isolate_port_;
   Dart_Port port_;
   uint8_t* udp_receive_buffer_;
+  uint8_t* udp_batch_receive_buffer_;
 
   friend class ReferenceCounted<Socket>;
   DISALLOW_COPY_AND_ASSIGN(Socket);
@@ -147,9 +171,14 @@ class ServerSocket {
   //
   //   -1: system error (errno set)
   //   -5: invalid bindAddress
+  //
+  // If [reuse_port] is true the socket is bound with SO_REUSEPORT, so that
+  // several sockets can listen on the same address and port. This is only
+  // supported on Linux and Android.
   static intptr_t CreateBindListen(const RawAddr& addr,
                                    intptr_t backlog,
-                                   bool v6_only = false);
+                                   bool v6_only = false,
+                                   bool reuse_port = false);
   static intptr_t CreateUnixDomainBindListen(const RawAddr& addr,
                                              intptr_t backlog);
 
@@ -217,6 +246,9 @@ class ListeningSocketRegistry {
     int port;
     bool v6_only;
     bool shared;
+    // Whether this socket was bound with SO_REUSEPORT. Such sockets are never
+    // shared between isolates; every bind gets its own socket instead.
+    bool reuse_port;
     int ref_count;
     intptr_t fd;
 
@@ -233,11 +265,13 @@ class ListeningSocketRegistry {
              bool v6_only,
              bool shared,
              Socket* socketfd,
-             Namespace* namespc)
+             Namespace* namespc,
+             bool reuse_port = false)
         : address(address),
           port(port),
           v6_only(v6_only),
           shared(shared),
+          reuse_port(reuse_port),
           ref_count(0),
           namespc(namespc),
           next(NULL) {
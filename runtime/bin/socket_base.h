@@ -161,6 +161,14 @@ class SocketBase : public AllStatic {
     kAsync,
   };
 
+  // Maximum number of buffers passed to a single WriteV call. This is well
+  // below IOV_MAX on all supported platforms.
+  static const intptr_t kMaxWriteBuffers = 64;
+
+  // Maximum number of datagrams passed to a single SendToBatch or
+  // RecvFromBatch call.
+  static const intptr_t kMaxDatagramBatch = 16;
+
   // TODO(dart:io): Convert these to instance methods where possible.
   static bool Initialize();
   static intptr_t Available(intptr_t fd);
@@ -172,6 +180,15 @@ class SocketBase : public AllStatic {
                         const void* buffer,
                         intptr_t num_bytes,
                         SocketOpKind sync);
+  // Write the [count] buffers to the socket in order, using a single
+  // gathering write where the platform supports it. At most kMaxWriteBuffers
+  // buffers are written. As with Write, the number of bytes written may be
+  // less than the total length of the buffers.
+  static intptr_t WriteV(intptr_t fd,
+                         const void* const* buffers,
+                         const intptr_t* lengths,
+                         intptr_t count,
+                         SocketOpKind sync);
   // Send data on a socket. The port to send to is specified in the port
   // component of the passed RawAddr structure. The RawAddr structure is only
   // used for datagram sockets.
@@ -185,6 +202,29 @@ class SocketBase : public AllStatic {
                            intptr_t num_bytes,
                            RawAddr* addr,
                            SocketOpKind sync);
+  // Send [count] datagrams, the i'th one holding the [lengths[i]] bytes at
+  // [buffers[i]] and going to [addrs[i]]. At most kMaxDatagramBatch
+  // datagrams are sent, using a single system call where the platform
+  // supports it. Returns the number of datagrams sent, which is 0 if the
+  // socket would block, or -1 if not even the first one could be sent.
+  static intptr_t SendToBatch(intptr_t fd,
+                              const void* const* buffers,
+                              const intptr_t* lengths,
+                              const RawAddr* addrs,
+                              intptr_t count,
+                              SocketOpKind sync);
+  // Receive up to [count] datagrams. The i'th one is stored at
+  // [buffer + i * buffer_len], and its length and sender are stored in
+  // [lengths[i]] and [addrs[i]]. At most kMaxDatagramBatch datagrams are
+  // received. Returns the number of datagrams received, which is 0 if none
+  // are available, or -1 on errors.
+  static intptr_t RecvFromBatch(intptr_t fd,
+                                uint8_t* buffer,
+                                intptr_t buffer_len,
+                                intptr_t count,
+                                intptr_t* lengths,
+                                RawAddr* addrs,
+                                SocketOpKind sync);
   static bool AvailableDatagram(intptr_t fd, void* buffer, intptr_t num_bytes);
   // Returns true if the given error-number is because the system was not able
   // to bind the socket to a specific IP.
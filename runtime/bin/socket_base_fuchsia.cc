@@ -124,6 +124,49 @@ intptr_t SocketBase::RecvFrom(intptr_t fd,
   return -1;
 }
 
+intptr_t SocketBase::SendToBatch(intptr_t fd,
+                                 const void* const* buffers,
+                                 const intptr_t* lengths,
+                                 const RawAddr* addrs,
+                                 intptr_t count,
+                                 SocketOpKind sync) {
+  ASSERT((count > 0) && (count <= kMaxDatagramBatch));
+  // Send the datagrams one at a time, stopping when the socket would block.
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t written_bytes = SendTo(fd, buffers[i], lengths[i], addrs[i], sync);
+    if (written_bytes < 0) {
+      return (i > 0) ? i : -1;
+    }
+    if ((written_bytes == 0) && (lengths[i] > 0)) {
+      return i;
+    }
+  }
+  return count;
+}
+
+intptr_t SocketBase::RecvFromBatch(intptr_t fd,
+                                   uint8_t* buffer,
+                                   intptr_t buffer_len,
+                                   intptr_t count,
+                                   intptr_t* lengths,
+                                   RawAddr* addrs,
+                                   SocketOpKind sync) {
+  ASSERT((count > 0) && (count <= kMaxDatagramBatch));
+  // Receive the datagrams one at a time, stopping when none are left.
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t read_bytes =
+        RecvFrom(fd, buffer + i * buffer_len, buffer_len, &addrs[i], sync);
+    if (read_bytes < 0) {
+      return (i > 0) ? i : -1;
+    }
+    if (read_bytes == 0) {
+      return i;
+    }
+    lengths[i] = read_bytes;
+  }
+  return count;
+}
+
 bool SocketBase::AvailableDatagram(intptr_t fd,
                                    void* buffer,
                                    intptr_t num_bytes) {
@@ -154,6 +197,27 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::WriteV(intptr_t fd,
+                            const void* const* buffers,
+                            const intptr_t* lengths,
+                            intptr_t count,
+                            SocketOpKind sync) {
+  ASSERT((count > 0) && (count <= kMaxWriteBuffers));
+  // Write the buffers one at a time, stopping at the first short write.
+  intptr_t total_written = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t written_bytes = Write(fd, buffers[i], lengths[i], sync);
+    if (written_bytes < 0) {
+      return (total_written > 0) ? total_written : written_bytes;
+    }
+    total_written += written_bytes;
+    if (written_bytes < lengths[i]) {
+      break;
+    }
+  }
+  return total_written;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
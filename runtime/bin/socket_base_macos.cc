@@ -15,6 +15,7 @@
 #include <stdlib.h>       // NOLINT
 #include <string.h>       // NOLINT
 #include <sys/stat.h>     // NOLINT
+#include <sys/uio.h>      // NOLINT
 #include <unistd.h>       // NOLINT
 
 #include "bin/fdutils.h"
@@ -97,6 +98,49 @@ intptr_t SocketBase::RecvFrom(intptr_t fd,
   return read_bytes;
 }
 
+intptr_t SocketBase::SendToBatch(intptr_t fd,
+                                 const void* const* buffers,
+                                 const intptr_t* lengths,
+                                 const RawAddr* addrs,
+                                 intptr_t count,
+                                 SocketOpKind sync) {
+  ASSERT((count > 0) && (count <= kMaxDatagramBatch));
+  // Send the datagrams one at a time, stopping when the socket would block.
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t written_bytes = SendTo(fd, buffers[i], lengths[i], addrs[i], sync);
+    if (written_bytes < 0) {
+      return (i > 0) ? i : -1;
+    }
+    if ((written_bytes == 0) && (lengths[i] > 0)) {
+      return i;
+    }
+  }
+  return count;
+}
+
+intptr_t SocketBase::RecvFromBatch(intptr_t fd,
+                                   uint8_t* buffer,
+                                   intptr_t buffer_len,
+                                   intptr_t count,
+                                   intptr_t* lengths,
+                                   RawAddr* addrs,
+                                   SocketOpKind sync) {
+  ASSERT((count > 0) && (count <= kMaxDatagramBatch));
+  // Receive the datagrams one at a time, stopping when none are left.
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t read_bytes =
+        RecvFrom(fd, buffer + i * buffer_len, buffer_len, &addrs[i], sync);
+    if (read_bytes < 0) {
+      return (i > 0) ? i : -1;
+    }
+    if (read_bytes == 0) {
+      return i;
+    }
+    lengths[i] = read_bytes;
+  }
+  return count;
+}
+
 bool SocketBase::AvailableDatagram(intptr_t fd,
                                    void* buffer,
                                    intptr_t num_bytes) {
@@ -121,6 +165,28 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::WriteV(intptr_t fd,
+                            const void* const* buffers,
+                            const intptr_t* lengths,
+                            intptr_t count,
+                            SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  ASSERT((count > 0) && (count <= kMaxWriteBuffers));
+  struct iovec iov[kMaxWriteBuffers];
+  for (intptr_t i = 0; i < count; i++) {
+    iov[i].iov_base = const_cast<void*>(buffers[i]);
+    iov[i].iov_len = lengths[i];
+  }
+  ssize_t written_bytes = TEMP_FAILURE_RETRY(writev(fd, iov, count));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if ((sync == kAsync) && (written_bytes == -1) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    written_bytes = 0;
+  }
+  return written_bytes;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -46,15 +46,24 @@ typedef int64_t Dart_Port_DL;
 typedef void (*Dart_NativeMessageHandler_DL)(Dart_Port_DL dest_port_id,
                                              Dart_CObject* message);
 
+typedef void (*Dart_NativeMessageBatchHandler_DL)(Dart_Port_DL dest_port_id,
+                                                  intptr_t num_messages,
+                                                  Dart_CObject** messages);
+
 // dart_native_api.h symbols can be called on any thread.
 #define DART_NATIVE_API_DL_SYMBOLS(F)                                          \
   /***** dart_native_api.h *****/                                              \
   /* Dart_Port */                                                              \
   F(Dart_PostCObject, bool, (Dart_Port_DL port_id, Dart_CObject * message))    \
   F(Dart_PostInteger, bool, (Dart_Port_DL port_id, int64_t message))           \
+  F(Dart_PostCObjectBatch, bool,                                               \
+    (Dart_Port_DL port_id, intptr_t num_messages, Dart_CObject** messages))    \
   F(Dart_NewNativePort, Dart_Port_DL,                                          \
     (const char* name, Dart_NativeMessageHandler_DL handler,                   \
      bool handle_concurrently))                                                \
+  F(Dart_NewNativeBatchPort, Dart_Port_DL,                                     \
+    (const char* name, Dart_NativeMessageBatchHandler_DL handler,              \
+     intptr_t max_batch_size))                                                 \
   F(Dart_CloseNativePort, bool, (Dart_Port_DL native_port_id))
 
 // dart_api.h symbols can only be called on Dart threads.
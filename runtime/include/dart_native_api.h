@@ -111,6 +111,29 @@ typedef struct _Dart_CObject {
  */
 DART_EXPORT bool Dart_PostCObject(Dart_Port port_id, Dart_CObject* message);
 
+/**
+ * Posts several messages on some port at once, in order.
+ *
+ * This is equivalent to calling Dart_PostCObject for each message, but looks
+ * up the port and wakes up its receiver only once.
+ *
+ * If true is returned, all messages were enqueued. If false is returned, none
+ * of the messages were enqueued and ownership of external typed data in the
+ * messages remains with the caller.
+ *
+ * This function may be called on any thread when the VM is running (that is,
+ * after Dart_Initialize has returned and before Dart_Cleanup has been called).
+ *
+ * \param port_id The destination port.
+ * \param num_messages The number of messages to send.
+ * \param messages The messages to send.
+ *
+ * \return True if the messages were posted.
+ */
+DART_EXPORT bool Dart_PostCObjectBatch(Dart_Port port_id,
+                                       intptr_t num_messages,
+                                       Dart_CObject** messages);
+
 /**
  * Posts a message on some port. The message will contain the integer 'message'.
  *
@@ -153,10 +176,44 @@ DART_EXPORT Dart_Port Dart_NewNativePort(const char* name,
                                          bool handle_concurrently);
 /* TODO(turnidge): Currently handle_concurrently is ignored. */
 
+/**
+ * A native message handler that receives several messages at once.
+ *
+ * This handler is associated with a native port by calling
+ * Dart_NewNativeBatchPort.
+ *
+ * The messages received are decoded into the message structures, in the
+ * order in which they were posted. The lifetime of the messages and of the
+ * array is controlled by the caller. All the data references from the
+ * messages are allocated by the caller and will be reclaimed when returning
+ * to it.
+ */
+typedef void (*Dart_NativeMessageBatchHandler)(Dart_Port dest_port_id,
+                                               intptr_t num_messages,
+                                               Dart_CObject** messages);
+
+/**
+ * Creates a new native port whose handler receives the pending messages on
+ * the port in batches, rather than one at a time.
+ *
+ * \param name The name of this port in debugging messages.
+ * \param handler The C handler to run when messages arrive on the port.
+ * \param max_batch_size The maximum number of messages passed to a single
+ *   invocation of the handler.
+ *
+ * \return If successful, returns the port id for the native port.  In
+ *   case of error, returns ILLEGAL_PORT.
+ */
+DART_EXPORT Dart_Port
+Dart_NewNativeBatchPort(const char* name,
+                        Dart_NativeMessageBatchHandler handler,
+                        intptr_t max_batch_size);
+
 /**
  * Closes the native port with the given id.
  *
- * The port must have been allocated by a call to Dart_NewNativePort.
+ * The port must have been allocated by a call to Dart_NewNativePort or
+ * Dart_NewNativeBatchPort.
  *
  * \param native_port_id The id of the native port to close.
  *
@@ -14,16 +14,20 @@
 #include "vm/dart_api_impl.h"
 #include "vm/dart_api_message.h"
 #include "vm/dart_entry.h"
+#include "vm/debugger.h"
 #include "vm/exceptions.h"
 #include "vm/hash_table.h"
 #include "vm/lockers.h"
 #include "vm/longjump.h"
 #include "vm/message_handler.h"
 #include "vm/object.h"
+#include "vm/object_graph_copy.h"
 #include "vm/object_store.h"
 #include "vm/port.h"
 #include "vm/resolver.h"
 #include "vm/service.h"
+#include "vm/service_isolate.h"
+#include "vm/shared_ring_buffer.h"
 #include "vm/snapshot.h"
 #include "vm/symbols.h"
 
@@ -100,12 +104,36 @@ DEFINE_NATIVE_ENTRY(SendPortImpl_sendInternal_, 0, 2) {
   if (ApiObjectConverter::CanConvert(obj.raw())) {
     PortMap::PostMessage(
         Message::New(destination_port_id, obj.raw(), Message::kNormalPriority));
-  } else {
-    MessageWriter writer(can_send_any_object);
-    // TODO(turnidge): Throw an exception when the return value is false?
-    PortMap::PostMessage(writer.WriteMessage(obj, destination_port_id,
-                                             Message::kNormalPriority));
+    return Object::null();
+  }
+
+  // The receiver shares our heap, so the message can be copied directly into
+  // it instead of going through a snapshot.
+  if (FLAG_copy_isolate_group_messages &&
+      PortMap::IsReceiverInThisIsolateGroup(destination_port_id,
+                                            isolate->group())) {
+    Object& copy = Object::Handle(zone);
+    bool copied;
+    {
+      ObjectGraphCopier copier(thread);
+      copied = copier.Copy(obj, &copy);
+    }
+    if (copied) {
+      PersistentHandle* handle =
+          isolate->group()->api_state()->AllocatePersistentHandle();
+      handle->set_raw(copy);
+      PortMap::PostMessage(
+          Message::New(destination_port_id,
+                       new Bequest(handle, destination_port_id),
+                       Message::kNormalPriority));
+      return Object::null();
+    }
   }
+
+  MessageWriter writer(can_send_any_object);
+  // TODO(turnidge): Throw an exception when the return value is false?
+  PortMap::PostMessage(writer.WriteMessage(obj, destination_port_id,
+                                           Message::kNormalPriority));
   return Object::null();
 }
 
@@ -289,6 +317,67 @@ static void ThrowIsolateSpawnException(const String& message) {
   Exceptions::ThrowByType(Exceptions::kIsolateSpawn, args);
 }
 
+// Creates an isolate in [group] and runs the initialize callback of the
+// embedder for it. The isolate is not running yet.
+static Isolate* CreateIsolateInGroup(IsolateGroup* group,
+                                     const char* name,
+                                     char** error,
+                                     bool is_idle = false) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  Isolate* isolate =
+      CreateWithinExistingIsolateGroupAOT(group, name, error, is_idle);
+#else
+  Isolate* isolate =
+      CreateWithinExistingIsolateGroup(group, name, error, is_idle);
+#endif
+  if (isolate == nullptr) {
+    return nullptr;
+  }
+
+  void* child_isolate_data = nullptr;
+  bool success = Isolate::InitializeCallback()(&child_isolate_data, error);
+  isolate->set_init_callback_data(child_isolate_data);
+  if (!success) {
+    Dart_ShutdownIsolate();
+    return nullptr;
+  }
+  Dart_ExitIsolate();
+  return isolate;
+}
+
+// Names an idle isolate taken from its group and announces it to the
+// service, which does not know about idle isolates.
+static void ClaimIdleIsolate(Isolate* isolate, const char* name) {
+  isolate->set_name(name);
+  StartIsolateScope start_scope(isolate);
+  Thread* thread = Thread::Current();
+  StackZone zone(thread);
+  HandleScope handle_scope(thread);
+  isolate->set_is_idle(false);
+  ServiceIsolate::SendIsolateStartupMessage();
+#if !defined(PRODUCT)
+  isolate->debugger()->NotifyIsolateCreated();
+#endif
+}
+
+// Creates idle isolates in [group] until it has --isolate_pool_size of them.
+static void FillIdleIsolates(IsolateGroup* group) {
+  while (group->IdleIsolateCount() < FLAG_isolate_pool_size) {
+    char* error = nullptr;
+    Isolate* isolate = CreateIsolateInGroup(group, group->source()->name,
+                                            &error, /*is_idle=*/true);
+    if (isolate == nullptr) {
+      // Spawns create their isolates themselves then.
+      free(error);
+      return;
+    }
+    if (!group->AddIdleIsolate(isolate)) {
+      Dart::ShutdownIsolate(isolate);
+      return;
+    }
+  }
+}
+
 class SpawnIsolateTask : public ThreadPool::Task {
  public:
   SpawnIsolateTask(Isolate* parent_isolate,
@@ -345,29 +434,18 @@ class SpawnIsolateTask : public ThreadPool::Task {
         return;
       }
 
-#if defined(DART_PRECOMPILED_RUNTIME)
-      isolate = CreateWithinExistingIsolateGroupAOT(group, name, &error);
-#else
-      isolate = CreateWithinExistingIsolateGroup(group, name, &error);
-#endif
-      parent_isolate_->DecrementSpawnCount();
-      parent_isolate_ = nullptr;
-      if (isolate == nullptr) {
-        FailedSpawn(error);
-        free(error);
-        return;
-      }
-
-      void* child_isolate_data = nullptr;
-      bool success = initialize_callback(&child_isolate_data, &error);
-      isolate->set_init_callback_data(child_isolate_data);
-      if (!success) {
-        Dart_ShutdownIsolate();
-        FailedSpawn(error);
-        free(error);
-        return;
+      // The parent isolate keeps the group alive until the spawn is done.
+      isolate = group->TakeIdleIsolate();
+      if (isolate != nullptr) {
+        ClaimIdleIsolate(isolate, name);
+      } else {
+        isolate = CreateIsolateInGroup(group, name, &error);
+        if (isolate == nullptr) {
+          FailedSpawn(error);
+          free(error);
+          return;
+        }
       }
-      Dart_ExitIsolate();
     }
 
     if (isolate == nullptr) {
@@ -381,11 +459,19 @@ class SpawnIsolateTask : public ThreadPool::Task {
       // to the origin_id of the parent isolate.
       isolate->set_origin_id(state_->origin_id());
     }
-    MutexLocker ml(isolate->mutex());
-    state_->set_isolate(isolate);
-    isolate->set_spawn_state(std::move(state_));
-    if (isolate->is_runnable()) {
-      isolate->Run();
+    {
+      MutexLocker ml(isolate->mutex());
+      state_->set_isolate(isolate);
+      isolate->set_spawn_state(std::move(state_));
+      if (isolate->is_runnable()) {
+        isolate->Run();
+      }
+    }
+
+    // Replace the idle isolate that was taken, or create the first ones, now
+    // that the new isolate is running.
+    if (parent_isolate_ != nullptr) {
+      FillIdleIsolates(group);
     }
   }
 
@@ -748,4 +834,157 @@ DEFINE_NATIVE_ENTRY(TransferableTypedData_materialize, 0, 1) {
   return typed_data.raw();
 }
 
+// The native field of a SharedRingBuffer object points to its endpoint, which
+// holds the reference of the isolate to the buffer until the object is closed
+// or collected, along with the tickets it created.
+struct SharedRingBufferEndpoint {
+  SharedRingBuffer* buffer;
+  MallocGrowableArray<int64_t> tickets;
+};
+
+static void DetachSharedRingBuffer(SharedRingBufferEndpoint* endpoint) {
+  // Tickets that were not used are revoked, as nothing else could free them.
+  for (intptr_t i = 0; i < endpoint->tickets.length(); i++) {
+    SharedRingBuffer::Revoke(endpoint->tickets[i]);
+  }
+  endpoint->tickets.Clear();
+  endpoint->buffer->Detach();
+  endpoint->buffer = nullptr;
+}
+
+static void SharedRingBufferFinalizer(void* isolate_callback_data,
+                                      void* peer) {
+  SharedRingBufferEndpoint* endpoint =
+      reinterpret_cast<SharedRingBufferEndpoint*>(peer);
+  if (endpoint->buffer != nullptr) {
+    DetachSharedRingBuffer(endpoint);
+  }
+  delete endpoint;
+}
+
+static void SetSharedRingBuffer(Thread* thread,
+                                const Instance& instance,
+                                SharedRingBuffer* buffer) {
+  SharedRingBufferEndpoint* endpoint = new SharedRingBufferEndpoint();
+  endpoint->buffer = buffer;
+  instance.SetNativeField(0, reinterpret_cast<intptr_t>(endpoint));
+  FinalizablePersistentHandle::New(
+      thread->isolate(), instance, endpoint, &SharedRingBufferFinalizer,
+      buffer->capacity() * buffer->record_size(), /*auto_delete=*/true);
+}
+
+static SharedRingBufferEndpoint* GetSharedRingBufferEndpoint(
+    const Instance& instance) {
+  SharedRingBufferEndpoint* endpoint =
+      reinterpret_cast<SharedRingBufferEndpoint*>(instance.GetNativeField(0));
+  // The Dart side checks that the buffer is not closed.
+  if (endpoint == nullptr || endpoint->buffer == nullptr) {
+    Exceptions::ThrowArgumentError(instance);
+  }
+  return endpoint;
+}
+
+static SharedRingBuffer* GetSharedRingBuffer(const Instance& instance) {
+  return GetSharedRingBufferEndpoint(instance)->buffer;
+}
+
+DEFINE_NATIVE_ENTRY(SharedRingBuffer_create, 0, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, record_size, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, capacity, arguments->NativeArgAt(2));
+  SharedRingBuffer* buffer =
+      SharedRingBuffer::New(record_size.Value(), capacity.Value());
+  if (buffer == nullptr) {
+    const Instance& exception =
+        Instance::Handle(thread->isolate()->object_store()->out_of_memory());
+    Exceptions::Throw(thread, exception);
+    UNREACHABLE();
+  }
+  SetSharedRingBuffer(thread, instance, buffer);
+  return Object::null();
+}
+
+DEFINE_NATIVE_ENTRY(SharedRingBuffer_attach, 0, 2) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, ticket, arguments->NativeArgAt(1));
+  SharedRingBuffer* buffer = SharedRingBuffer::Attach(ticket.AsInt64Value());
+  if (buffer == nullptr) {
+    const String& error = String::Handle(
+        String::New("Attempt to attach with a ticket that was used already "
+                    "or whose buffer was closed."));
+    Exceptions::ThrowArgumentError(error);
+    UNREACHABLE();
+  }
+  SetSharedRingBuffer(thread, instance, buffer);
+  return Object::null();
+}
+
+DEFINE_NATIVE_ENTRY(SharedRingBuffer_getRecordSize, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  return Smi::New(GetSharedRingBuffer(instance)->record_size());
+}
+
+DEFINE_NATIVE_ENTRY(SharedRingBuffer_getCapacity, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  return Smi::New(GetSharedRingBuffer(instance)->capacity());
+}
+
+DEFINE_NATIVE_ENTRY(SharedRingBuffer_getLength, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  return Smi::New(GetSharedRingBuffer(instance)->Length());
+}
+
+DEFINE_NATIVE_ENTRY(SharedRingBuffer_share, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  SharedRingBufferEndpoint* endpoint = GetSharedRingBufferEndpoint(instance);
+  const int64_t ticket = endpoint->buffer->Share();
+  endpoint->tickets.Add(ticket);
+  return Integer::New(ticket);
+}
+
+DEFINE_NATIVE_ENTRY(SharedRingBuffer_tryPush, 0, 2) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  GET_NATIVE_ARGUMENT(Instance, record, arguments->NativeArgAt(1));
+  SharedRingBuffer* buffer = GetSharedRingBuffer(instance);
+  if (GetTypedDataSizeOrThrow(record) < buffer->record_size()) {
+    Exceptions::ThrowArgumentError(record);
+  }
+  NoSafepointScope no_safepoint;
+  return Bool::Get(buffer->TryPush(TypedDataBase::Cast(record).DataAddr(0)))
+      .raw();
+}
+
+DEFINE_NATIVE_ENTRY(SharedRingBuffer_tryPop, 0, 2) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  GET_NATIVE_ARGUMENT(Instance, record, arguments->NativeArgAt(1));
+  SharedRingBuffer* buffer = GetSharedRingBuffer(instance);
+  if (GetTypedDataSizeOrThrow(record) < buffer->record_size()) {
+    Exceptions::ThrowArgumentError(record);
+  }
+  NoSafepointScope no_safepoint;
+  return Bool::Get(buffer->TryPop(TypedDataBase::Cast(record).DataAddr(0)))
+      .raw();
+}
+
+DEFINE_NATIVE_ENTRY(SharedRingBuffer_ringWhenNotEmpty, 0, 2) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(SendPort, port, arguments->NativeArgAt(1));
+  GetSharedRingBuffer(instance)->RingWhenNotEmpty(port.Id());
+  return Object::null();
+}
+
+DEFINE_NATIVE_ENTRY(SharedRingBuffer_ringWhenNotFull, 0, 2) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(SendPort, port, arguments->NativeArgAt(1));
+  GetSharedRingBuffer(instance)->RingWhenNotFull(port.Id());
+  return Object::null();
+}
+
+DEFINE_NATIVE_ENTRY(SharedRingBuffer_close, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  // The endpoint itself is deleted by the finalizer.
+  DetachSharedRingBuffer(GetSharedRingBufferEndpoint(instance));
+  return Object::null();
+}
+
 }  // namespace dart
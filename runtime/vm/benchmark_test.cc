@@ -18,7 +18,10 @@
 #include "vm/clustered_snapshot.h"
 #include "vm/dart_api_impl.h"
 #include "vm/datastream.h"
+#include "vm/message_handler.h"
+#include "vm/port.h"
 #include "vm/stack_frame.h"
+#include "vm/thread_pool.h"
 #include "vm/timer.h"
 
 using dart::bin::File;
@@ -587,6 +590,80 @@ BENCHMARK(SimpleMessage) {
   benchmark->set_score(elapsed_time);
 }
 
+class FanInMessageHandler : public MessageHandler {
+ public:
+  explicit FanInMessageHandler(intptr_t expected)
+      : expected_(expected), count_(0), monitor_() {}
+
+  MessageStatus HandleMessage(std::unique_ptr<Message> message) {
+    MonitorLocker ml(&monitor_);
+    if (++count_ == expected_) {
+      ml.Notify();
+    }
+    return kOK;
+  }
+
+  void WaitForMessages() {
+    MonitorLocker ml(&monitor_);
+    while (count_ < expected_) {
+      ml.Wait();
+    }
+  }
+
+ private:
+  const intptr_t expected_;
+  intptr_t count_;
+  Monitor monitor_;
+
+  DISALLOW_COPY_AND_ASSIGN(FanInMessageHandler);
+};
+
+struct FanInSenderInfo {
+  Dart_Port port;
+  intptr_t count;
+  ThreadJoinId join_id;
+};
+
+static void FanInSender(uword param) {
+  FanInSenderInfo* info = reinterpret_cast<FanInSenderInfo*>(param);
+  info->join_id = OSThread::GetCurrentThreadJoinId(OSThread::Current());
+  for (intptr_t i = 0; i < info->count; i++) {
+    PortMap::PostMessage(
+        Message::New(info->port, Smi::New(i), Message::kNormalPriority));
+  }
+}
+
+// Many threads posting messages to the same port at once, as when workers
+// report back to a single isolate.
+BENCHMARK(MessageFanIn) {
+  const intptr_t kNumSenders = 32;
+  const intptr_t kMessagesPerSender = 10000;
+  FanInMessageHandler handler(kNumSenders * kMessagesPerSender);
+  ThreadPool pool;
+  const Dart_Port port = PortMap::CreatePort(&handler);
+  PortMap::SetPortState(port, PortMap::kLivePort);
+  handler.Run(&pool, nullptr, nullptr, 0);
+
+  FanInSenderInfo senders[kNumSenders];
+  Timer timer(true, "Message fan in");
+  timer.Start();
+  for (intptr_t i = 0; i < kNumSenders; i++) {
+    senders[i].port = port;
+    senders[i].count = kMessagesPerSender;
+    senders[i].join_id = OSThread::kInvalidThreadJoinId;
+    OSThread::Start("FanInSender", FanInSender,
+                    reinterpret_cast<uword>(&senders[i]));
+  }
+  handler.WaitForMessages();
+  timer.Stop();
+  for (intptr_t i = 0; i < kNumSenders; i++) {
+    OSThread::Join(senders[i].join_id);
+  }
+  PortMap::ClosePort(port);
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
 BENCHMARK(LargeMap) {
   const char* kScript =
       "makeMap() {\n"
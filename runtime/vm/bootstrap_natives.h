@@ -422,6 +422,17 @@ namespace dart {
   V(DartNativeApiFunctionPointer, 1)                                           \
   V(TransferableTypedData_factory, 2)                                          \
   V(TransferableTypedData_materialize, 1)                                      \
+  V(SharedRingBuffer_create, 3)                                                \
+  V(SharedRingBuffer_attach, 2)                                                \
+  V(SharedRingBuffer_getRecordSize, 1)                                         \
+  V(SharedRingBuffer_getCapacity, 1)                                           \
+  V(SharedRingBuffer_getLength, 1)                                             \
+  V(SharedRingBuffer_share, 1)                                                 \
+  V(SharedRingBuffer_tryPush, 2)                                               \
+  V(SharedRingBuffer_tryPop, 2)                                                \
+  V(SharedRingBuffer_ringWhenNotEmpty, 2)                                      \
+  V(SharedRingBuffer_ringWhenNotFull, 2)                                       \
+  V(SharedRingBuffer_close, 1)                                                 \
   V(Wasm_initModule, 2)                                                        \
   V(Wasm_describeModule, 1)                                                    \
   V(Wasm_initImports, 1)                                                       \
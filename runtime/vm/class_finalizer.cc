@@ -194,6 +194,12 @@ bool ClassFinalizer::ProcessPendingClasses() {
     class_array = object_store->pending_classes();
     ASSERT(!class_array.IsNull());
     Class& cls = Class::Handle();
+#if defined(SUPPORT_TIMELINE)
+    if (tbes.enabled()) {
+      tbes.SetNumArguments(1);
+      tbes.FormatArgument(0, "classCount", "%" Pd, class_array.Length());
+    }
+#endif  // defined(SUPPORT_TIMELINE)
 
 #if defined(DEBUG)
     for (intptr_t i = 0; i < class_array.Length(); i++) {
@@ -418,7 +418,8 @@ class ClassTable {
   friend class Dart;
   friend Isolate* CreateWithinExistingIsolateGroup(IsolateGroup* group,
                                                    const char* name,
-                                                   char** error);
+                                                   char** error,
+                                                   bool is_idle);
   friend class Isolate;  // for table()
   static const int kInitialCapacity = SharedClassTable::kInitialCapacity;
   static const int kCapacityIncrement = SharedClassTable::kCapacityIncrement;
@@ -172,7 +172,8 @@ FlowGraphCompiler::FlowGraphCompiler(
 
 bool FlowGraphCompiler::IsUnboxedField(const Field& field) {
   // The `field.is_non_nullable_integer()` is set in the kernel loader and can
-  // only be set if we consume a AOT kernel (annotated with inferred types).
+  // only be set if we consume a AOT kernel (annotated with inferred types or
+  // compiled with sound null safety).
   ASSERT(!field.is_non_nullable_integer() || FLAG_precompiled_mode);
   const bool valid_class =
       (SupportsUnboxedDoubles() && (field.guarded_cid() == kDoubleCid)) ||
@@ -207,6 +208,11 @@ void FlowGraphCompiler::InitCompiler() {
   // indicating a non-leaf routine and calls without IC data indicating
   // possible reoptimization.
 
+  if (is_quick_tier()) {
+    ASSERT(is_optimizing() && !flow_graph().IsCompiledForOsr());
+    may_reoptimize_ = true;
+  }
+
   for (int i = 0; i < block_order_.length(); ++i) {
     block_info_.Add(new (zone()) BlockInfo());
     if (is_optimizing() && !flow_graph().IsCompiledForOsr()) {
@@ -1942,7 +1948,9 @@ const ICData* FlowGraphCompiler::GetOrAddStaticCallICData(
 
 intptr_t FlowGraphCompiler::GetOptimizationThreshold() const {
   intptr_t threshold;
-  if (is_optimizing()) {
+  if (is_quick_tier()) {
+    threshold = FLAG_optimization_counter_threshold;
+  } else if (is_optimizing()) {
     threshold = FLAG_reoptimization_counter_threshold;
   } else if (parsed_function_.function().IsIrregexpFunction()) {
     threshold = FLAG_regexp_optimization_counter_threshold;
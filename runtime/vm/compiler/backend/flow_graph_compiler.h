@@ -888,6 +888,12 @@ class FlowGraphCompiler : public ValueObject {
 
   bool may_reoptimize() const { return may_reoptimize_; }
 
+  // Code produced by the quick optimizing tier counts invocations at entry
+  // (like unoptimized code) so that functions which stay hot get reoptimized
+  // with the full pipeline.
+  bool is_quick_tier() const { return is_quick_tier_; }
+  void set_is_quick_tier(bool value) { is_quick_tier_ = value; }
+
   // Use in unoptimized compilation to preserve/reuse ICData.
   const ICData* GetOrAddInstanceCallICData(intptr_t deopt_id,
                                            const String& target_name,
@@ -1203,6 +1209,7 @@ class FlowGraphCompiler : public ValueObject {
   SpeculativeInliningPolicy* speculative_policy_;
   // Set to true if optimized code has IC calls.
   bool may_reoptimize_;
+  bool is_quick_tier_ = false;
   // True while emitting intrinsic code.
   bool intrinsic_mode_;
   compiler::Label* intrinsic_slow_path_label_ = nullptr;
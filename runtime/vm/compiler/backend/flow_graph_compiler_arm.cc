@@ -838,8 +838,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
                    function_reg,
                    compiler::target::Function::usage_counter_offset()));
     // Reoptimization of an optimized function is triggered by counting in
-    // IC stubs, but not at the entry of the function.
-    if (!is_optimizing()) {
+    // IC stubs, but not at the entry of the function (unless the code was
+    // produced by the quick optimizing tier).
+    if (!is_optimizing() || is_quick_tier()) {
       __ add(R3, R3, compiler::Operand(1));
       __ str(R3, compiler::FieldAddress(
                      function_reg,
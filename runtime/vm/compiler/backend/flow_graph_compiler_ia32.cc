@@ -766,8 +766,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
     __ LoadObject(function_reg, function);
 
     // Reoptimization of an optimized function is triggered by counting in
-    // IC stubs, but not at the entry of the function.
-    if (!is_optimizing()) {
+    // IC stubs, but not at the entry of the function (unless the code was
+    // produced by the quick optimizing tier).
+    if (!is_optimizing() || is_quick_tier()) {
       __ incl(compiler::FieldAddress(function_reg,
                                      Function::usage_counter_offset()));
     }
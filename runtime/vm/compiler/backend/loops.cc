@@ -1036,6 +1036,43 @@ bool LoopInfo::IsAlwaysTaken(BlockEntryInstr* block) const {
   return false;
 }
 
+bool LoopInfo::HasConstantTripCount(int64_t* trip_count) const {
+  if (control_ == nullptr) {
+    return false;
+  }
+  InductionVar* limit = nullptr;
+  for (auto bound : control_->bounds()) {
+    if (bound.branch_ == header_->last_instruction()) {
+      limit = bound.limit_;
+      break;
+    }
+  }
+  int64_t stride = 0;
+  int64_t begin = 0;
+  int64_t end = 0;
+  if (limit == nullptr || !InductionVar::IsLinear(control_, &stride) ||
+      !InductionVar::IsConstant(control_->initial(), &begin) ||
+      !InductionVar::IsConstant(limit, &end)) {
+    return false;
+  }
+  // Only unit strides are recorded as bounds on the control induction, so
+  // the trip count is the distance between the initial value and the
+  // exclusive limit. Reject distances that do not fit into int64_t.
+  int64_t count = 0;
+  if (stride == 1) {
+    count = begin < end ? Utils::SubWithWrapAround(end, begin) : 0;
+  } else if (stride == -1) {
+    count = begin > end ? Utils::SubWithWrapAround(begin, end) : 0;
+  } else {
+    return false;
+  }
+  if (count < 0) {
+    return false;
+  }
+  *trip_count = count;
+  return true;
+}
+
 bool LoopInfo::IsHeaderPhi(Definition* def) const {
   return def != nullptr && def->IsPhi() && def->GetBlock() == header_ &&
          !def->AsPhi()->IsRedundant();  // phi(x,..,x) = x
@@ -247,6 +247,12 @@ class LoopInfo : public ZoneAllocated {
   // Tests if index stays in [0,length) range in this loop at given position.
   bool IsInRange(Instruction* pos, Value* index, Value* length);
 
+  // Returns true if the control induction of this loop bounds the number of
+  // iterations by a constant (e.g. for (int i = 0; i < 64; i++)). Sets the
+  // output parameter trip_count on success. Note that other loop exits may
+  // still leave the loop earlier.
+  bool HasConstantTripCount(int64_t* trip_count) const;
+
   // Getters.
   intptr_t id() const { return id_; }
   BlockEntryInstr* header() const { return header_; }
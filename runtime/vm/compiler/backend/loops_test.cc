@@ -61,8 +61,8 @@ void TestString(BaseTextBuffer* f,
   }
 }
 
-// Helper method to build CFG and compute induction.
-static const char* ComputeInduction(Thread* thread, const char* script_chars) {
+// Helper method to build CFG of foo().
+static FlowGraph* BuildFlowGraph(const char* script_chars) {
   // Load the script and exercise the code once.
   const auto& root_library = Library::Handle(LoadTestScript(script_chars));
   Invoke(root_library, "main");
@@ -74,7 +74,12 @@ static const char* ComputeInduction(Thread* thread, const char* script_chars) {
   };
   const auto& function = Function::Handle(GetFunction(root_library, "foo"));
   TestPipeline pipeline(function, CompilerPass::kJIT);
-  FlowGraph* flow_graph = pipeline.RunPasses(passes);
+  return pipeline.RunPasses(passes);
+}
+
+// Helper method to build CFG and compute induction.
+static const char* ComputeInduction(Thread* thread, const char* script_chars) {
+  FlowGraph* flow_graph = BuildFlowGraph(script_chars);
 
   // Build loop hierarchy and find induction.
   const LoopHierarchy& hierarchy = flow_graph->GetLoopHierarchy();
@@ -88,6 +93,23 @@ static const char* ComputeInduction(Thread* thread, const char* script_chars) {
   return Thread::Current()->zone()->MakeCopyOfString(buffer);
 }
 
+// Helper method to build CFG and compute the trip count of the outermost
+// loop, or -1 if it is not a constant.
+static int64_t ComputeTripCount(const char* script_chars) {
+  FlowGraph* flow_graph = BuildFlowGraph(script_chars);
+
+  const LoopHierarchy& hierarchy = flow_graph->GetLoopHierarchy();
+  hierarchy.ComputeInduction();
+  flow_graph->RemoveRedefinitions();  // don't query later
+
+  int64_t trip_count = 0;
+  LoopInfo* loop = hierarchy.top();
+  if (loop != nullptr && loop->HasConstantTripCount(&trip_count)) {
+    return trip_count;
+  }
+  return -1;
+}
+
 //
 // Induction tests.
 //
@@ -513,4 +535,64 @@ ISOLATE_UNIT_TEST_CASE(SecondExitDown) {
   EXPECT_STREQ(expected, ComputeInduction(thread, script_chars));
 }
 
+//
+// Trip count tests.
+//
+
+ISOLATE_UNIT_TEST_CASE(TripCountUp) {
+  const char* script_chars =
+      R"(
+      foo() {
+        for (int i = 0; i < 64; i++) {
+        }
+      }
+      main() {
+        foo();
+      }
+    )";
+  EXPECT_EQ(64, ComputeTripCount(script_chars));
+}
+
+ISOLATE_UNIT_TEST_CASE(TripCountDown) {
+  const char* script_chars =
+      R"(
+      foo() {
+        for (int i = 100; i >= 10; i--) {
+        }
+      }
+      main() {
+        foo();
+      }
+    )";
+  EXPECT_EQ(91, ComputeTripCount(script_chars));
+}
+
+ISOLATE_UNIT_TEST_CASE(TripCountEmpty) {
+  const char* script_chars =
+      R"(
+      foo() {
+        for (int i = 10; i < 10; i++) {
+        }
+      }
+      main() {
+        foo();
+      }
+    )";
+  EXPECT_EQ(0, ComputeTripCount(script_chars));
+}
+
+ISOLATE_UNIT_TEST_CASE(TripCountSymbolic) {
+  const char* script_chars =
+      R"(
+      foo(int n) {
+        for (int i = 0; i < n; i++) {
+        }
+      }
+      main() {
+        foo(100);
+      }
+    )";
+  EXPECT_EQ(-1, ComputeTripCount(script_chars));
+}
+
 }  // namespace dart
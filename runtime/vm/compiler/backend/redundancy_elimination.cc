@@ -17,6 +17,11 @@ namespace dart {
 
 DEFINE_FLAG(bool, dead_store_elimination, true, "Eliminate dead stores");
 DEFINE_FLAG(bool, load_cse, true, "Use redundant load elimination.");
+DEFINE_FLAG(bool,
+            partial_load_cse,
+            true,
+            "Eliminate partially redundant loads by inserting them on the "
+            "paths where they are not yet available.");
 DEFINE_FLAG(bool,
             optimize_lazy_initializer_calls,
             true,
@@ -1721,6 +1726,9 @@ class LoadOptimizer : public ValueObject {
 
     ComputeInitialSets();
     ComputeOutSets();
+    if (FLAG_partial_load_cse) {
+      InsertPartiallyRedundantLoads();
+    }
     ComputeOutValues();
     if (graph_->is_licm_allowed()) {
       MarkLoopInvariantLoads();
@@ -2237,6 +2245,126 @@ class LoadOptimizer : public ValueObject {
     }
   }
 
+  // Returns true if the given exposed load can be executed at the end of
+  // the given predecessor of its block instead.
+  bool CanInsertLoadAtEndOf(Definition* load, BlockEntryInstr* pred) {
+    // Only non-critical edges: the predecessor must flow into the load's
+    // block unconditionally, so that the inserted load is executed exactly
+    // when the original one would have been.
+    if (!pred->last_instruction()->IsGoto()) {
+      return false;
+    }
+    // Phi moves would rename the place along this edge.
+    if (aliased_set_->phi_moves()->GetOutgoingMoves(pred) != NULL) {
+      return false;
+    }
+    LoadFieldInstr* load_field = load->AsLoadField();
+    Definition* instance = load_field->instance()->definition();
+    // The instance must be available at the end of the predecessor. Note
+    // that the type of the definition itself (rather than the type reaching
+    // the load) is checked: the load must not fault when moved above checks
+    // which refine the type of the instance.
+    if (!instance->GetBlock()->Dominates(pred) ||
+        instance->Type()->is_nullable()) {
+      return false;
+    }
+    // For the same reason the instance must be known to be of the class
+    // declaring the field, otherwise the moved load would read at the wrong
+    // offset on a path where a CheckClass or type test in the load's block
+    // would have failed.
+    const Slot& slot = load_field->slot();
+    if (!slot.IsDartField()) {
+      return false;
+    }
+    const Class& owner = Class::Handle(Z, slot.field().Owner());
+    const AbstractType& owner_type = AbstractType::Handle(Z, owner.RareType());
+    return instance->Type()->IsSubtypeOf(owner_type);
+  }
+
+  // Partial redundancy elimination for field loads: if an exposed load is
+  // available on some but not all incoming edges of its block, then insert a
+  // copy of the load at the end of each predecessor where it is not available.
+  // The load then becomes fully redundant and is replaced with a phi by
+  // the regular forwarding. This removes loads in if/else diamonds where one
+  // of the branches has already loaded the field.
+  //
+  // Updates IN/OUT/GEN sets of the affected blocks, so it has to be called
+  // after ComputeOutSets() and before ComputeOutValues().
+  void InsertPartiallyRedundantLoads() {
+    GrowableArray<BlockEntryInstr*> missing(2);
+    for (BlockIterator block_it = graph_->reverse_postorder_iterator();
+         !block_it.Done(); block_it.Advance()) {
+      BlockEntryInstr* block = block_it.Current();
+      // Skip loop headers: inserting loads on back edges does not shorten
+      // any path through the loop.
+      if (!block->IsJoinEntry() || !CanMergeEagerly(block)) continue;
+
+      ZoneGrowableArray<Definition*>* loads =
+          exposed_values_[block->preorder_number()];
+      if (loads == NULL) continue;  // No exposed loads.
+
+      BitVector* in = in_[block->preorder_number()];
+      for (intptr_t i = 0; i < loads->length(); i++) {
+        Definition* load = (*loads)[i];
+        const intptr_t place_id = GetPlaceId(load);
+        if (in->Contains(place_id)) continue;  // Fully redundant.
+
+        LoadFieldInstr* load_field = load->AsLoadField();
+        if ((load_field == NULL) || load_field->calls_initializer() ||
+            (load_field->representation() != kTagged) ||
+            load_field->IsPotentialUnboxedDartFieldLoad()) {
+          continue;
+        }
+
+        missing.Clear();
+        bool can_insert = true;
+        for (intptr_t j = 0; j < block->PredecessorCount(); j++) {
+          BlockEntryInstr* pred = block->PredecessorAt(j);
+          if (out_[pred->preorder_number()]->Contains(place_id)) continue;
+          if (!CanInsertLoadAtEndOf(load, pred)) {
+            can_insert = false;
+            break;
+          }
+          missing.Add(pred);
+        }
+        // Require the load to be available on at least one edge, otherwise
+        // nothing is gained by moving it.
+        if (!can_insert || (missing.length() == block->PredecessorCount())) {
+          continue;
+        }
+
+        for (intptr_t j = 0; j < missing.length(); j++) {
+          BlockEntryInstr* pred = missing[j];
+          const intptr_t preorder_number = pred->preorder_number();
+          LoadFieldInstr* copy = new (Z) LoadFieldInstr(
+              new (Z) Value(load_field->instance()->definition()),
+              load_field->slot(), load_field->token_pos());
+          graph_->InsertBefore(pred->last_instruction(), copy, NULL,
+                               FlowGraph::kValue);
+          SetPlaceId(copy, place_id);
+
+          gen_[preorder_number]->Add(place_id);
+          out_[preorder_number]->Add(place_id);
+          if (out_values_[preorder_number] == NULL) {
+            out_values_[preorder_number] = CreateBlockOutValues();
+          }
+          (*out_values_[preorder_number])[place_id] = copy;
+
+          if (FLAG_trace_optimization) {
+            THR_Print("Inserted load v%" Pd " for partially redundant v%" Pd
+                      " in B%" Pd "\n",
+                      copy->ssa_temp_index(), load->ssa_temp_index(),
+                      pred->block_id());
+          }
+        }
+        // The only successor of each of the updated predecessors is this
+        // block, and the load already generates the place in it, so no other
+        // IN/OUT sets change.
+        in->Add(place_id);
+      }
+    }
+  }
+
   // Compute out_values mappings by propagating them in reverse postorder once
   // through the graph. Generate phis on back edges where eager merge is
   // impossible.
@@ -4228,7 +4356,67 @@ void DeadCodeElimination::EliminateDeadCode(FlowGraph* flow_graph) {
   }
 }
 
+// Upper bound on the trip count of loops which are allowed to run without an
+// interrupt check on every iteration.
+static const int64_t kMaxTripCountWithoutStackOverflowCheck = 128;
+
+void CheckStackOverflowElimination::EliminateStackOverflowInShortLoops(
+    FlowGraph* graph) {
+  const LoopHierarchy& loop_hierarchy = graph->GetLoopHierarchy();
+  const ZoneGrowableArray<BlockEntryInstr*>& loop_headers =
+      loop_hierarchy.headers();
+  loop_hierarchy.ComputeInduction();
+
+  for (intptr_t i = 0; i < loop_headers.length(); ++i) {
+    LoopInfo* loop = loop_headers[i]->loop_info();
+    // Inner loops might iterate an unbounded number of times per iteration
+    // of this loop.
+    if (loop->inner() != nullptr) {
+      continue;
+    }
+    int64_t trip_count = 0;
+    if (!loop->HasConstantTripCount(&trip_count) ||
+        trip_count > kMaxTripCountWithoutStackOverflowCheck) {
+      continue;
+    }
+
+    // Calls can take an arbitrary amount of time, so only loops which are
+    // free of them are guaranteed to reach the next interrupt check quickly.
+    bool has_calls = false;
+    for (BitVector::Iterator loop_it(loop->blocks());
+         !loop_it.Done() && !has_calls; loop_it.Advance()) {
+      BlockEntryInstr* block = graph->preorder()[loop_it.Current()];
+      for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+        Instruction* current = it.Current();
+        if (current->IsBranch()) {
+          current = current->AsBranch()->comparison();
+        }
+        if (current->HasUnknownSideEffects()) {
+          has_calls = true;
+          break;
+        }
+      }
+    }
+    if (has_calls) {
+      continue;
+    }
+
+    for (BitVector::Iterator loop_it(loop->blocks()); !loop_it.Done();
+         loop_it.Advance()) {
+      BlockEntryInstr* block = graph->preorder()[loop_it.Current()];
+      for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+        CheckStackOverflowInstr* check = it.Current()->AsCheckStackOverflow();
+        if (check != nullptr && check->in_loop()) {
+          it.RemoveCurrentFromGraph();
+        }
+      }
+    }
+  }
+}
+
 void CheckStackOverflowElimination::EliminateStackOverflow(FlowGraph* graph) {
+  EliminateStackOverflowInShortLoops(graph);
+
   CheckStackOverflowInstr* first_stack_overflow_instr = NULL;
   for (BlockIterator block_it = graph->reverse_postorder_iterator();
        !block_it.Done(); block_it.Advance()) {
@@ -158,7 +158,12 @@ class DelayAllocations : public AllStatic {
 class CheckStackOverflowElimination : public AllStatic {
  public:
   // For leaf functions with only a single [StackOverflowInstr] we remove it.
+  // Interrupt checks are also removed from short innermost loops, which
+  // iterate a small constant number of times without making calls.
   static void EliminateStackOverflow(FlowGraph* graph);
+
+ private:
+  static void EliminateStackOverflowInShortLoops(FlowGraph* graph);
 };
 
 }  // namespace dart
@@ -956,6 +956,127 @@ ISOLATE_UNIT_TEST_CASE(LoadOptimizer_RedundantStoresAndLoads) {
   EXPECT_EQ(1, aft_stores);
 }
 
+static intptr_t CountLoadsInJoins(FlowGraph* flow_graph) {
+  intptr_t loads = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    if (!block_it.Current()->IsJoinEntry()) continue;
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (it.Current()->IsLoadField()) {
+        loads++;
+      }
+    }
+  }
+  return loads;
+}
+
+ISOLATE_UNIT_TEST_CASE(LoadOptimizer_PartiallyRedundantLoadInDiamond) {
+  const char* kScript = R"(
+    class Foo {
+      int a = 0;
+    }
+
+    @pragma('vm:never-inline')
+    void bar() {}
+
+    int foo(bool cond) {
+      final f = new Foo();
+      int x = 0;
+      if (cond) {
+        x = f.a;
+      } else {
+        bar();
+      }
+      return x + f.a;
+    }
+
+    main() {
+      foo(true);
+      foo(false);
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kSelectRepresentations,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kConstantPropagation,
+  });
+
+  ASSERT(flow_graph != nullptr);
+
+  // Before CSE the load after the diamond is only partially redundant.
+  EXPECT_EQ(1, CountLoadsInJoins(flow_graph));
+
+  DominatorBasedCSE::Optimize(flow_graph);
+
+  // After CSE the load is moved into the branch where it was not available
+  // and replaced with a phi in the join.
+  EXPECT_EQ(0, CountLoadsInJoins(flow_graph));
+  intptr_t loads = 0;
+  intptr_t stores = 0;
+  CountLoadsStores(flow_graph, &loads, &stores);
+  EXPECT_EQ(2, loads);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoadOptimizer_PartiallyRedundantLoadNeedsClassCheck) {
+  const char* kScript = R"(
+    class Foo {
+      int a = 0;
+    }
+
+    @pragma('vm:never-inline')
+    void bar() {}
+
+    int foo(bool cond, bool isFoo) {
+      dynamic o = isFoo ? new Foo() : 42;
+      int x = 0;
+      if (cond) {
+        x = o.a;
+      } else {
+        bar();
+      }
+      return x + o.a;
+    }
+
+    main() {
+      foo(true, true);
+      foo(false, true);
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kSelectRepresentations,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kConstantPropagation,
+  });
+
+  ASSERT(flow_graph != nullptr);
+
+  // The receiver is non-nullable but only known to be a Foo after the
+  // CheckClass in the join, so the load must not be moved above it into
+  // the else branch.
+  EXPECT_EQ(1, CountLoadsInJoins(flow_graph));
+  DominatorBasedCSE::Optimize(flow_graph);
+  EXPECT_EQ(1, CountLoadsInJoins(flow_graph));
+}
+
 ISOLATE_UNIT_TEST_CASE(LoadOptimizer_RedundantStaticFieldInitialization) {
   const char* kScript = R"(
     int getX() => 2;
@@ -1388,6 +1509,92 @@ ISOLATE_UNIT_TEST_CASE(DelayAllocations_DontDelayIntoLoop) {
   EXPECT(call->Receiver()->definition() == allocate);
 }
 
+// Returns the CheckStackOverflow instructions left in loops of [flow_graph].
+static GrowableArray<CheckStackOverflowInstr*> LoopStackOverflowChecks(
+    FlowGraph* flow_graph) {
+  GrowableArray<CheckStackOverflowInstr*> checks;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      CheckStackOverflowInstr* check = it.Current()->AsCheckStackOverflow();
+      if (check != nullptr && check->in_loop()) {
+        checks.Add(check);
+      }
+    }
+  }
+  return checks;
+}
+
+ISOLATE_UNIT_TEST_CASE(CheckStackOverflowElimination_ShortLoop) {
+  const char* kScript = R"(
+    int test() {
+      int sum = 0;
+      for (int i = 0; i < 10; i++) {
+        sum += i;
+      }
+      return sum;
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "test"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  EXPECT_EQ(0, LoopStackOverflowChecks(flow_graph).length());
+}
+
+ISOLATE_UNIT_TEST_CASE(CheckStackOverflowElimination_OuterLoop) {
+  const char* kScript = R"(
+    int test() {
+      int sum = 0;
+      for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+          sum += i ^ j;
+        }
+      }
+      return sum;
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "test"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  // Only the check of the inner loop is removed.
+  GrowableArray<CheckStackOverflowInstr*> checks =
+      LoopStackOverflowChecks(flow_graph);
+  EXPECT_EQ(1, checks.length());
+  EXPECT_EQ(1, checks[0]->loop_depth());
+}
+
+ISOLATE_UNIT_TEST_CASE(CheckStackOverflowElimination_LoopWithCall) {
+  const char* kScript = R"(
+    void test() {
+      for (int i = 0; i < 10; i++) {
+        use(i);
+      }
+    }
+
+    @pragma('vm:never-inline')
+    void use(int i) {
+      print(i);
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "test"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  EXPECT_EQ(1, LoopStackOverflowChecks(flow_graph).length());
+}
+
 #endif  // !defined(TARGET_ARCH_IA32)
 
 }  // namespace dart
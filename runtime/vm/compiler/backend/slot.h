@@ -214,7 +214,8 @@ class Slot : public ZoneAllocated {
 
   // Currently returns the representation of unboxed native fields and kTagged
   // for most other types of fields. One special case: fields marked as
-  // containing non-nullable ints in AOT kernel, which have the kUnboxedInt64
+  // containing non-nullable ints in AOT kernel (either by TFA or by their
+  // sound non-nullable static type), which have the kUnboxedInt64
   // representation.
   Representation representation() const { return representation_; }
 
@@ -178,6 +178,13 @@ class CompilerPass {
   static FlowGraph* RunForceOptimizedPipeline(PipelineMode mode,
                                               CompilerPassState* state);
 
+  // Pipeline which is used for the quick optimizing tier in JIT mode.
+  //
+  // Applies type feedback but skips inlining and loop optimizations.
+  DART_WARN_UNUSED_RESULT
+  static FlowGraph* RunQuickPipeline(PipelineMode mode,
+                                     CompilerPassState* state);
+
  protected:
   // This function executes the pass. If it returns true then
   // we will run Canonicalize on the graph and execute the pass
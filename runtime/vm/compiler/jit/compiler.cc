@@ -55,6 +55,11 @@ DEFINE_FLAG(
     16,
     "How many times we allow deoptimization before we disallow optimization.");
 DEFINE_FLAG(charp, optimization_filter, NULL, "Optimize only named function");
+DEFINE_FLAG(bool,
+            quick_optimizing_tier,
+            false,
+            "First optimize functions with a reduced pipeline (no inlining or "
+            "loop optimizations) and reoptimize them fully if they stay hot.");
 DEFINE_FLAG(bool, print_flow_graph, false, "Print the IR flow graph.");
 DEFINE_FLAG(bool,
             print_flow_graph_optimized,
@@ -319,6 +324,33 @@ bool Compiler::IsBackgroundCompilation() {
   return !Thread::Current()->IsMutatorThread();
 }
 
+// Returns true if the next optimizing compilation of [function] may use the
+// quick optimizing tier. Only the first optimization of a function is quick,
+// OSR, force-optimized and irregexp functions always use the full pipeline.
+static bool ShouldUseQuickOptimizingTier(const Function& function,
+                                         intptr_t osr_id) {
+  return FLAG_quick_optimizing_tier && (osr_id == Compiler::kNoOSRDeoptId) &&
+         !function.ForceOptimize() && !function.IsIrregexpFunction() &&
+         !function.WasQuickOptimized();
+}
+
+// Quick-tier code only counts invocations at function entry, so a function
+// which spends its time in a loop would never be reoptimized. Such functions
+// use the full pipeline right away.
+static bool HasLoops(FlowGraph* flow_graph) {
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      CheckStackOverflowInstr* check = it.Current()->AsCheckStackOverflow();
+      if ((check != nullptr) && check->in_loop()) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 class CompileParsedFunctionHelper : public ValueObject {
  public:
   CompileParsedFunctionHelper(ParsedFunction* parsed_function,
@@ -327,6 +359,9 @@ class CompileParsedFunctionHelper : public ValueObject {
       : parsed_function_(parsed_function),
         optimized_(optimized),
         osr_id_(osr_id),
+        quick_tier_(optimized &&
+                    ShouldUseQuickOptimizingTier(parsed_function->function(),
+                                                 osr_id)),
         thread_(Thread::Current()) {}
 
   CodePtr Compile(CompilationPipeline* pipeline);
@@ -334,6 +369,7 @@ class CompileParsedFunctionHelper : public ValueObject {
  private:
   ParsedFunction* parsed_function() const { return parsed_function_; }
   bool optimized() const { return optimized_; }
+  bool quick_tier() const { return quick_tier_; }
   intptr_t osr_id() const { return osr_id_; }
   Thread* thread() const { return thread_; }
   Isolate* isolate() const { return thread_->isolate(); }
@@ -345,6 +381,7 @@ class CompileParsedFunctionHelper : public ValueObject {
   ParsedFunction* parsed_function_;
   const bool optimized_;
   const intptr_t osr_id_;
+  bool quick_tier_;
   Thread* const thread_;
 
   DISALLOW_COPY_AND_ASSIGN(CompileParsedFunctionHelper);
@@ -454,6 +491,19 @@ CodePtr CompileParsedFunctionHelper::FinalizeCompilation(
       }
     }
 
+    if (!code.IsNull() && quick_tier()) {
+      // Next optimization of this function uses the full pipeline.
+      function.SetWasQuickOptimized(true);
+#if !defined(PRODUCT)
+      isolate()->GetQuickTierOptimizationsMetric()->increment();
+#endif  // !defined(PRODUCT)
+    }
+#if !defined(PRODUCT)
+    if (!code.IsNull() && !quick_tier() && function.WasQuickOptimized()) {
+      isolate()->GetQuickTierReoptimizationsMetric()->increment();
+    }
+#endif  // !defined(PRODUCT)
+
     if (!code.IsNull()) {
       // The generated code was compiled under certain assumptions about
       // class hierarchy and field types. Register these dependencies
@@ -579,6 +629,10 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
             zone, parsed_function(), ic_data_array, osr_id(), optimized());
       }
 
+      if (quick_tier() && HasLoops(flow_graph)) {
+        quick_tier_ = false;
+      }
+
       const bool print_flow_graph =
           (FLAG_print_flow_graph ||
            (optimized() && FLAG_print_flow_graph_optimized)) &&
@@ -605,7 +659,9 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         flow_graph = CompilerPass::RunForceOptimizedPipeline(CompilerPass::kJIT,
                                                              &pass_state);
       } else if (optimized()) {
-        TIMELINE_DURATION(thread(), CompilerVerbose, "OptimizationPasses");
+        TIMELINE_DURATION(thread(), CompilerVerbose,
+                          quick_tier() ? "QuickOptimizationPasses"
+                                       : "OptimizationPasses");
 
         pass_state.inline_id_to_function.Add(&function);
         // We do not add the token position now because we don't know the
@@ -619,7 +675,13 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         JitCallSpecializer call_specializer(flow_graph, &speculative_policy);
         pass_state.call_specializer = &call_specializer;
 
-        flow_graph = CompilerPass::RunPipeline(CompilerPass::kJIT, &pass_state);
+        if (quick_tier()) {
+          flow_graph =
+              CompilerPass::RunQuickPipeline(CompilerPass::kJIT, &pass_state);
+        } else {
+          flow_graph =
+              CompilerPass::RunPipeline(CompilerPass::kJIT, &pass_state);
+        }
       }
 
       ASSERT(pass_state.inline_id_to_function.length() ==
@@ -631,6 +693,7 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
           &speculative_policy, pass_state.inline_id_to_function,
           pass_state.inline_id_to_token_pos, pass_state.caller_inline_id,
           ic_data_array);
+      graph_compiler.set_is_quick_tier(quick_tier());
       {
         TIMELINE_DURATION(thread(), CompilerVerbose, "CompileGraph");
         graph_compiler.CompileGraph();
@@ -934,6 +997,10 @@ ObjectPtr Compiler::CompileOptimizedFunction(Thread* thread,
   const char* event_name;
   if (osr_id != kNoOSRDeoptId) {
     event_name = "CompileFunctionOptimizedOSR";
+  } else if (FLAG_quick_optimizing_tier && function.WasQuickOptimized()) {
+    event_name = IsBackgroundCompilation()
+                     ? "CompileFunctionReoptimizedFromQuickTierBackground"
+                     : "CompileFunctionReoptimizedFromQuickTier";
   } else if (IsBackgroundCompilation()) {
     event_name = "CompileFunctionOptimizedBackground";
   } else {
@@ -17,6 +17,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, quick_optimizing_tier);
+
 ISOLATE_UNIT_TEST_CASE(CompileFunction) {
   const char* kScriptChars =
       "class A {\n"
@@ -152,6 +154,67 @@ ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   BackgroundCompiler::Stop(isolate);
 }
 
+ISOLATE_UNIT_TEST_CASE(CompileFunction_QuickOptimizingTier) {
+  SetFlagScope<bool> sfs(&FLAG_quick_optimizing_tier, true);
+  const char* kScriptChars =
+      "class A {\n"
+      "  static add(a, b) { return a + b; }\n"
+      "  static sum(n) {\n"
+      "    var s = 0;\n"
+      "    for (var i = 0; i < n; i++) s += i;\n"
+      "    return s;\n"
+      "  }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, NULL);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+  Object& result = Object::Handle();
+
+  // The first optimization of a function without loops uses the quick tier,
+  // the next one the full pipeline.
+  Function& add = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("add"))));
+  EXPECT(CompilerTest::TestCompileFunction(add));
+  EXPECT(!add.WasQuickOptimized());
+  result = Compiler::CompileOptimizedFunction(thread, add);
+  EXPECT(result.IsCode());
+  EXPECT(add.HasOptimizedCode());
+  EXPECT(add.WasQuickOptimized());
+  const Code& quick_code = Code::Handle(add.CurrentCode());
+  result = Compiler::CompileOptimizedFunction(thread, add);
+  EXPECT(result.IsCode());
+  EXPECT(add.HasOptimizedCode());
+  EXPECT(add.CurrentCode() != quick_code.raw());
+#if !defined(PRODUCT)
+  EXPECT_EQ(1, thread->isolate()->GetQuickTierOptimizationsMetric()->value());
+  EXPECT_EQ(1,
+            thread->isolate()->GetQuickTierReoptimizationsMetric()->value());
+#endif  // !defined(PRODUCT)
+
+  // Quick-tier code would not count loop iterations, so functions with loops
+  // are fully optimized right away.
+  Function& sum = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("sum"))));
+  EXPECT(CompilerTest::TestCompileFunction(sum));
+  result = Compiler::CompileOptimizedFunction(thread, sum);
+  EXPECT(result.IsCode());
+  EXPECT(sum.HasOptimizedCode());
+  EXPECT(!sum.WasQuickOptimized());
+#if !defined(PRODUCT)
+  EXPECT_EQ(1, thread->isolate()->GetQuickTierOptimizationsMetric()->value());
+#endif  // !defined(PRODUCT)
+}
+
 ISOLATE_UNIT_TEST_CASE(RegenerateAllocStubs) {
   const char* kScriptChars =
       "class A {\n"
@@ -676,10 +676,12 @@ char* Dart::Cleanup() {
 
 Isolate* Dart::CreateIsolate(const char* name_prefix,
                              const Dart_IsolateFlags& api_flags,
-                             IsolateGroup* isolate_group) {
+                             IsolateGroup* isolate_group,
+                             bool is_idle) {
   // Create a new isolate.
   Isolate* isolate =
-      Isolate::InitIsolate(name_prefix, isolate_group, api_flags);
+      Isolate::InitIsolate(name_prefix, isolate_group, api_flags,
+                           /*is_vm_isolate=*/false, is_idle);
   return isolate;
 }
 
@@ -944,10 +946,13 @@ ErrorPtr Dart::InitializeIsolate(const uint8_t* snapshot_data,
   }
 #endif  // !defined(PRODUCT)
 
-  ServiceIsolate::SendIsolateStartupMessage();
+  // Idle isolates are announced once Isolate.spawn claims them.
+  if (!I->is_idle()) {
+    ServiceIsolate::SendIsolateStartupMessage();
 #if !defined(PRODUCT)
-  I->debugger()->NotifyIsolateCreated();
+    I->debugger()->NotifyIsolateCreated();
 #endif
+  }
 
   // Create tag table.
   I->set_tag_table(GrowableObjectArray::Handle(GrowableObjectArray::New()));
@@ -49,7 +49,8 @@ class Dart : public AllStatic {
 
   static Isolate* CreateIsolate(const char* name_prefix,
                                 const Dart_IsolateFlags& api_flags,
-                                IsolateGroup* isolate_group);
+                                IsolateGroup* isolate_group,
+                                bool is_idle = false);
 
   // Initialize an isolate, either from a snapshot, from a Kernel binary, or
   // from SDK library sources.  If the snapshot_buffer is non-NULL,
@@ -1234,11 +1234,12 @@ static Dart_Isolate CreateIsolate(IsolateGroup* group,
                                   bool is_new_group,
                                   const char* name,
                                   void* isolate_data,
-                                  char** error) {
+                                  char** error,
+                                  bool is_idle = false) {
   CHECK_NO_ISOLATE(Isolate::Current());
 
   auto source = group->source();
-  Isolate* I = Dart::CreateIsolate(name, source->flags, group);
+  Isolate* I = Dart::CreateIsolate(name, source->flags, group, is_idle);
   if (I == NULL) {
     if (error != NULL) {
       *error = Utils::StrDup("Isolate creation failed");
@@ -1310,7 +1311,8 @@ static bool IsServiceOrKernelIsolateName(const char* name) {
 
 Isolate* CreateWithinExistingIsolateGroupAOT(IsolateGroup* group,
                                              const char* name,
-                                             char** error) {
+                                             char** error,
+                                             bool is_idle) {
 #if defined(DART_PRECOMPILED_RUNTIME)
   API_TIMELINE_DURATION(Thread::Current());
   CHECK_NO_ISOLATE(Isolate::Current());
@@ -1319,7 +1321,7 @@ Isolate* CreateWithinExistingIsolateGroupAOT(IsolateGroup* group,
 
   Isolate* isolate = reinterpret_cast<Isolate*>(
       CreateIsolate(spawning_group, /*is_new_group=*/false, name,
-                    /*isolate_data=*/nullptr, error));
+                    /*isolate_data=*/nullptr, error, is_idle));
   if (isolate == nullptr) return nullptr;
 
   auto source = spawning_group->source();
@@ -1333,7 +1335,8 @@ Isolate* CreateWithinExistingIsolateGroupAOT(IsolateGroup* group,
 
 Isolate* CreateWithinExistingIsolateGroup(IsolateGroup* group,
                                           const char* name,
-                                          char** error) {
+                                          char** error,
+                                          bool is_idle) {
 #if !defined(DART_PRECOMPILED_RUNTIME)
   API_TIMELINE_DURATION(Thread::Current());
   CHECK_NO_ISOLATE(Isolate::Current());
@@ -1350,7 +1353,7 @@ Isolate* CreateWithinExistingIsolateGroup(IsolateGroup* group,
 
   Isolate* isolate = reinterpret_cast<Isolate*>(
       CreateIsolate(spawning_group, /*is_new_group=*/false, name,
-                    /*isolate_data=*/nullptr, error));
+                    /*isolate_data=*/nullptr, error, is_idle));
   if (isolate == nullptr) return nullptr;
 
   auto source = spawning_group->source();
@@ -350,12 +350,15 @@ class IsolateGroupSource;
 
 // Creates a new isolate from [source] (which should come from an existing
 // isolate).
+// An idle isolate is not announced to the service, see Isolate::is_idle.
 Isolate* CreateWithinExistingIsolateGroup(IsolateGroup* group,
                                           const char* name,
-                                          char** error);
+                                          char** error,
+                                          bool is_idle = false);
 Isolate* CreateWithinExistingIsolateGroupAOT(IsolateGroup* group,
                                              const char* name,
-                                             char** error);
+                                             char** error,
+                                             bool is_idle = false);
 
 }  // namespace dart.
 
@@ -7464,6 +7464,63 @@ VM_UNIT_TEST_CASE(DartAPI_NewNativePort) {
   EXPECT(Dart_CloseNativePort(port_id2));
 }
 
+static Monitor* native_batch_monitor = new Monitor();
+static intptr_t native_batch_received = 0;
+static intptr_t native_batch_max_size = 0;
+
+static void NativeBatchPort_receive(Dart_Port dest_port_id,
+                                    intptr_t num_messages,
+                                    Dart_CObject** messages) {
+  MonitorLocker ml(native_batch_monitor);
+  if (num_messages > native_batch_max_size) {
+    native_batch_max_size = num_messages;
+  }
+  for (intptr_t i = 0; i < num_messages; i++) {
+    EXPECT_EQ(Dart_CObject_kInt32, messages[i]->type);
+    // Messages arrive in the order they were posted.
+    EXPECT_EQ(native_batch_received, messages[i]->value.as_int32);
+    native_batch_received++;
+  }
+  ml.Notify();
+}
+
+VM_UNIT_TEST_CASE(DartAPI_NewNativeBatchPort) {
+  EXPECT_EQ(ILLEGAL_PORT, Dart_NewNativeBatchPort("Foo", NULL, 4));
+  EXPECT_EQ(ILLEGAL_PORT,
+            Dart_NewNativeBatchPort("Foo", NativeBatchPort_receive, 0));
+
+  native_batch_received = 0;
+  native_batch_max_size = 0;
+  const intptr_t kMaxBatchSize = 4;
+  Dart_Port port_id =
+      Dart_NewNativeBatchPort("Batch", NativeBatchPort_receive, kMaxBatchSize);
+  EXPECT(port_id != ILLEGAL_PORT);
+
+  const intptr_t kNumMessages = 20;
+  Dart_CObject objects[kNumMessages];
+  Dart_CObject* messages[kNumMessages];
+  for (intptr_t i = 0; i < kNumMessages; i++) {
+    objects[i].type = Dart_CObject_kInt32;
+    objects[i].value.as_int32 = i;
+    messages[i] = &objects[i];
+  }
+  EXPECT(Dart_PostCObjectBatch(port_id, kNumMessages / 2, messages));
+  EXPECT(Dart_PostCObjectBatch(port_id, kNumMessages / 2,
+                               &messages[kNumMessages / 2]));
+  EXPECT(!Dart_PostCObjectBatch(ILLEGAL_PORT, kNumMessages, messages));
+
+  {
+    MonitorLocker ml(native_batch_monitor);
+    while (native_batch_received < kNumMessages) {
+      ml.Wait();
+    }
+  }
+  EXPECT_EQ(kNumMessages, native_batch_received);
+  EXPECT(native_batch_max_size <= kMaxBatchSize);
+
+  EXPECT(Dart_CloseNativePort(port_id));
+}
+
 void NewNativePort_sendInteger123(Dart_Port dest_port_id,
                                   Dart_CObject* message) {
   // Gets a send port message.
@@ -662,14 +662,12 @@ Dart_CObject* ApiMessageReader::ReadInternalVMObject(intptr_t class_id,
 
     case kGrowableObjectArrayCid: {
       // A GrowableObjectArray is serialized as its type arguments and
-      // length followed by its backing store. The backing store is an
-      // array with a length which might be longer than the length of
-      // the GrowableObjectArray.
+      // length followed by its elements.
       Dart_CObject* value = GetBackRef(object_id);
       ASSERT(value == NULL);
       // Allocate an empty array for the GrowableObjectArray which
-      // will be updated to point to the content when the backing
-      // store has been deserialized.
+      // will be updated to point to the elements when the length has
+      // been read, as the elements might refer back to it.
       value = AllocateDartCObjectArray(0);
       AddBackRef(object_id, value, kIsDeserialized);
 
@@ -685,12 +683,13 @@ Dart_CObject* ApiMessageReader::ReadInternalVMObject(intptr_t class_id,
       // Read the length field.
       intptr_t len = ReadSmiValue();
 
-      // Read the content of the GrowableObjectArray.
-      Dart_CObject* content = ReadObjectRef();
-      ASSERT(content->type == Dart_CObject_kArray);
-      // Make the empty array allocated point to the backing store content.
+      // Read the elements of the GrowableObjectArray.
+      Dart_CObject* content = AllocateDartCObjectArray(len);
       value->value.as_array.length = len;
       value->value.as_array.values = content->value.as_array.values;
+      for (intptr_t i = 0; i < len; i++) {
+        value->value.as_array.values[i] = ReadObjectRef();
+      }
       return value;
     }
     default:
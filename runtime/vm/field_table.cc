@@ -36,8 +36,11 @@ void FieldTable::Register(const Field& field) {
   ASSERT(Thread::Current()->IsMutatorThread());
   if (free_head_ < 0) {
     if (top_ == capacity_) {
-      const intptr_t new_capacity = capacity_ + kCapacityIncrement;
-      Grow(new_capacity);
+      // Old tables are only freed by the GC, so the table grows by a factor
+      // to keep the memory held by them linear in the number of fields.
+      const intptr_t increment =
+          Utils::Maximum<intptr_t>(kCapacityIncrement, capacity_ / 2);
+      Grow(capacity_ + increment);
     }
 
     ASSERT(top_ < capacity_);
@@ -103,12 +106,15 @@ void FieldTable::Grow(intptr_t new_capacity) {
 
 FieldTable* FieldTable::Clone() {
   FieldTable* clone = new FieldTable();
+  // Every isolate of a group has a clone, which only needs room for the
+  // fields registered so far.
+  const intptr_t capacity = top_ > 0 ? top_ : capacity_;
   auto new_table = static_cast<InstancePtr*>(
-      malloc(capacity_ * sizeof(InstancePtr)));  // NOLINT
+      malloc(capacity * sizeof(InstancePtr)));  // NOLINT
   memmove(new_table, table_, top_ * sizeof(InstancePtr));
   ASSERT(clone->table_ == nullptr);
   clone->table_ = new_table;
-  clone->capacity_ = capacity_;
+  clone->capacity_ = capacity;
   clone->top_ = top_;
   return clone;
 }
@@ -138,6 +138,9 @@ constexpr bool kDartUseBackgroundCompilation = true;
   P(idle_duration_micros, int, 500 * kMicrosecondsPerMillisecond,              \
     "Allow idle tasks to run for this long.")                                  \
   P(interpret_irregexp, bool, false, "Use irregexp bytecode interpreter")      \
+  P(kernel_loader_tasks, int, 2,                                               \
+    "The number of tasks to use for decoding script sources when loading "     \
+    "kernel.")                                                                 \
   P(link_natives_lazily, bool, false, "Link native calls lazily")              \
   R(log_marker_tasks, false, bool, false,                                      \
     "Log debugging information for old gen GC marking tasks.")                 \
@@ -195,6 +198,11 @@ constexpr bool kDartUseBackgroundCompilation = true;
     "Serialize function objects for all code objects even if not otherwise "   \
     "needed in the precompiled runtime.")                                      \
   P(enable_isolate_groups, bool, false, "Enable isolate group support.")       \
+  P(copy_isolate_group_messages, bool, true,                                   \
+    "Copy messages sent to isolates in the same group from heap to heap.")     \
+  P(isolate_pool_size, int, 0,                                                 \
+    "Number of idle isolates an isolate group keeps ready for "                \
+    "Isolate.spawn.")                                                          \
   P(show_invisible_frames, bool, false,                                        \
     "Show invisible frames in stack traces.")                                  \
   R(support_il_printer, false, bool, true, "Support the IL printer.")          \
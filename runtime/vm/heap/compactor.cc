@@ -137,6 +137,9 @@ class CompactorTask : public ThreadPool::Task {
         free_current_(0),
         free_end_(0) {}
 
+  // The mutator waits for the helpers of the compaction.
+  virtual Priority priority() const { return kHighPriority; }
+
   void Run();
   void RunEnteredIsolateGroup();
 
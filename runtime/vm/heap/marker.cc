@@ -515,6 +515,9 @@ class ParallelMarkTask : public ThreadPool::Task {
         visitor_(visitor),
         num_busy_(num_busy) {}
 
+  // The mutator waits for the helpers of the final marking.
+  virtual Priority priority() const { return kHighPriority; }
+
   virtual void Run() {
     bool result = Thread::EnterIsolateGroupAsHelper(
         isolate_group_, Thread::kMarkerTask, /*bypass_safepoint=*/true);
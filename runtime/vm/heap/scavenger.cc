@@ -476,6 +476,9 @@ class ParallelScavengerTask : public ThreadPool::Task {
         visitor_(visitor),
         num_busy_(num_busy) {}
 
+  // The mutator waits for the helpers of the scavenge.
+  virtual Priority priority() const { return kHighPriority; }
+
   virtual void Run() {
     bool result = Thread::EnterIsolateGroupAsHelper(
         isolate_group_, Thread::kScavengerTask, /*bypass_safepoint=*/true);
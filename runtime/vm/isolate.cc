@@ -430,6 +430,42 @@ bool IsolateGroup::ContainsOnlyOneIsolate() {
   return isolate_count_ == 0;
 }
 
+Isolate* IsolateGroup::TakeIdleIsolate() {
+  SafepointWriteRwLocker ml(Thread::Current(), isolates_lock_.get());
+  if (idle_isolates_.is_empty()) {
+    return nullptr;
+  }
+  return idle_isolates_.RemoveLast();
+}
+
+bool IsolateGroup::AddIdleIsolate(Isolate* isolate) {
+  SafepointWriteRwLocker ml(Thread::Current(), isolates_lock_.get());
+  ASSERT(isolates_.ContainsForDebugging(isolate));
+  if (!keeps_idle_isolates_ ||
+      idle_isolates_.length() >= FLAG_isolate_pool_size) {
+    return false;
+  }
+  idle_isolates_.Add(isolate);
+  return true;
+}
+
+intptr_t IsolateGroup::IdleIsolateCount() {
+  SafepointReadRwLocker ml(Thread::Current(), isolates_lock_.get());
+  return idle_isolates_.length();
+}
+
+void IsolateGroup::TakeIdleIsolatesIfUnused(
+    MallocGrowableArray<Isolate*>* isolates) {
+  SafepointWriteRwLocker ml(Thread::Current(), isolates_lock_.get());
+  if (isolate_count_ > idle_isolates_.length()) {
+    return;
+  }
+  keeps_idle_isolates_ = false;
+  while (!idle_isolates_.is_empty()) {
+    isolates->Add(idle_isolates_.RemoveLast());
+  }
+}
+
 void IsolateGroup::RunWithLockedGroup(std::function<void()> fun) {
   SafepointWriteRwLocker ml(Thread::Current(), isolates_lock_.get());
   fun();
@@ -747,7 +783,9 @@ void IsolateGroup::PrintToJSONObject(JSONObject* jsobj, bool ref) {
     JSONArray isolate_array(jsobj, "isolates");
     for (auto it = isolates_.Begin(); it != isolates_.End(); ++it) {
       Isolate* isolate = *it;
-      isolate_array.AddValue(isolate, /*ref=*/true);
+      if (!isolate->is_idle()) {
+        isolate_array.AddValue(isolate, /*ref=*/true);
+      }
     }
   }
 }
@@ -1714,7 +1752,8 @@ Isolate::~Isolate() {
   pause_loop_monitor_ = nullptr;
 #endif  // !defined(PRODUCT)
 
-  free(name_);
+  free(name_.load());
+  free(previous_name_);
   delete field_table_;
 #if defined(USING_SIMULATOR)
   delete simulator_;
@@ -1768,8 +1807,10 @@ void Isolate::InitVM() {
 Isolate* Isolate::InitIsolate(const char* name_prefix,
                               IsolateGroup* isolate_group,
                               const Dart_IsolateFlags& api_flags,
-                              bool is_vm_isolate) {
+                              bool is_vm_isolate,
+                              bool is_idle) {
   Isolate* result = new Isolate(isolate_group, api_flags);
+  result->set_is_idle(is_idle);
   result->BuildName(name_prefix);
   if (!is_vm_isolate) {
     // vm isolate object store is initialized later, after null instance
@@ -1909,8 +1950,9 @@ void Isolate::ScheduleInterrupts(uword interrupt_bits) {
 }
 
 void Isolate::set_name(const char* name) {
-  free(name_);
-  name_ = Utils::StrDup(name);
+  ASSERT(previous_name_ == nullptr);
+  previous_name_ = name_.load();
+  name_.store(Utils::StrDup(name));
 }
 
 int64_t IsolateGroup::UptimeMicros() const {
@@ -1960,11 +2002,11 @@ ErrorPtr Isolate::PausePostRequest() {
 }
 
 void Isolate::BuildName(const char* name_prefix) {
-  ASSERT(name_ == nullptr);
+  ASSERT(name_.load() == nullptr);
   if (name_prefix == nullptr) {
-    name_ = OS::SCreate(nullptr, "isolate-%" Pd64 "", main_port());
+    name_.store(OS::SCreate(nullptr, "isolate-%" Pd64 "", main_port()));
   } else {
-    name_ = Utils::StrDup(name_prefix);
+    name_.store(Utils::StrDup(name_prefix));
   }
 }
 
@@ -2616,7 +2658,9 @@ void Isolate::Shutdown() {
   {
     StackZone zone(thread);
     HandleScope handle_scope(thread);
-    ServiceIsolate::SendIsolateShutdownMessage();
+    if (!is_idle()) {
+      ServiceIsolate::SendIsolateShutdownMessage();
+    }
     KernelIsolate::NotifyAboutIsolateShutdown(this);
 #if !defined(PRODUCT)
     debugger()->Shutdown();
@@ -2711,6 +2755,14 @@ void Isolate::LowLevelCleanup(Isolate* isolate) {
       Dart::thread_pool()->Run<ShutdownGroupTask>(isolate_group);
     }
   } else {
+    // Idle isolates do not keep the group alive. The last of them to be shut
+    // down shuts the group down.
+    MallocGrowableArray<Isolate*> idle_isolates;
+    isolate_group->TakeIdleIsolatesIfUnused(&idle_isolates);
+    for (intptr_t i = 0; i < idle_isolates.length(); i++) {
+      Dart::ShutdownIsolate(idle_isolates[i]);
+    }
+
     if (FLAG_enable_isolate_groups) {
       // TODO(dartbug.com/36097): An isolate just died. A significant amount of
       // memory might have become unreachable. We should evaluate how to best
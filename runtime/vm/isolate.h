@@ -361,6 +361,20 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
 
   bool ContainsOnlyOneIsolate();
 
+  // Isolates of this group that have been created ahead of time, so that
+  // Isolate.spawn can start them right away (see --isolate_pool_size). They
+  // are registered with the group, but have never run.
+  //
+  // Returns an idle isolate, or nullptr if there is none.
+  Isolate* TakeIdleIsolate();
+  // Returns false if the group keeps enough idle isolates already, or no
+  // longer keeps any, in which case the caller has to shut [isolate] down.
+  bool AddIdleIsolate(Isolate* isolate);
+  intptr_t IdleIsolateCount();
+  // Once all isolates of the group are idle, moves them to [isolates], to be
+  // shut down by the caller, and stops keeping idle isolates.
+  void TakeIdleIsolatesIfUnused(MallocGrowableArray<Isolate*>* isolates);
+
   void RunWithLockedGroup(std::function<void()> fun);
 
   Monitor* threads_lock() const;
@@ -664,6 +678,8 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   std::unique_ptr<SafepointRwLock> isolates_lock_;
   IntrusiveDList<Isolate> isolates_;
   intptr_t isolate_count_ = 0;
+  MallocGrowableArray<Isolate*> idle_isolates_;
+  bool keeps_idle_isolates_ = true;
   bool initial_spawn_successful_ = false;
   Dart_LibraryTagHandler library_tag_handler_ = nullptr;
   Dart_DeferredLoadHandler deferred_load_handler_ = nullptr;
@@ -733,7 +749,8 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
 };
 
 // When an isolate sends-and-exits this class represent things that it passed
-// to the beneficiary.
+// to the beneficiary. It is also used for messages that are copied directly
+// into the heap of an isolate in the same group.
 class Bequest {
  public:
   Bequest(PersistentHandle* handle, Dart_Port beneficiary)
@@ -865,9 +882,18 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
 
   Thread* mutator_thread() const;
 
-  const char* name() const { return name_; }
+  const char* name() const { return name_.load(); }
+  // Renames an idle isolate when Isolate.spawn claims it. The service, the
+  // timeline and the profiler may still use the previous name, so it is
+  // only freed with the isolate. May be called once.
   void set_name(const char* name);
 
+  // Whether the isolate was created ahead of time for --isolate_pool_size and
+  // has not been claimed by Isolate.spawn yet. Idle isolates are not
+  // announced to the service and are not listed by it.
+  bool is_idle() const { return is_idle_; }
+  void set_is_idle(bool value) { is_idle_ = value; }
+
   int64_t UptimeMicros() const;
 
   Dart_Port main_port() const { return main_port_; }
@@ -1386,7 +1412,8 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
   friend class IsolateKillerVisitor;  // Kill().
   friend Isolate* CreateWithinExistingIsolateGroup(IsolateGroup* g,
                                                    const char* n,
-                                                   char** e);
+                                                   char** e,
+                                                   bool i);
 
   Isolate(IsolateGroup* group, const Dart_IsolateFlags& api_flags);
 
@@ -1394,7 +1421,8 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
   static Isolate* InitIsolate(const char* name_prefix,
                               IsolateGroup* isolate_group,
                               const Dart_IsolateFlags& api_flags,
-                              bool is_vm_isolate = false);
+                              bool is_vm_isolate = false,
+                              bool is_idle = false);
 
   // The isolate_creation_monitor_ should be held when calling Kill().
   void KillLocked(LibMsgId msg_id);
@@ -1561,7 +1589,9 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
   // All other fields go here.
   int64_t start_time_micros_;
   Dart_MessageNotifyCallback message_notify_callback_ = nullptr;
-  char* name_ = nullptr;
+  AcqRelAtomic<char*> name_ = {nullptr};
+  char* previous_name_ = nullptr;
+  RelaxedAtomic<bool> is_idle_ = {false};
   Dart_Port main_port_ = 0;
   // Isolates created by Isolate.spawn have the same origin id.
   Dart_Port origin_id_ = 0;
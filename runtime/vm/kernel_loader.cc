@@ -9,13 +9,17 @@
 
 #include <memory>
 
+#include "platform/atomic.h"
+#include "platform/unicode.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
 #include "vm/compiler/frontend/constant_reader.h"
 #include "vm/compiler/frontend/kernel_translation_helper.h"
+#include "vm/dart.h"
 #include "vm/dart_api_impl.h"
 #include "vm/flags.h"
 #include "vm/heap/heap.h"
 #include "vm/kernel_binary.h"
+#include "vm/lockers.h"
 #include "vm/longjump.h"
 #include "vm/object_store.h"
 #include "vm/parser.h"
@@ -23,6 +27,7 @@
 #include "vm/service_isolate.h"
 #include "vm/symbols.h"
 #include "vm/thread.h"
+#include "vm/thread_pool.h"
 
 namespace dart {
 namespace kernel {
@@ -182,6 +187,209 @@ void ClassIndex::Init(intptr_t class_offset, intptr_t class_size) {
       class_offset + class_size - 4 - (procedure_count_ + 1) * 4;
 }
 
+// The source and line starts of a script, decoded from the kernel binary on
+// a helper thread. Decoding does not touch the Dart heap, so the mutator only
+// has to copy the results into new objects.
+class DecodedScriptSource {
+ public:
+  DecodedScriptSource()
+      : valid_(false),
+        type_(Utf8::kLatin1),
+        length_(0),
+        characters_(nullptr),
+        line_start_count_(0),
+        max_line_start_delta_(0),
+        line_starts_(nullptr) {}
+
+  ~DecodedScriptSource() {
+    free(characters_);
+    free(line_starts_);
+  }
+
+  void Decode(const uint8_t* kernel_data,
+              intptr_t kernel_data_size,
+              intptr_t source_info_offset) {
+    Reader reader(kernel_data, kernel_data_size);
+    reader.set_offset(source_info_offset);
+    const intptr_t uri_size = reader.ReadUInt();
+    reader.set_offset(reader.offset() + uri_size);
+    const intptr_t source_size = reader.ReadUInt();
+    const uint8_t* source =
+        (source_size == 0) ? nullptr : reader.BufferAt(reader.offset());
+    reader.set_offset(reader.offset() + source_size);
+
+    // Line starts are delta encoded.
+    line_start_count_ = reader.ReadUInt();
+    if (line_start_count_ > 0) {
+      line_starts_ = reinterpret_cast<int32_t*>(
+          malloc(line_start_count_ * sizeof(int32_t)));
+      for (intptr_t i = 0; i < line_start_count_; ++i) {
+        const intptr_t delta = reader.ReadUInt();
+        if (delta > max_line_start_delta_) {
+          max_line_start_delta_ = delta;
+        }
+        line_starts_[i] = static_cast<int32_t>(delta);
+      }
+    }
+
+    if (source_size == 0) {
+      valid_ = true;
+      return;
+    }
+    length_ = Utf8::CodeUnitCount(source, source_size, &type_);
+    if (type_ == Utf8::kLatin1) {
+      uint8_t* latin1 = reinterpret_cast<uint8_t*>(malloc(length_));
+      characters_ = latin1;
+      valid_ = Utf8::DecodeToLatin1(source, source_size, latin1, length_);
+    } else {
+      uint16_t* utf16 =
+          reinterpret_cast<uint16_t*>(malloc(length_ * sizeof(uint16_t)));
+      characters_ = utf16;
+      valid_ = Utf8::DecodeToUTF16(source, source_size, utf16, length_);
+    }
+  }
+
+  // Invalid sources are loaded again on the mutator, which reports the error.
+  bool is_valid() const { return valid_; }
+
+  StringPtr NewSource() const {
+    ASSERT(is_valid());
+    if (length_ == 0) {
+      return Symbols::Empty().raw();
+    }
+    if (type_ == Utf8::kLatin1) {
+      return OneByteString::New(reinterpret_cast<const uint8_t*>(characters_),
+                                length_, Heap::kOld);
+    }
+    return TwoByteString::New(reinterpret_cast<const uint16_t*>(characters_),
+                              length_, Heap::kOld);
+  }
+
+  // Uses the same representation as Reader::ReadLineStartsData.
+  TypedDataPtr NewLineStarts() const {
+    ASSERT(is_valid());
+    intptr_t cid = kTypedDataInt8ArrayCid;
+    if (max_line_start_delta_ > kMaxInt16) {
+      cid = kTypedDataInt32ArrayCid;
+    } else if (max_line_start_delta_ > kMaxInt8) {
+      cid = kTypedDataInt16ArrayCid;
+    }
+    const TypedData& line_starts = TypedData::Handle(
+        TypedData::New(cid, line_start_count_, Heap::kOld));
+    for (intptr_t i = 0; i < line_start_count_; ++i) {
+      if (cid == kTypedDataInt8ArrayCid) {
+        line_starts.SetInt8(i, static_cast<int8_t>(line_starts_[i]));
+      } else if (cid == kTypedDataInt16ArrayCid) {
+        line_starts.SetInt16(i << 1, static_cast<int16_t>(line_starts_[i]));
+      } else {
+        line_starts.SetInt32(i << 2, line_starts_[i]);
+      }
+    }
+    return line_starts.raw();
+  }
+
+ private:
+  bool valid_;
+  Utf8::Type type_;
+  intptr_t length_;
+  void* characters_;
+  intptr_t line_start_count_;
+  intptr_t max_line_start_delta_;
+  int32_t* line_starts_;
+
+  DISALLOW_COPY_AND_ASSIGN(DecodedScriptSource);
+};
+
+// Decodes script sources on the mutator and [num_tasks] - 1 helper threads.
+// The helper threads do not enter the isolate group, as they only read the
+// kernel binary, which is not part of the Dart heap.
+class ScriptSourceDecoder {
+ public:
+  ScriptSourceDecoder(const uint8_t* kernel_data,
+                      intptr_t kernel_data_size,
+                      const intptr_t* source_info_offsets,
+                      DecodedScriptSource* sources,
+                      intptr_t count)
+      : kernel_data_(kernel_data),
+        kernel_data_size_(kernel_data_size),
+        source_info_offsets_(source_info_offsets),
+        sources_(sources),
+        count_(count),
+        next_index_(0),
+        pending_tasks_(0) {}
+
+  void Run(Thread* thread, intptr_t num_tasks);
+
+  void DecodeAll() {
+    for (;;) {
+      const intptr_t index = next_index_.fetch_add(1);
+      if (index >= count_) {
+        return;
+      }
+      sources_[index].Decode(kernel_data_, kernel_data_size_,
+                             source_info_offsets_[index]);
+    }
+  }
+
+  void TaskDone() {
+    MonitorLocker ml(&monitor_);
+    pending_tasks_--;
+    ml.Notify();
+  }
+
+ private:
+  const uint8_t* kernel_data_;
+  intptr_t kernel_data_size_;
+  const intptr_t* source_info_offsets_;
+  DecodedScriptSource* sources_;
+  intptr_t count_;
+  RelaxedAtomic<intptr_t> next_index_;
+  Monitor monitor_;
+  intptr_t pending_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScriptSourceDecoder);
+};
+
+class ScriptSourceDecoderTask : public ThreadPool::Task {
+ public:
+  explicit ScriptSourceDecoderTask(ScriptSourceDecoder* decoder)
+      : decoder_(decoder) {}
+
+  // The mutator waits for the decoding.
+  virtual Priority priority() const { return kHighPriority; }
+
+  virtual void Run() {
+    decoder_->DecodeAll();
+    decoder_->TaskDone();
+  }
+
+ private:
+  ScriptSourceDecoder* decoder_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScriptSourceDecoderTask);
+};
+
+void ScriptSourceDecoder::Run(Thread* thread, intptr_t num_tasks) {
+  for (intptr_t i = 1; i < num_tasks; i++) {
+    {
+      MonitorLocker ml(&monitor_);
+      pending_tasks_++;
+    }
+    if (!Dart::thread_pool()->Run<ScriptSourceDecoderTask>(this)) {
+      MonitorLocker ml(&monitor_);
+      pending_tasks_--;
+      break;
+    }
+  }
+  // The mutator decodes as well. Any scripts left by helper threads which
+  // did not start are decoded here.
+  DecodeAll();
+  MonitorLocker ml(&monitor_);
+  while (pending_tasks_ > 0) {
+    ml.WaitWithSafepointCheck(thread);
+  }
+}
+
 using UriToSourceTable = DirectChainedHashMap<UriToSourceTableTrait>;
 
 KernelLoader::KernelLoader(Program* program,
@@ -445,10 +653,20 @@ void KernelLoader::InitializeFields(UriToSourceTable* uri_to_source_table) {
 
   H.InitFromKernelProgramInfo(kernel_program_info_);
 
-  Script& script = Script::Handle(Z);
-  for (intptr_t index = 0; index < source_table_size; ++index) {
-    script = LoadScriptAt(index, uri_to_source_table);
-    scripts.SetAt(index, script);
+  {
+    TIMELINE_DURATION(thread_, Isolate, "LoadScripts");
+    // Sources from the uri to source table take precedence over the ones
+    // in the kernel binary, so only decode the latter if there is none.
+    std::unique_ptr<DecodedScriptSource[]> decoded;
+    if (uri_to_source_table == nullptr) {
+      decoded.reset(DecodeScriptSources(source_table_size));
+    }
+    Script& script = Script::Handle(Z);
+    for (intptr_t index = 0; index < source_table_size; ++index) {
+      script = LoadScriptAt(index, uri_to_source_table,
+                            decoded == nullptr ? nullptr : &decoded[index]);
+      scripts.SetAt(index, script);
+    }
   }
 
   bytecode_metadata_helper_.ReadBytecodeComponent();
@@ -747,6 +965,13 @@ ObjectPtr KernelLoader::LoadProgram(bool process_pending_classes) {
     if (!bytecode_metadata_helper_.ReadLibraries()) {
       // Note that `problemsAsJson` on Component is implicitly skipped.
       const intptr_t length = program_->library_count();
+      TIMELINE_DURATION(thread_, Isolate, "LoadLibraries");
+#if defined(SUPPORT_TIMELINE)
+      if (tbes.enabled()) {
+        tbes.SetNumArguments(1);
+        tbes.FormatArgument(0, "libraryCount", "%" Pd, length);
+      }
+#endif  // defined(SUPPORT_TIMELINE)
       for (intptr_t i = 0; i < length; i++) {
         LoadLibrary(i);
       }
@@ -769,9 +994,12 @@ ObjectPtr KernelLoader::LoadProgram(bool process_pending_classes) {
         Array::Handle(Z, HashTables::New<KernelConstantsMap>(16, Heap::kOld));
     kernel_program_info_.set_constants(array);
     H.SetConstants(array);  // for caching
-    AnnotateNativeProcedures();
-    LoadNativeExtensionLibraries();
-    EvaluateDelayedPragmas();
+    {
+      TIMELINE_DURATION(thread_, Isolate, "ProcessNativesAndPragmas");
+      AnnotateNativeProcedures();
+      LoadNativeExtensionLibraries();
+      EvaluateDelayedPragmas();
+    }
 
     NameIndex main = program_->main_method();
     if (main != -1) {
@@ -967,6 +1195,9 @@ void KernelLoader::ReadInferredType(const Field& field,
       inferred_type_metadata_helper_.GetInferredType(kernel_offset,
                                                      /*read_constant=*/false);
   if (type.IsTrivial()) {
+    if (FLAG_precompiled_mode) {
+      ReadUnboxingInfoFromStaticType(field);
+    }
     return;
   }
   field.set_guarded_cid(type.cid);
@@ -987,6 +1218,35 @@ void KernelLoader::ReadInferredType(const Field& field,
   }
 }
 
+// With sound null safety the declared type of an instance field bounds the
+// values which can be stored into it. This allows non-nullable 'double' and
+// 'int' fields to be laid out unboxed when the class is finalized even if no
+// inferred type is available for them (e.g. TFA did not annotate the field).
+void KernelLoader::ReadUnboxingInfoFromStaticType(const Field& field) {
+  ASSERT(FLAG_precompiled_mode);
+  if (!I->null_safety() || field.is_static() || field.is_late()) {
+    return;
+  }
+  const AbstractType& type = AbstractType::Handle(Z, field.type());
+  if (!type.IsNonNullable()) {
+    return;
+  }
+  if (type.IsDoubleType()) {
+    if (!FlowGraphCompiler::SupportsUnboxedDoubles()) {
+      return;
+    }
+    field.set_guarded_cid(kDoubleCid);
+  } else if (type.IsIntType()) {
+    field.set_guarded_cid(kDynamicCid);
+    field.set_is_non_nullable_integer(true);
+  } else {
+    return;
+  }
+  field.set_is_nullable(false);
+  field.set_guarded_list_length(Field::kNoFixedLength);
+  field.set_is_unboxing_candidate(true);
+}
+
 void KernelLoader::CheckForInitializer(const Field& field) {
   if (helper_.PeekTag() == kSomething) {
     field.set_has_initializer(true);
@@ -2133,8 +2393,45 @@ const Object& KernelLoader::ClassForScriptAt(const Class& klass,
   return klass;
 }
 
+DecodedScriptSource* KernelLoader::DecodeScriptSources(
+    intptr_t source_table_size) {
+  // Below this size the helper threads would not pay off.
+  const intptr_t kMinParallelSourceSize = 256 * KB;
+
+  const intptr_t num_tasks =
+      Utils::Minimum<intptr_t>(FLAG_kernel_loader_tasks, source_table_size);
+  if (num_tasks <= 1) {
+    return nullptr;
+  }
+
+  std::unique_ptr<intptr_t[]> source_info_offsets(
+      new intptr_t[source_table_size]);
+  Reader reader(program_->kernel_data(), program_->kernel_data_size());
+  intptr_t total_source_size = 0;
+  for (intptr_t index = 0; index < source_table_size; ++index) {
+    const intptr_t offset = helper_.GetOffsetForSourceInfo(index);
+    source_info_offsets[index] = offset;
+    reader.set_offset(offset);
+    reader.set_offset(reader.offset() + reader.ReadUInt());  // skip uri.
+    total_source_size += reader.ReadUInt();  // read source List<byte> size.
+  }
+  if (total_source_size < kMinParallelSourceSize) {
+    return nullptr;
+  }
+
+  TIMELINE_DURATION(thread_, Isolate, "DecodeScriptSources");
+  DecodedScriptSource* sources = new DecodedScriptSource[source_table_size];
+  ScriptSourceDecoder decoder(program_->kernel_data(),
+                              program_->kernel_data_size(),
+                              source_info_offsets.get(), sources,
+                              source_table_size);
+  decoder.Run(thread_, num_tasks);
+  return sources;
+}
+
 ScriptPtr KernelLoader::LoadScriptAt(intptr_t index,
-                                     UriToSourceTable* uri_to_source_table) {
+                                     UriToSourceTable* uri_to_source_table,
+                                     const DecodedScriptSource* decoded) {
   const String& uri_string = helper_.SourceTableUriFor(index);
   const String& import_uri_string =
       helper_.SourceTableImportUriFor(index, program_->binary_version());
@@ -2153,8 +2450,14 @@ ScriptPtr KernelLoader::LoadScriptAt(intptr_t index,
   }
 
   if (sources.IsNull() || line_starts.IsNull()) {
-    const String& script_source = helper_.GetSourceFor(index);
-    line_starts = helper_.GetLineStartsFor(index);
+    String& script_source = String::Handle(Z);
+    if ((decoded != nullptr) && decoded->is_valid()) {
+      script_source = decoded->NewSource();
+      line_starts = decoded->NewLineStarts();
+    } else {
+      script_source = helper_.GetSourceFor(index).raw();
+      line_starts = helper_.GetLineStartsFor(index);
+    }
 
     if (script_source.raw() == Symbols::Empty().raw() &&
         line_starts.Length() == 0 && uri_string.Length() > 0) {
@@ -19,6 +19,7 @@
 namespace dart {
 namespace kernel {
 
+class DecodedScriptSource;
 class KernelLoader;
 
 class BuildingTranslationHelper : public TranslationHelper {
@@ -298,6 +299,7 @@ class KernelLoader : public ValueObject {
                             intptr_t type_parameter_count);
 
   void ReadInferredType(const Field& field, intptr_t kernel_offset);
+  void ReadUnboxingInfoFromStaticType(const Field& field);
   void CheckForInitializer(const Field& field);
 
   void LoadClass(const Library& library,
@@ -320,9 +322,15 @@ class KernelLoader : public ValueObject {
   ArrayPtr MakeFieldsArray();
   ArrayPtr MakeFunctionsArray();
 
+  // Decodes the sources and line starts of all scripts on helper threads.
+  // Returns nullptr if the program is too small to be worth it. Libraries and
+  // classes are still loaded on the mutator, as that allocates Dart objects.
+  DecodedScriptSource* DecodeScriptSources(intptr_t source_table_size);
+
   ScriptPtr LoadScriptAt(
       intptr_t index,
-      DirectChainedHashMap<UriToSourceTableTrait>* uri_to_source_table);
+      DirectChainedHashMap<UriToSourceTableTrait>* uri_to_source_table,
+      const DecodedScriptSource* decoded);
 
   // If klass's script is not the script at the uri index, return a PatchClass
   // for klass whose script corresponds to the uri index.
@@ -0,0 +1,185 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/kernel_loader.h"
+#include "platform/assert.h"
+#include "platform/text_buffer.h"
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/flags.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+// Appends [count] copies of [line], which is [code_units] UTF-16 code units
+// long without the line terminator, and records where each line starts.
+static void AddLines(TextBuffer* source,
+                     MallocGrowableArray<intptr_t>* line_starts,
+                     intptr_t* offset,
+                     const char* line,
+                     intptr_t code_units,
+                     intptr_t count) {
+  for (intptr_t i = 0; i < count; i++) {
+    line_starts->Add(*offset);
+    source->AddString(line);
+    source->AddChar('\n');
+    *offset += code_units + 1;
+  }
+}
+
+// Checks that [url] was loaded with [expected_source], and that every line
+// starts where the script's line starts say it does.
+static void CheckScript(Thread* thread,
+                        const char* url,
+                        const char* expected_source,
+                        const MallocGrowableArray<intptr_t>& line_starts,
+                        bool expect_one_byte) {
+  const String& url_string = String::Handle(String::New(url));
+  const Library& lib =
+      Library::Handle(Library::LookupLibrary(thread, url_string));
+  EXPECT(!lib.IsNull());
+  const Script& script = Script::Handle(
+      lib.LookupScript(url_string, /*useResolvedUri=*/true));
+  EXPECT(!script.IsNull());
+  const String& source = String::Handle(script.Source());
+  EXPECT_EQ(expect_one_byte, source.IsOneByteString());
+  EXPECT(source.Equals(String::Handle(String::New(expected_source))));
+  for (intptr_t i = 0; i < line_starts.length(); i++) {
+    intptr_t line = -1;
+    intptr_t column = -1;
+    EXPECT(script.GetTokenLocationUsingLineStarts(
+        TokenPosition(line_starts[i]), &line, &column));
+    EXPECT_EQ(i + 1, line);
+    EXPECT_EQ(1, column);
+  }
+}
+
+// Loads scripts that are large enough to have their sources decoded on
+// helper threads. The main script is Latin-1 with 8 bit line starts, and the
+// library needs a two byte string and 32 bit line starts.
+TEST_CASE(KernelLoader_ParallelScriptSourceDecoding) {
+  SetFlagScope<int> sfs(&FLAG_kernel_loader_tasks, 4);
+
+  const char* kLibUrl = "file:///decoded_lib.dart";
+  TextBuffer main_source(1024);
+  MallocGrowableArray<intptr_t> main_line_starts;
+  intptr_t offset = 0;
+  AddLines(&main_source, &main_line_starts, &offset,
+           "import 'decoded_lib.dart';", 26, 1);
+  AddLines(&main_source, &main_line_starts, &offset, "main() => libMain();",
+           20, 1);
+  // 3500 lines of 57 UTF-8 bytes.
+  AddLines(&main_source, &main_line_starts, &offset,
+           "// caf\xC3\xA9 caf\xC3\xA9 caf\xC3\xA9 caf\xC3\xA9 caf\xC3\xA9 "
+           "caf\xC3\xA9 caf\xC3\xA9 caf\xC3\xA9 caf\xC3\xA9",
+           47, 3500);
+
+  TextBuffer lib_source(1024);
+  MallocGrowableArray<intptr_t> lib_line_starts;
+  offset = 0;
+  AddLines(&lib_source, &lib_line_starts, &offset, "libMain() => 42;", 16, 1);
+  // 1000 lines of 43 UTF-8 bytes.
+  AddLines(&lib_source, &lib_line_starts, &offset,
+           "// \xE2\x82\xAC \xE2\x82\xAC \xE2\x82\xAC \xE2\x82\xAC "
+           "\xE2\x82\xAC \xE2\x82\xAC \xE2\x82\xAC \xE2\x82\xAC "
+           "\xE2\x82\xAC \xE2\x82\xAC",
+           22, 1000);
+  // A line that is longer than the largest 16 bit line start delta.
+  TextBuffer long_line(kMaxInt16 + 100);
+  long_line.AddString("//");
+  for (intptr_t i = 0; i < kMaxInt16; i++) {
+    long_line.AddChar('x');
+  }
+  AddLines(&lib_source, &lib_line_starts, &offset, long_line.buffer(),
+           kMaxInt16 + 2, 1);
+  AddLines(&lib_source, &lib_line_starts, &offset, "// The end.", 11, 1);
+  EXPECT_LT(256 * KB, main_source.length() + lib_source.length());
+
+  Dart_SourceFile sourcefiles[] = {
+      {RESOLVED_USER_TEST_URI, main_source.buffer()},
+      {kLibUrl, lib_source.buffer()},
+  };
+  int sourcefiles_count = sizeof(sourcefiles) / sizeof(Dart_SourceFile);
+  Dart_Handle lib =
+      TestCase::LoadTestScriptWithDFE(sourcefiles_count, sourcefiles);
+  EXPECT_VALID(lib);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+  int64_t value = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+  EXPECT_EQ(42, value);
+
+  TransitionNativeToVM transition(thread);
+  CheckScript(thread, RESOLVED_USER_TEST_URI, main_source.buffer(),
+              main_line_starts, /*expect_one_byte=*/true);
+  CheckScript(thread, kLibUrl, lib_source.buffer(), lib_line_starts,
+              /*expect_one_byte=*/false);
+}
+
+#if defined(DART_PRECOMPILER)
+
+static bool IsUnboxedInLayout(const Class& cls, const Field& field) {
+  const UnboxedFieldBitmap bitmap =
+      IsolateGroup::Current()->shared_class_table()->GetUnboxedFieldsMapAt(
+          cls.id());
+  return bitmap.Get(field.HostOffset() / kWordSize);
+}
+
+// Without an inferred type from TFA, the declared type of a field decides
+// whether it is unboxed in AOT, which requires sound null safety.
+TEST_CASE(KernelLoader_UnboxedFieldsFromStaticType) {
+  SetFlagScope<bool> sfs(&FLAG_precompiled_mode, true);
+  const char* kScript =
+      "class A {\n"
+      "  double d = 1.0;\n"
+      "  int i = 2;\n"
+      "  num n = 3;\n"
+      "  static double s = 4.0;\n"
+      "}\n"
+      "main() => new A();\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScript, NULL);
+  EXPECT_VALID(lib);
+
+  TransitionNativeToVM transition(thread);
+  const bool null_safety = thread->isolate()->null_safety();
+  const Library& library = Library::Handle(
+      Library::RawCast(Api::UnwrapHandle(lib)));
+  const Class& cls =
+      Class::Handle(library.LookupClass(String::Handle(String::New("A"))));
+  EXPECT(!cls.IsNull());
+  EXPECT(Error::Handle(cls.EnsureIsFinalized(thread)).IsNull());
+
+  const Field& d =
+      Field::Handle(cls.LookupField(String::Handle(String::New("d"))));
+  const bool unbox_doubles = FlowGraphCompiler::SupportsUnboxedDoubles();
+  EXPECT_EQ(null_safety && unbox_doubles, d.is_unboxing_candidate());
+  EXPECT_EQ(null_safety && unbox_doubles, IsUnboxedInLayout(cls, d));
+  if (null_safety && unbox_doubles) {
+    EXPECT_EQ(kDoubleCid, d.guarded_cid());
+    EXPECT(!d.is_nullable());
+  }
+
+  const Field& i =
+      Field::Handle(cls.LookupField(String::Handle(String::New("i"))));
+  EXPECT_EQ(null_safety, i.is_unboxing_candidate());
+  EXPECT_EQ(null_safety, i.is_non_nullable_integer());
+  EXPECT_EQ(null_safety, IsUnboxedInLayout(cls, i));
+
+  const Field& n =
+      Field::Handle(cls.LookupField(String::Handle(String::New("n"))));
+  EXPECT(!n.is_unboxing_candidate());
+  EXPECT(!IsUnboxedInLayout(cls, n));
+
+  const Field& s =
+      Field::Handle(cls.LookupField(String::Handle(String::New("s"))));
+  EXPECT(!s.is_unboxing_candidate());
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+}  // namespace dart
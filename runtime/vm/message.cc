@@ -105,7 +105,7 @@ const char* Message::PriorityAsString(Priority priority) {
   }
 }
 
-MessageQueue::MessageQueue() {
+MessageQueue::MessageQueue() : incoming_(nullptr) {
   head_ = NULL;
   tail_ = NULL;
 }
@@ -117,6 +117,9 @@ MessageQueue::~MessageQueue() {
 }
 
 void MessageQueue::Enqueue(std::unique_ptr<Message> msg0, bool before_events) {
+  // Keep the order of messages that were added concurrently before this one.
+  ProcessIncoming();
+
   // TODO(mdempsky): Use unique_ptr internally?
   Message* msg = msg0.release();
 
@@ -160,7 +163,49 @@ void MessageQueue::Enqueue(std::unique_ptr<Message> msg0, bool before_events) {
   }
 }
 
+bool MessageQueue::EnqueueConcurrent(std::unique_ptr<Message> msg0) {
+  Message* msg = msg0.release();
+
+  // Make sure messages are not reused.
+  ASSERT(msg->next_ == NULL);
+  Message* incoming = incoming_.load(std::memory_order_relaxed);
+  do {
+    msg->next_ = incoming;
+  } while (!incoming_.compare_exchange_weak(incoming, msg,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed));
+  return incoming == nullptr;
+}
+
+void MessageQueue::ProcessIncoming() {
+  Message* incoming = incoming_.exchange(nullptr, std::memory_order_acquire);
+  if (incoming == nullptr) {
+    return;
+  }
+  // The incoming messages are linked from the most recent one. Reverse them
+  // and append them at the tail.
+  Message* last = incoming;
+  Message* first = nullptr;
+  while (incoming != nullptr) {
+    Message* next = incoming->next_;
+    incoming->next_ = first;
+    first = incoming;
+    incoming = next;
+  }
+  if (head_ == NULL) {
+    ASSERT(tail_ == NULL);
+    head_ = first;
+  } else {
+    ASSERT(tail_ != NULL);
+    tail_->next_ = first;
+  }
+  tail_ = last;
+}
+
 std::unique_ptr<Message> MessageQueue::Dequeue() {
+  if (head_ == nullptr) {
+    ProcessIncoming();
+  }
   Message* result = head_;
   if (result != nullptr) {
     head_ = result->next_;
@@ -177,6 +222,7 @@ std::unique_ptr<Message> MessageQueue::Dequeue() {
 }
 
 void MessageQueue::Clear() {
+  ProcessIncoming();
   std::unique_ptr<Message> cur(head_);
   head_ = nullptr;
   tail_ = nullptr;
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_MESSAGE_H_
 #define RUNTIME_VM_MESSAGE_H_
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
@@ -114,7 +115,8 @@ class Message {
   bool IsSnapshot() const { return !IsRaw() && !IsBequest(); }
   // A message whose object is an immortal object from the vm-isolate's heap.
   bool IsRaw() const { return snapshot_length_ == 0; }
-  // A message sent from sendAndExit.
+  // A message sent from sendAndExit, or copied from the heap of an isolate in
+  // the same group.
   bool IsBequest() const { return snapshot_length_ == -1; }
 
   bool RedirectToDeliveryFailurePort();
@@ -159,11 +161,26 @@ class MessageQueue {
 
   void Enqueue(std::unique_ptr<Message> msg, bool before_events);
 
+  // Adds a message at the tail of the queue. Unlike the other methods, this
+  // can be called concurrently without holding the lock that protects the
+  // queue: the message is pushed onto a lock-free list of incoming messages,
+  // which the consumer moves into the queue.
+  //
+  // Returns true if there were no other incoming messages, in which case the
+  // caller is responsible for waking up the consumer.
+  bool EnqueueConcurrent(std::unique_ptr<Message> msg);
+
+  // Moves the incoming messages to the tail of the queue.
+  void ProcessIncoming();
+
   // Gets the next message from the message queue or NULL if no
   // message is available.  This function will not block.
   std::unique_ptr<Message> Dequeue();
 
-  bool IsEmpty() { return head_ == NULL; }
+  bool IsEmpty() {
+    return head_ == NULL &&
+           incoming_.load(std::memory_order_relaxed) == nullptr;
+  }
 
   // Clear all messages from the message queue.
   void Clear();
@@ -196,6 +213,8 @@ class MessageQueue {
  private:
   Message* head_;
   Message* tail_;
+  // The messages added by EnqueueConcurrent, most recent first.
+  std::atomic<Message*> incoming_;
 
   DISALLOW_COPY_AND_ASSIGN(MessageQueue);
 };
@@ -31,6 +31,12 @@ class MessageHandlerTask : public ThreadPool::Task {
     handler_->TaskCallback();
   }
 
+  // A handler that posts a message to another one usually returns soon, so
+  // it can run the other handler next on the same thread. If it keeps
+  // running, or waits for the other isolate, the pool lets an idle worker
+  // take the task after a short delay.
+  virtual bool can_run_on_scheduling_worker() const { return true; }
+
  private:
   MessageHandler* handler_;
 
@@ -124,53 +130,86 @@ void MessageHandler::Run(ThreadPool* pool,
 
 void MessageHandler::PostMessage(std::unique_ptr<Message> message,
                                  bool before_events) {
-  Message::Priority saved_priority;
+  if (FLAG_trace_isolates) {
+    Isolate* source_isolate = Isolate::Current();
+    if (source_isolate != nullptr) {
+      OS::PrintErr(
+          "[>] Posting message:\n"
+          "\tlen:        %" Pd "\n\tsource:     (%" Pd64
+          ") %s\n\tdest:       %s\n"
+          "\tdest_port:  %" Pd64 "\n",
+          message->Size(), static_cast<int64_t>(source_isolate->main_port()),
+          source_isolate->name(), name(), message->dest_port());
+    } else {
+      OS::PrintErr(
+          "[>] Posting message:\n"
+          "\tlen:        %" Pd
+          "\n\tsource:     <native code>\n"
+          "\tdest:       %s\n"
+          "\tdest_port:  %" Pd64 "\n",
+          message->Size(), name(), message->dest_port());
+    }
+  }
 
-  {
+  const Message::Priority saved_priority = message->priority();
+
+  // Normal messages are added to the queue without taking the monitor. Only
+  // the poster that finds no other incoming message wakes up the handler,
+  // which then takes all incoming messages at once.
+  bool wake_up = true;
+  if (!message->IsOOB() && !before_events) {
+    wake_up = queue_->EnqueueConcurrent(std::move(message));
+  }
+
+  if (wake_up) {
     MonitorLocker ml(&monitor_);
-    if (FLAG_trace_isolates) {
-      Isolate* source_isolate = Isolate::Current();
-      if (source_isolate != nullptr) {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd "\n\tsource:     (%" Pd64
-            ") %s\n\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), static_cast<int64_t>(source_isolate->main_port()),
-            source_isolate->name(), name(), message->dest_port());
+    if (message != nullptr) {
+      if (message->IsOOB()) {
+        oob_queue_->Enqueue(std::move(message), before_events);
       } else {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd
-            "\n\tsource:     <native code>\n"
-            "\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), name(), message->dest_port());
+        queue_->Enqueue(std::move(message), before_events);
       }
     }
+    WakeUpLocked(&ml);
+  }
 
-    saved_priority = message->priority();
-    if (message->IsOOB()) {
-      oob_queue_->Enqueue(std::move(message), before_events);
-    } else {
-      queue_->Enqueue(std::move(message), before_events);
-    }
-    if (paused_for_messages_) {
-      ml.Notify();
-    }
+  // Invoke any custom message notification.
+  MessageNotify(saved_priority);
+}
 
-    if (pool_ != nullptr && !task_running_) {
-      ASSERT(!delete_me_);
-      task_running_ = true;
-      const bool launched_successfully = pool_->Run<MessageHandlerTask>(this);
-      ASSERT(launched_successfully);
+void MessageHandler::PostMessages(std::unique_ptr<Message>* messages,
+                                  intptr_t num_messages) {
+  ASSERT(num_messages > 0);
+  const Message::Priority saved_priority = messages[0]->priority();
+  bool wake_up = false;
+  for (intptr_t i = 0; i < num_messages; i++) {
+    ASSERT(!messages[i]->IsOOB());
+    if (queue_->EnqueueConcurrent(std::move(messages[i]))) {
+      wake_up = true;
     }
   }
+  if (wake_up) {
+    MonitorLocker ml(&monitor_);
+    WakeUpLocked(&ml);
+  }
 
   // Invoke any custom message notification.
   MessageNotify(saved_priority);
 }
 
+void MessageHandler::WakeUpLocked(MonitorLocker* ml) {
+  if (paused_for_messages_) {
+    ml->Notify();
+  }
+
+  if (pool_ != nullptr && !task_running_) {
+    ASSERT(!delete_me_);
+    task_running_ = true;
+    const bool launched_successfully = pool_->Run<MessageHandlerTask>(this);
+    ASSERT(launched_successfully);
+  }
+}
+
 std::unique_ptr<Message> MessageHandler::DequeueMessage(
     Message::Priority min_priority) {
   // TODO(turnidge): Add assert that monitor_ is held here.
@@ -181,6 +220,24 @@ std::unique_ptr<Message> MessageHandler::DequeueMessage(
   return message;
 }
 
+intptr_t MessageHandler::DequeueMessages(std::unique_ptr<Message>* messages,
+                                         intptr_t max_messages) {
+  MonitorLocker ml(&monitor_);
+  // Messages that are handled one at a time keep their turn.
+  if (!oob_queue_->IsEmpty() || paused()) {
+    return 0;
+  }
+  intptr_t count = 0;
+  while (count < max_messages) {
+    std::unique_ptr<Message> message = queue_->Dequeue();
+    if (message == nullptr) {
+      break;
+    }
+    messages[count++] = std::move(message);
+  }
+  return count;
+}
+
 void MessageHandler::ClearOOBQueue() {
   oob_queue_->Clear();
 }
@@ -641,6 +698,7 @@ MessageHandler::AcquiredQueues::AcquiredQueues(MessageHandler* handler)
     : handler_(handler), ml_(&handler->monitor_) {
   ASSERT(handler != NULL);
   handler_->oob_message_handling_allowed_ = false;
+  handler_->queue_->ProcessIncoming();
 }
 
 MessageHandler::AcquiredQueues::~AcquiredQueues() {
@@ -174,6 +174,10 @@ class MessageHandler {
   void PostMessage(std::unique_ptr<Message> message,
                    bool before_events = false);
 
+  // Posts several normal messages on this handler's message queue at once,
+  // waking up the handler at most once.
+  void PostMessages(std::unique_ptr<Message>* messages, intptr_t num_messages);
+
   // Notifies this handler that a port is being closed.
   void ClosePort(Dart_Port port);
 
@@ -201,6 +205,14 @@ class MessageHandler {
   // Returns true on success.
   virtual MessageStatus HandleMessage(std::unique_ptr<Message> message) = 0;
 
+  // Takes up to [max_messages] more normal messages from the queue without
+  // waiting, for subclasses that handle several messages at once. Can only be
+  // called from HandleMessage.
+  //
+  // Returns the number of messages stored in [messages].
+  intptr_t DequeueMessages(std::unique_ptr<Message>* messages,
+                           intptr_t max_messages);
+
   virtual void NotifyPauseOnStart() {}
   virtual void NotifyPauseOnExit() {}
 
@@ -233,6 +245,9 @@ class MessageHandler {
   void PausedOnStartLocked(MonitorLocker* ml, bool paused);
   void PausedOnExitLocked(MonitorLocker* ml, bool paused);
 
+  // Notifies a handler waiting for messages, or starts a task to handle them.
+  void WakeUpLocked(MonitorLocker* ml);
+
   // Dequeue the next message.  Prefer messages from the oob_queue_ to
   // messages from the queue_.
   std::unique_ptr<Message> DequeueMessage(Message::Priority min_priority);
@@ -409,4 +409,70 @@ VM_UNIT_TEST_CASE(MessageHandler_Run) {
   OSThread::Join(info.join_id);
 }
 
+static void PostMessagesToPort(uword param) {
+  ThreadStartInfo* info = reinterpret_cast<ThreadStartInfo*>(param);
+  info->join_id = OSThread::GetCurrentThreadJoinId(OSThread::Current());
+  for (int i = 0; i < info->count; i++) {
+    EXPECT(PortMap::PostMessage(
+        BlankMessage(info->ports[0], Message::kNormalPriority)));
+  }
+}
+
+VM_UNIT_TEST_CASE(MessageHandler_RunConcurrentSenders) {
+  TestMessageHandler handler;
+  ThreadPool pool;
+  MessageHandlerTestPeer handler_peer(&handler);
+  handler_peer.increment_live_ports();
+  handler.Run(&pool, TestStartFunction, TestEndFunction,
+              reinterpret_cast<uword>(&handler));
+
+  // Several threads post messages to the same handler at once, each to its
+  // own port, while more ports are opened.
+  const int kNumSenders = 8;
+  const int kMessagesPerSender = 1000;
+  Dart_Port ports[kNumSenders];
+  ThreadStartInfo infos[kNumSenders];
+  for (int i = 0; i < kNumSenders; i++) {
+    ports[i] = PortMap::CreatePort(&handler);
+    infos[i].handler = &handler;
+    infos[i].ports = &ports[i];
+    infos[i].count = kMessagesPerSender;
+    infos[i].join_id = OSThread::kInvalidThreadJoinId;
+  }
+  for (int i = 0; i < kNumSenders; i++) {
+    OSThread::Start("PostMessagesToPort", PostMessagesToPort,
+                    reinterpret_cast<uword>(&infos[i]));
+  }
+  for (int i = 0; i < 100; i++) {
+    PortMap::ClosePort(PortMap::CreatePort(&handler));
+  }
+
+  // Wait for the messages to be handled.
+  {
+    MonitorLocker ml(handler.monitor());
+    while (handler.message_count() < kNumSenders * kMessagesPerSender) {
+      ml.Wait();
+    }
+    EXPECT_EQ(kNumSenders * kMessagesPerSender, handler.message_count());
+    int counts[kNumSenders] = {};
+    Dart_Port* handler_ports = handler.port_buffer();
+    for (int i = 0; i < handler.message_count(); i++) {
+      for (int j = 0; j < kNumSenders; j++) {
+        if (handler_ports[i] == ports[j]) {
+          counts[j]++;
+        }
+      }
+    }
+    for (int j = 0; j < kNumSenders; j++) {
+      EXPECT_EQ(kMessagesPerSender, counts[j]);
+    }
+    handler_peer.decrement_live_ports();
+  }
+
+  for (int i = 0; i < kNumSenders; i++) {
+    ASSERT(infos[i].join_id != OSThread::kInvalidThreadJoinId);
+    OSThread::Join(infos[i].join_id);
+  }
+}
+
 }  // namespace dart
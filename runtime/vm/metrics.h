@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_METRICS_H_
 #define RUNTIME_VM_METRICS_H_
 
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 
 namespace dart {
@@ -31,7 +32,11 @@ class JSONStream;
 // Metrics for each isolate.
 #define ISOLATE_METRIC_LIST(V)                                                 \
   V(Metric, RunnableLatency, "isolate.runnable.latency", kMicrosecond)         \
-  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)
+  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)                  \
+  V(Metric, QuickTierOptimizations, "isolate.compiler.quickTier.optimized",    \
+    kCounter)                                                                  \
+  V(Metric, QuickTierReoptimizations,                                          \
+    "isolate.compiler.quickTier.reoptimized", kCounter)
 
 #define VM_METRIC_LIST(V)                                                      \
   V(MetricIsolateCount, IsolateCount, "vm.isolate.count", kCounter)            \
@@ -83,7 +88,8 @@ class Metric {
   int64_t value() const { return value_; }
   void set_value(int64_t value) { value_ = value; }
 
-  void increment() { value_++; }
+  // Safe to call from background threads, such as background compilers.
+  void increment() { value_.fetch_add(1); }
 
   const char* name() const { return name_; }
   const char* description() const { return description_; }
@@ -107,7 +113,7 @@ class Metric {
   const char* name_ = nullptr;
   const char* description_ = nullptr;
   Unit unit_;
-  int64_t value_;
+  RelaxedAtomic<int64_t> value_;
 
   static Metric* vm_list_head_;
   DISALLOW_COPY_AND_ASSIGN(Metric);
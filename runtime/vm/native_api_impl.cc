@@ -59,6 +59,32 @@ DART_EXPORT bool Dart_PostCObject(Dart_Port port_id, Dart_CObject* message) {
   return PostCObjectHelper(port_id, message);
 }
 
+DART_EXPORT bool Dart_PostCObjectBatch(Dart_Port port_id,
+                                       intptr_t num_messages,
+                                       Dart_CObject** messages) {
+  if (num_messages <= 0) {
+    return num_messages == 0;
+  }
+  std::unique_ptr<std::unique_ptr<Message>[]> msgs(
+      new std::unique_ptr<Message>[num_messages]);
+  for (intptr_t i = 0; i < num_messages; i++) {
+    ApiMessageWriter writer;
+    msgs[i] =
+        writer.WriteCMessage(messages[i], port_id, Message::kNormalPriority);
+    if (msgs[i] == nullptr) {
+      // None of the messages are posted, so ownership of the external data
+      // in the ones already written remains with the poster.
+      for (intptr_t j = 0; j < i; j++) {
+        msgs[j]->DropFinalizers();
+      }
+      return false;
+    }
+  }
+
+  // Post the messages at the given port.
+  return PortMap::PostMessages(port_id, msgs.get(), num_messages);
+}
+
 DART_EXPORT bool Dart_PostInteger(Dart_Port port_id, int64_t message) {
   if (Smi::IsValid(message)) {
     return PortMap::PostMessage(
@@ -91,6 +117,34 @@ DART_EXPORT Dart_Port Dart_NewNativePort(const char* name,
   return port_id;
 }
 
+DART_EXPORT Dart_Port
+Dart_NewNativeBatchPort(const char* name,
+                        Dart_NativeMessageBatchHandler handler,
+                        intptr_t max_batch_size) {
+  if (name == NULL) {
+    name = "<UnnamedNativePort>";
+  }
+  if (handler == NULL) {
+    OS::PrintErr("%s expects argument 'handler' to be non-null.\n",
+                 CURRENT_FUNC);
+    return ILLEGAL_PORT;
+  }
+  if (max_batch_size <= 0) {
+    OS::PrintErr("%s expects argument 'max_batch_size' to be positive.\n",
+                 CURRENT_FUNC);
+    return ILLEGAL_PORT;
+  }
+  // Start the native port without a current isolate.
+  IsolateLeaveScope saver(Isolate::Current());
+
+  NativeMessageHandler* nmh =
+      new NativeMessageHandler(name, handler, max_batch_size);
+  Dart_Port port_id = PortMap::CreatePort(nmh);
+  PortMap::SetPortState(port_id, PortMap::kLivePort);
+  nmh->Run(Dart::thread_pool(), NULL, NULL, 0);
+  return port_id;
+}
+
 DART_EXPORT bool Dart_CloseNativePort(Dart_Port native_port_id) {
   // Close the native port without a current isolate.
   IsolateLeaveScope saver(Isolate::Current());
@@ -15,7 +15,21 @@ namespace dart {
 
 NativeMessageHandler::NativeMessageHandler(const char* name,
                                            Dart_NativeMessageHandler func)
-    : name_(Utils::StrDup(name)), func_(func) {}
+    : name_(Utils::StrDup(name)),
+      func_(func),
+      batch_func_(nullptr),
+      max_batch_size_(1) {}
+
+NativeMessageHandler::NativeMessageHandler(
+    const char* name,
+    Dart_NativeMessageBatchHandler batch_func,
+    intptr_t max_batch_size)
+    : name_(Utils::StrDup(name)),
+      func_(nullptr),
+      batch_func_(batch_func),
+      max_batch_size_(max_batch_size) {
+  ASSERT(max_batch_size > 0);
+}
 
 NativeMessageHandler::~NativeMessageHandler() {
   free(name_);
@@ -33,6 +47,9 @@ MessageHandler::MessageStatus NativeMessageHandler::HandleMessage(
     // We currently do not use OOB messages for native ports.
     UNREACHABLE();
   }
+  if (batch_func_ != nullptr) {
+    return HandleMessageBatch(std::move(message));
+  }
   // We create a native scope for handling the message.
   // All allocation of objects for decoding the message is done in the
   // zone associated with this scope.
@@ -44,4 +61,24 @@ MessageHandler::MessageStatus NativeMessageHandler::HandleMessage(
   return kOK;
 }
 
+MessageHandler::MessageStatus NativeMessageHandler::HandleMessageBatch(
+    std::unique_ptr<Message> first_message) {
+  // The messages that are already pending are handled together with the
+  // first one, and decoded in the zone of the same native scope.
+  std::unique_ptr<std::unique_ptr<Message>[]> messages(
+      new std::unique_ptr<Message>[max_batch_size_]);
+  messages[0] = std::move(first_message);
+  const intptr_t num_messages =
+      1 + DequeueMessages(&messages[1], max_batch_size_ - 1);
+
+  ApiNativeScope scope;
+  Dart_CObject** objects = scope.zone()->Alloc<Dart_CObject*>(num_messages);
+  for (intptr_t i = 0; i < num_messages; i++) {
+    ApiMessageReader reader(messages[i].get());
+    objects[i] = reader.ReadMessage();
+  }
+  (*batch_func())(messages[0]->dest_port(), num_messages, objects);
+  return kOK;
+}
+
 }  // namespace dart
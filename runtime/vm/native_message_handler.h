@@ -13,13 +13,20 @@ namespace dart {
 
 // A NativeMessageHandler accepts messages and dispatches them to
 // native C handlers.
+//
+// A handler created with a Dart_NativeMessageBatchHandler dispatches the
+// pending messages in batches, which are decoded in a single native scope.
 class NativeMessageHandler : public MessageHandler {
  public:
   NativeMessageHandler(const char* name, Dart_NativeMessageHandler func);
+  NativeMessageHandler(const char* name,
+                       Dart_NativeMessageBatchHandler batch_func,
+                       intptr_t max_batch_size);
   ~NativeMessageHandler();
 
   const char* name() const { return name_; }
   Dart_NativeMessageHandler func() const { return func_; }
+  Dart_NativeMessageBatchHandler batch_func() const { return batch_func_; }
 
   MessageStatus HandleMessage(std::unique_ptr<Message> message);
 
@@ -32,8 +39,12 @@ class NativeMessageHandler : public MessageHandler {
   virtual bool OwnedByPortMap() const { return true; }
 
  private:
+  MessageStatus HandleMessageBatch(std::unique_ptr<Message> first_message);
+
   char* name_;
   Dart_NativeMessageHandler func_;
+  Dart_NativeMessageBatchHandler batch_func_;
+  intptr_t max_batch_size_;
 };
 
 }  // namespace dart
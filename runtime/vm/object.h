@@ -829,6 +829,7 @@ class Object {
   friend class Closure;
   friend class SnapshotReader;
   friend class InstanceDeserializationCluster;
+  friend class ObjectGraphCopier;  // Clone
   friend class OneByteString;
   friend class TwoByteString;
   friend class ExternalOneByteString;
@@ -3671,11 +3672,14 @@ class Function : public Object {
 // a hoisted check class instruction.
 // 'ProhibitsBoundsCheckGeneralization' is true if this function deoptimized
 // before on a generalized bounds check.
+// 'WasQuickOptimized' is true if this function was optimized with the quick
+// optimizing tier before. All further optimizations use the full pipeline.
 #define STATE_BITS_LIST(V)                                                     \
   V(WasCompiled)                                                               \
   V(WasExecutedBit)                                                            \
   V(ProhibitsHoistingCheckClass)                                               \
-  V(ProhibitsBoundsCheckGeneralization)
+  V(ProhibitsBoundsCheckGeneralization)                                        \
+  V(WasQuickOptimized)
 
   enum StateBits {
 #define DECLARE_FLAG_POS(Name) k##Name##Pos,
@@ -0,0 +1,252 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/object_graph_copy.h"
+
+#include "vm/heap/weak_table.h"
+#include "vm/isolate.h"
+#include "vm/object_store.h"
+#include "vm/raw_object.h"
+#include "vm/visitor.h"
+
+namespace dart {
+
+// Collects the offsets of the pointers of an object that refer to objects
+// which have to be copied rather than shared.
+class ForwardedSlotsVisitor : public ObjectPointerVisitor {
+ public:
+  ForwardedSlotsVisitor(IsolateGroup* isolate_group,
+                        ObjectPtr object,
+                        MallocGrowableArray<intptr_t>* slots)
+      : ObjectPointerVisitor(isolate_group),
+        object_address_(ObjectLayout::ToAddr(object)),
+        slots_(slots) {}
+
+  void VisitPointers(ObjectPtr* first, ObjectPtr* last) {
+    for (ObjectPtr* current = first; current <= last; current++) {
+      if (!ObjectGraphCopier::CanShareObject(*current)) {
+        slots_->Add(reinterpret_cast<uword>(current) - object_address_);
+      }
+    }
+  }
+
+ private:
+  const uword object_address_;
+  MallocGrowableArray<intptr_t>* const slots_;
+
+  DISALLOW_COPY_AND_ASSIGN(ForwardedSlotsVisitor);
+};
+
+ObjectGraphCopier::ObjectGraphCopier(Thread* thread)
+    : ThreadStackResource(thread),
+      zone_(thread->zone()),
+      set_cid_(Class::Handle(zone_,
+                             thread->isolate()
+                                 ->object_store()
+                                 ->linked_hash_set_class())
+                   .id()),
+      failed_(false),
+      from_(GrowableObjectArray::Handle(zone_, GrowableObjectArray::New())),
+      to_(GrowableObjectArray::Handle(zone_, GrowableObjectArray::New())),
+      slots_(),
+      original_(Object::Handle(zone_)),
+      copy_(Object::Handle(zone_)),
+      value_(Object::Handle(zone_)),
+      forwarded_(Object::Handle(zone_)),
+      data_(Array::Handle(zone_)),
+      class_(Class::Handle(zone_)) {
+  // The forward tables are kept up to date by the GC, which may run while
+  // the graph is copied.
+  isolate()->set_forward_table_new(new WeakTable());
+  isolate()->set_forward_table_old(new WeakTable());
+}
+
+ObjectGraphCopier::~ObjectGraphCopier() {
+  isolate()->set_forward_table_new(nullptr);
+  isolate()->set_forward_table_old(nullptr);
+}
+
+bool ObjectGraphCopier::Copy(const Object& root, Object* copy) {
+  *copy = Forward(root);
+  // The copies are allocated breadth first, and their pointers still refer
+  // to the originals until they are forwarded here.
+  for (intptr_t i = 0; !failed_ && i < from_.Length(); i++) {
+    original_ = from_.At(i);
+    copy_ = to_.At(i);
+    CopyPointers(original_, copy_);
+  }
+  return !failed_;
+}
+
+bool ObjectGraphCopier::CanShareObject(ObjectPtr raw) {
+  if (!raw->IsHeapObject() || raw->ptr()->IsCanonical() ||
+      raw->ptr()->InVMIsolateHeap()) {
+    return true;
+  }
+  switch (raw->GetClassId()) {
+    case kOneByteStringCid:
+    case kTwoByteStringCid:
+    case kExternalOneByteStringCid:
+    case kExternalTwoByteStringCid:
+    case kMintCid:
+    case kDoubleCid:
+    case kFloat32x4Cid:
+    case kInt32x4Cid:
+    case kFloat64x2Cid:
+    case kSendPortCid:
+    case kCapabilityCid:
+    case kTypeArgumentsCid:
+    case kTypeCid:
+    case kTypeRefCid:
+    case kTypeParameterCid:
+      return true;
+    case kClosureCid: {
+      // Only closures of top level methods and static functions can be sent,
+      // and they have no state.
+      const Closure& closure = Closure::Handle(Closure::RawCast(raw));
+      return Function::IsImplicitStaticClosureFunction(closure.function());
+    }
+    default:
+      return false;
+  }
+}
+
+bool ObjectGraphCopier::CanCopyObject(const Object& original) {
+  const intptr_t cid = original.GetClassId();
+  switch (cid) {
+    case kInstanceCid:
+    case kArrayCid:
+    case kImmutableArrayCid:
+    case kGrowableObjectArrayCid:
+      return true;
+    case kLinkedHashMapCid: {
+      // The index of a map depends on the hash codes of its keys, and a copied
+      // key has a different identity hash code than the original. The index
+      // is only copied as is if all keys are shared.
+      data_ = LinkedHashMap::Cast(original).data();
+      if (data_.IsNull()) {
+        return true;
+      }
+      const intptr_t used_data =
+          Smi::Value(LinkedHashMap::Cast(original).used_data());
+      NoSafepointScope no_safepoint;
+      for (intptr_t i = 0; i < used_data; i += 2) {
+        ObjectPtr key = data_.At(i);
+        // Deleted keys are marked with the data array itself.
+        if (key != data_.raw() && !CanShareObject(key)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      if (IsTypedDataClassId(cid)) {
+        return true;
+      }
+      if (cid < kNumPredefinedCids || cid == set_cid_) {
+        // Sets are rehashed when they are read from a message snapshot, for
+        // the same reason as maps.
+        return false;
+      }
+      class_ = isolate()->class_table()->At(cid);
+      return class_.num_native_fields() == 0;
+  }
+}
+
+ObjectPtr ObjectGraphCopier::AllocateCopy(const Object& original) {
+  const intptr_t cid = original.GetClassId();
+  if (cid == kArrayCid || cid == kImmutableArrayCid) {
+    // Allocated like any other array, so that large arrays use card marking.
+    // The elements are copied by CopyPointers.
+    const Array& array = Array::Cast(original);
+    const intptr_t length = array.Length();
+    Array& copy = Array::Handle(zone_);
+    if (cid == kArrayCid) {
+      copy = Array::New(length);
+    } else {
+      copy = ImmutableArray::New(length);
+    }
+    const TypeArguments& type_arguments =
+        TypeArguments::Handle(zone_, array.GetTypeArguments());
+    copy.SetTypeArguments(type_arguments);
+    return copy.raw();
+  }
+  return Object::Clone(original, Heap::kNew);
+}
+
+ObjectPtr ObjectGraphCopier::Forward(const Object& original) {
+  if (CanShareObject(original.raw())) {
+    return original.raw();
+  }
+  const intptr_t id = GetObjectId(original.raw());
+  if (id != 0) {
+    return to_.At(id - 1);
+  }
+  if (!CanCopyObject(original)) {
+    failed_ = true;
+    return Object::null();
+  }
+  forwarded_ = AllocateCopy(original);
+  SetObjectId(original.raw(), from_.Length() + 1);
+  from_.Add(original);
+  to_.Add(forwarded_);
+  return forwarded_.raw();
+}
+
+void ObjectGraphCopier::CopyPointers(const Object& original,
+                                     const Object& copy) {
+  const intptr_t cid = copy.GetClassId();
+  if (cid == kArrayCid || cid == kImmutableArrayCid) {
+    const Array& from = Array::Cast(original);
+    const Array& to = Array::Cast(copy);
+    const intptr_t length = from.Length();
+    for (intptr_t i = 0; i < length; i++) {
+      value_ = from.At(i);
+      value_ = Forward(value_);
+      if (failed_) {
+        return;
+      }
+      to.SetAt(i, value_);
+    }
+    return;
+  }
+
+  // Other copies are clones of the original, so they refer to the same
+  // objects until their pointers are forwarded.
+  slots_.Clear();
+  {
+    NoSafepointScope no_safepoint;
+    ForwardedSlotsVisitor visitor(isolate_group(), copy.raw(), &slots_);
+    copy.raw()->ptr()->VisitPointers(&visitor);
+  }
+  for (intptr_t i = 0; i < slots_.length(); i++) {
+    const intptr_t offset = slots_[i];
+    value_ = *reinterpret_cast<ObjectPtr*>(ObjectLayout::ToAddr(copy.raw()) +
+                                           offset);
+    value_ = Forward(value_);
+    if (failed_) {
+      return;
+    }
+    ObjectPtr* slot = reinterpret_cast<ObjectPtr*>(
+        ObjectLayout::ToAddr(copy.raw()) + offset);
+    copy.raw()->ptr()->StorePointer(slot, value_.raw());
+  }
+}
+
+intptr_t ObjectGraphCopier::GetObjectId(ObjectPtr raw) {
+  if (raw->IsNewObject()) {
+    return isolate()->forward_table_new()->GetValueExclusive(raw);
+  }
+  return isolate()->forward_table_old()->GetValueExclusive(raw);
+}
+
+void ObjectGraphCopier::SetObjectId(ObjectPtr raw, intptr_t id) {
+  if (raw->IsNewObject()) {
+    isolate()->forward_table_new()->SetValueExclusive(raw, id);
+  } else {
+    isolate()->forward_table_old()->SetValueExclusive(raw, id);
+  }
+}
+
+}  // namespace dart
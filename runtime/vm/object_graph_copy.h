@@ -0,0 +1,70 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_OBJECT_GRAPH_COPY_H_
+#define RUNTIME_VM_OBJECT_GRAPH_COPY_H_
+
+#include "platform/growable_array.h"
+#include "vm/allocation.h"
+#include "vm/object.h"
+#include "vm/thread_stack_resource.h"
+
+namespace dart {
+
+// Copies the object graph of a message sent to an isolate in the same isolate
+// group directly from heap to heap, without writing a message snapshot.
+// Objects that cannot be mutated (strings, numbers, canonical objects, send
+// ports, static closures, ...) are shared with the receiver rather than
+// copied.
+//
+// Only the objects that make up most messages are copied: lists, maps, typed
+// data and plain Dart objects. If the graph contains any other object the
+// copy fails, and the message has to be sent as a snapshot instead, which
+// also reports objects that cannot be sent at all.
+class ObjectGraphCopier : public ThreadStackResource {
+ public:
+  explicit ObjectGraphCopier(Thread* thread);
+  ~ObjectGraphCopier();
+
+  // Returns true and sets [copy] to a copy of the graph reachable from [root],
+  // or returns false if the graph cannot be copied.
+  bool Copy(const Object& root, Object* copy);
+
+  // Whether [raw] can be shared by the isolates of a group.
+  static bool CanShareObject(ObjectPtr raw);
+
+ private:
+  bool CanCopyObject(const Object& original);
+  ObjectPtr AllocateCopy(const Object& original);
+  ObjectPtr Forward(const Object& original);
+  void CopyPointers(const Object& original, const Object& copy);
+
+  intptr_t GetObjectId(ObjectPtr raw);
+  void SetObjectId(ObjectPtr raw, intptr_t id);
+
+  Zone* zone_;
+  const intptr_t set_cid_;
+  bool failed_;
+
+  // The objects copied so far and their copies. The copy of the object with
+  // id i in the forward tables of the isolate is at index i - 1.
+  const GrowableObjectArray& from_;
+  const GrowableObjectArray& to_;
+  // The offsets of the pointers of the object being copied that need to be
+  // forwarded.
+  MallocGrowableArray<intptr_t> slots_;
+
+  Object& original_;
+  Object& copy_;
+  Object& value_;
+  Object& forwarded_;
+  Array& data_;
+  Class& class_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObjectGraphCopier);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_OBJECT_GRAPH_COPY_H_
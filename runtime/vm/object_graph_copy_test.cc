@@ -0,0 +1,211 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/object_graph_copy.h"
+#include "platform/assert.h"
+#include "vm/dart_api_impl.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+ISOLATE_UNIT_TEST_CASE(ObjectGraphCopy_Arrays) {
+  // a -> [b, s, 42, a]
+  // b -> [a, s, d]
+  // d: Uint8List
+  const String& s = String::Handle(String::New("shared"));
+  const Array& a = Array::Handle(Array::New(4));
+  const Array& b = Array::Handle(Array::New(3, Heap::kOld));
+  const TypedData& d =
+      TypedData::Handle(TypedData::New(kTypedDataUint8ArrayCid, 16));
+  d.SetUint8(3, 7);
+  a.SetAt(0, b);
+  a.SetAt(1, s);
+  a.SetAt(2, Smi::Handle(Smi::New(42)));
+  a.SetAt(3, a);
+  b.SetAt(0, a);
+  b.SetAt(1, s);
+  b.SetAt(2, d);
+
+  Object& copy = Object::Handle();
+  {
+    ObjectGraphCopier copier(thread);
+    EXPECT(copier.Copy(a, &copy));
+  }
+  EXPECT(copy.IsArray());
+  EXPECT(copy.raw() != a.raw());
+  const Array& a_copy = Array::Cast(copy);
+  EXPECT_EQ(4, a_copy.Length());
+  // Cycles point to the copy.
+  EXPECT_EQ(a_copy.raw(), a_copy.At(3));
+  const Array& b_copy = Array::Handle(Array::RawCast(a_copy.At(0)));
+  EXPECT(b_copy.raw() != b.raw());
+  EXPECT_EQ(a_copy.raw(), b_copy.At(0));
+  // Strings and Smis are shared.
+  EXPECT_EQ(s.raw(), a_copy.At(1));
+  EXPECT_EQ(s.raw(), b_copy.At(1));
+  EXPECT_EQ(Smi::New(42), a_copy.At(2));
+  // Typed data is copied.
+  const TypedData& d_copy = TypedData::Handle(TypedData::RawCast(b_copy.At(2)));
+  EXPECT(d_copy.raw() != d.raw());
+  EXPECT_EQ(16, d_copy.Length());
+  EXPECT_EQ(7, d_copy.GetUint8(3));
+  d.SetUint8(3, 8);
+  EXPECT_EQ(7, d_copy.GetUint8(3));
+}
+
+ISOLATE_UNIT_TEST_CASE(ObjectGraphCopy_GrowableObjectArray) {
+  const GrowableObjectArray& list =
+      GrowableObjectArray::Handle(GrowableObjectArray::New());
+  const Array& element = Array::Handle(Array::New(1));
+  list.Add(element);
+  list.Add(element);
+
+  Object& copy = Object::Handle();
+  {
+    ObjectGraphCopier copier(thread);
+    EXPECT(copier.Copy(list, &copy));
+  }
+  EXPECT(copy.IsGrowableObjectArray());
+  const GrowableObjectArray& list_copy = GrowableObjectArray::Cast(copy);
+  EXPECT_EQ(2, list_copy.Length());
+  EXPECT(list_copy.At(0) != element.raw());
+  EXPECT_EQ(list_copy.At(0), list_copy.At(1));
+  list_copy.Add(element);
+  EXPECT_EQ(2, list.Length());
+}
+
+TEST_CASE(ObjectGraphCopy_LinkedHashMapWithSharedKeys) {
+  const char* kScriptChars =
+      "class Node {\n"
+      "  var value;\n"
+      "  Node(this.value);\n"
+      "}\n"
+      "makeMap() => {'a': new Node(1), 'b': new Node(2), 3: [4]};\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle map_handle = Dart_Invoke(lib, NewString("makeMap"), 0, NULL);
+  EXPECT_VALID(map_handle);
+
+  TransitionNativeToVM transition(thread);
+  const LinkedHashMap& map = LinkedHashMap::Handle(
+      LinkedHashMap::RawCast(Api::UnwrapHandle(map_handle)));
+  Object& copy = Object::Handle();
+  {
+    ObjectGraphCopier copier(thread);
+    EXPECT(copier.Copy(map, &copy));
+  }
+  EXPECT(copy.IsLinkedHashMap());
+  EXPECT(copy.raw() != map.raw());
+  const LinkedHashMap& map_copy = LinkedHashMap::Cast(copy);
+  EXPECT_EQ(map.hash_mask(), map_copy.hash_mask());
+  EXPECT_EQ(map.used_data(), map_copy.used_data());
+  EXPECT_EQ(map.deleted_keys(), map_copy.deleted_keys());
+
+  // All keys are shared, so the index is still valid and copied as is.
+  const TypedData& index = TypedData::Handle(map.index());
+  const TypedData& index_copy = TypedData::Handle(map_copy.index());
+  EXPECT(!index.IsNull());
+  EXPECT(index_copy.raw() != index.raw());
+  EXPECT_EQ(index.LengthInBytes(), index_copy.LengthInBytes());
+  {
+    NoSafepointScope no_safepoint;
+    EXPECT_EQ(0, memcmp(index.DataAddr(0), index_copy.DataAddr(0),
+                        index.LengthInBytes()));
+  }
+
+  // The keys are shared and the values copied.
+  const Array& data = Array::Handle(map.data());
+  const Array& data_copy = Array::Handle(map_copy.data());
+  EXPECT(data_copy.raw() != data.raw());
+  const intptr_t used_data = Smi::Value(map.used_data());
+  EXPECT_EQ(6, used_data);
+  for (intptr_t i = 0; i < used_data; i += 2) {
+    EXPECT_EQ(data.At(i), data_copy.At(i));
+    EXPECT(data.At(i + 1) != data_copy.At(i + 1));
+  }
+}
+
+TEST_CASE(ObjectGraphCopy_LinkedHashMapWithCopiedKeys) {
+  // A key which is copied gets a new identity hash code, so the map cannot be
+  // copied without rehashing it.
+  const char* kScriptChars = "makeMap() => {[1]: 2};\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle map_handle = Dart_Invoke(lib, NewString("makeMap"), 0, NULL);
+  EXPECT_VALID(map_handle);
+
+  TransitionNativeToVM transition(thread);
+  const Object& map = Object::Handle(Api::UnwrapHandle(map_handle));
+  EXPECT(map.IsLinkedHashMap());
+  Object& copy = Object::Handle();
+  ObjectGraphCopier copier(thread);
+  EXPECT(!copier.Copy(map, &copy));
+}
+
+TEST_CASE(ObjectGraphCopy_Instances) {
+  const char* kScriptChars =
+      "class Node {\n"
+      "  var value;\n"
+      "  var next;\n"
+      "  Node(this.value, this.next);\n"
+      "}\n"
+      "makeNodes() {\n"
+      "  var first = new Node(1, null);\n"
+      "  first.next = new Node([2], first);\n"
+      "  return first;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle first = Dart_Invoke(lib, NewString("makeNodes"), 0, NULL);
+  EXPECT_VALID(first);
+
+  Dart_Handle first_copy;
+  {
+    TransitionNativeToVM transition(thread);
+    const Object& original = Object::Handle(Api::UnwrapHandle(first));
+    Object& copy = Object::Handle();
+    ObjectGraphCopier copier(thread);
+    EXPECT(copier.Copy(original, &copy));
+    EXPECT(copy.IsInstance());
+    EXPECT_EQ(original.GetClassId(), copy.GetClassId());
+    first_copy = Api::NewHandle(thread, copy.raw());
+  }
+  EXPECT(!Dart_IdentityEquals(first, first_copy));
+
+  int64_t value = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(
+      Dart_GetField(first_copy, NewString("value")), &value));
+  EXPECT_EQ(1, value);
+
+  // The cycle points to the copy.
+  Dart_Handle second = Dart_GetField(first, NewString("next"));
+  Dart_Handle second_copy = Dart_GetField(first_copy, NewString("next"));
+  EXPECT_VALID(second_copy);
+  EXPECT(!Dart_IdentityEquals(second, second_copy));
+  EXPECT(Dart_IdentityEquals(first_copy,
+                             Dart_GetField(second_copy, NewString("next"))));
+
+  // Mutable field values are copied as well.
+  Dart_Handle list = Dart_GetField(second, NewString("value"));
+  Dart_Handle list_copy = Dart_GetField(second_copy, NewString("value"));
+  EXPECT(Dart_IsList(list_copy));
+  EXPECT(!Dart_IdentityEquals(list, list_copy));
+  EXPECT_VALID(Dart_IntegerToInt64(Dart_ListGetAt(list_copy, 0), &value));
+  EXPECT_EQ(2, value);
+}
+
+ISOLATE_UNIT_TEST_CASE(ObjectGraphCopy_Unsupported) {
+  // External typed data can only be sent in a message snapshot.
+  uint8_t data[] = {1, 2, 3};
+  const ExternalTypedData& external = ExternalTypedData::Handle(
+      ExternalTypedData::New(kExternalTypedDataUint8ArrayCid, data, 3));
+  const Array& array = Array::Handle(Array::New(1));
+  array.SetAt(0, external);
+
+  Object& copy = Object::Handle();
+  ObjectGraphCopier copier(thread);
+  EXPECT(!copier.Copy(array, &copy));
+}
+
+}  // namespace dart
@@ -17,10 +17,89 @@
 namespace dart {
 
 Mutex* PortMap::mutex_ = NULL;
+Monitor* PortMap::lookups_monitor_ = nullptr;
+std::atomic<intptr_t> PortMap::waiting_for_lookups_ = {0};
 PortSet<PortMap::Entry>* PortMap::ports_ = NULL;
 MessageHandler* PortMap::deleted_entry_ = reinterpret_cast<MessageHandler*>(1);
+std::atomic<PortMap::LookupTable*> PortMap::lookup_table_ = {nullptr};
+std::atomic<intptr_t> PortMap::lookup_epoch_ = {0};
+PortMap::LookupCounter PortMap::lookup_counters_[2][kNumLookupCounters] = {};
 Random* PortMap::prng_ = NULL;
 
+// An open addressing hash table from ports to their handlers, which is read
+// without holding [PortMap::mutex_]. A slot is never reused for another port:
+// removing a port only marks its slot deleted, and the table is replaced by a
+// new one when it runs out of free slots. A lookup of a port therefore never
+// returns the handler of another port.
+struct PortMap::LookupTable {
+  struct Slot {
+    std::atomic<Dart_Port> port;
+    std::atomic<MessageHandler*> handler;
+  };
+
+  static const intptr_t kMinCapacity = 8;
+
+  explicit LookupTable(intptr_t capacity)
+      : capacity(capacity), used(0), slots(new Slot[capacity]) {
+    ASSERT(Utils::IsPowerOfTwo(capacity));
+    for (intptr_t i = 0; i < capacity; i++) {
+      slots[i].port.store(PortSet<Entry>::kFreePort, std::memory_order_relaxed);
+      slots[i].handler.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+  ~LookupTable() { delete[] slots; }
+
+  void Insert(Dart_Port port, MessageHandler* handler) {
+    const intptr_t mask = capacity - 1;
+    intptr_t i = port & mask;
+    while (slots[i].port.load(std::memory_order_relaxed) !=
+           PortSet<Entry>::kFreePort) {
+      i = (i + 1) & mask;
+    }
+    // The handler is stored before the port, so that a lookup which finds
+    // the port also finds its handler.
+    slots[i].handler.store(handler, std::memory_order_release);
+    slots[i].port.store(port, std::memory_order_release);
+    used++;
+  }
+
+  const intptr_t capacity;
+  // The number of slots that are not free, including deleted ones.
+  intptr_t used;
+  Slot* const slots;
+
+  DISALLOW_COPY_AND_ASSIGN(LookupTable);
+};
+
+// Counts a thread as looking up ports, until the scope is left.
+class PortMap::LookupScope : public ValueObject {
+ public:
+  LookupScope() {
+    const uword thread_id =
+        OSThread::ThreadIdToIntPtr(OSThread::GetCurrentThreadId());
+    const intptr_t index = Utils::WordHash(thread_id) % kNumLookupCounters;
+    while (true) {
+      const intptr_t epoch = lookup_epoch_.load(std::memory_order_relaxed);
+      counter_ = &lookup_counters_[epoch & 1][index].count;
+      counter_->fetch_add(1, std::memory_order_relaxed);
+      // Orders the increment before the loads of the lookup, and pairs with
+      // the fence in WaitForLookups: either the writer sees the increment, or
+      // the lookup sees the changes made before the epoch was flipped.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (lookup_epoch_.load(std::memory_order_relaxed) == epoch) {
+        break;
+      }
+      LookupDone(counter_);
+    }
+  }
+  ~LookupScope() { LookupDone(counter_); }
+
+ private:
+  std::atomic<intptr_t>* counter_;
+
+  DISALLOW_COPY_AND_ASSIGN(LookupScope);
+};
+
 const char* PortMap::PortStateString(PortState kind) {
   switch (kind) {
     case kNewPort:
@@ -107,6 +186,7 @@ Dart_Port PortMap::CreatePort(MessageHandler* handler) {
   entry.handler = handler;
   entry.state = kNewPort;
   ports_->Insert(entry);
+  AddLookupEntry(port, handler);
 
   if (FLAG_trace_isolates) {
     OS::PrintErr(
@@ -119,6 +199,100 @@ Dart_Port PortMap::CreatePort(MessageHandler* handler) {
   return entry.port;
 }
 
+MessageHandler* PortMap::LookupHandler(Dart_Port port) {
+  LookupTable* table = lookup_table_.load(std::memory_order_acquire);
+  const intptr_t mask = table->capacity - 1;
+  for (intptr_t i = port & mask;; i = (i + 1) & mask) {
+    LookupTable::Slot* slot = &table->slots[i];
+    const Dart_Port slot_port = slot->port.load(std::memory_order_acquire);
+    if (slot_port == port) {
+      // Null if the port has been removed.
+      return slot->handler.load(std::memory_order_acquire);
+    }
+    if (slot_port == PortSet<Entry>::kFreePort) {
+      return nullptr;
+    }
+  }
+}
+
+void PortMap::AddLookupEntry(Dart_Port port, MessageHandler* handler) {
+  ASSERT(mutex_->IsOwnedByCurrentThread());
+  LookupTable* table = lookup_table_.load(std::memory_order_relaxed);
+  if ((table->used + 1) * 4 > table->capacity * 3) {
+    // Rebuild the table without the deleted slots, growing it if most of the
+    // slots are in use by open ports. The new table is filled before it is
+    // published, and the old one is freed once no lookup can still use it.
+    intptr_t num_ports = 0;
+    for (auto it = ports_->begin(); it != ports_->end(); ++it) {
+      num_ports++;
+    }
+    intptr_t capacity = LookupTable::kMinCapacity;
+    while ((num_ports + 1) * 2 > capacity) {
+      capacity *= 2;
+    }
+    LookupTable* old_table = table;
+    table = new LookupTable(capacity);
+    for (auto it = ports_->begin(); it != ports_->end(); ++it) {
+      if ((*it).port != port) {
+        table->Insert((*it).port, (*it).handler);
+      }
+    }
+    lookup_table_.store(table, std::memory_order_release);
+    WaitForLookups();
+    delete old_table;
+  }
+  table->Insert(port, handler);
+}
+
+void PortMap::RemoveLookupEntry(Dart_Port port) {
+  ASSERT(mutex_->IsOwnedByCurrentThread());
+  LookupTable* table = lookup_table_.load(std::memory_order_relaxed);
+  const intptr_t mask = table->capacity - 1;
+  for (intptr_t i = port & mask;; i = (i + 1) & mask) {
+    LookupTable::Slot* slot = &table->slots[i];
+    const Dart_Port slot_port = slot->port.load(std::memory_order_relaxed);
+    if (slot_port == port) {
+      // The slot keeps the port, so that it is not reused for another port
+      // while a lookup may still be probing the table.
+      slot->handler.store(nullptr, std::memory_order_release);
+      return;
+    }
+    ASSERT(slot_port != PortSet<Entry>::kFreePort);
+  }
+}
+
+void PortMap::LookupDone(std::atomic<intptr_t>* counter) {
+  // Pairs with the increment of [waiting_for_lookups_] in WaitForLookups:
+  // either the last lookup of an epoch sees the waiter and wakes it up, or
+  // the waiter sees the counter drop to zero before it waits.
+  if ((counter->fetch_sub(1) == 1) && (waiting_for_lookups_.load() > 0)) {
+    MonitorLocker ml(lookups_monitor_);
+    ml.NotifyAll();
+  }
+}
+
+void PortMap::WaitForLookups() {
+  ASSERT(mutex_->IsOwnedByCurrentThread());
+  const intptr_t old_epoch = lookup_epoch_.load(std::memory_order_relaxed);
+  lookup_epoch_.store(old_epoch + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  // Lookups started after the flip count in the new epoch and see the changes
+  // made so far. Block until the ones that count in the old epoch are done,
+  // rather than spinning while other threads wait for [mutex_].
+  waiting_for_lookups_.fetch_add(1);
+  {
+    MonitorLocker ml(lookups_monitor_);
+    for (intptr_t i = 0; i < kNumLookupCounters; i++) {
+      std::atomic<intptr_t>* counter =
+          &lookup_counters_[old_epoch & 1][i].count;
+      while (counter->load() != 0) {
+        ml.Wait();
+      }
+    }
+  }
+  waiting_for_lookups_.fetch_sub(1);
+}
+
 bool PortMap::ClosePort(Dart_Port port) {
   MessageHandler* handler = NULL;
   {
@@ -150,6 +324,13 @@ bool PortMap::ClosePort(Dart_Port port) {
     ASSERT(isolate_it != handler->ports_.end());
     isolate_it.Delete();
     handler->ports_.Rebalance();
+
+    RemoveLookupEntry(port);
+    if (!handler->HasLivePorts() && handler->OwnedByPortMap()) {
+      // The handler is deleted below once it has no live ports, so wait for
+      // messages that are still being posted to it.
+      WaitForLookups();
+    }
   }
   handler->ClosePort(port);
   if (!handler->HasLivePorts() && handler->OwnedByPortMap()) {
@@ -174,61 +355,75 @@ void PortMap::ClosePorts(MessageHandler* handler) {
       if (entry.state == kLivePort) {
         handler->decrement_live_ports();
       }
+      RemoveLookupEntry(entry.port);
       it.Delete();
       isolate_it.Delete();
     }
     ASSERT(handler->ports_.IsEmpty());
     ports_->Rebalance();
+    // The handler may be deleted once its ports are closed.
+    WaitForLookups();
   }
   handler->CloseAllPorts();
 }
 
 bool PortMap::PostMessage(std::unique_ptr<Message> message,
                           bool before_events) {
-  MutexLocker ml(mutex_);
-  auto it = ports_->TryLookup(message->dest_port());
-  if (it == ports_->end()) {
+  LookupScope scope;
+  MessageHandler* handler = LookupHandler(message->dest_port());
+  if (handler == nullptr) {
     // Ownership of external data remains with the poster.
     message->DropFinalizers();
     return false;
   }
-  MessageHandler* handler = (*it).handler;
-  ASSERT(handler != nullptr);
   handler->PostMessage(std::move(message), before_events);
   return true;
 }
 
+bool PortMap::PostMessages(Dart_Port id,
+                           std::unique_ptr<Message>* messages,
+                           intptr_t num_messages) {
+  LookupScope scope;
+  MessageHandler* handler = LookupHandler(id);
+  if (handler == nullptr) {
+    // Ownership of external data remains with the poster.
+    for (intptr_t i = 0; i < num_messages; i++) {
+      messages[i]->DropFinalizers();
+    }
+    return false;
+  }
+  handler->PostMessages(messages, num_messages);
+  return true;
+}
+
 bool PortMap::IsLocalPort(Dart_Port id) {
-  MutexLocker ml(mutex_);
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  LookupScope scope;
+  MessageHandler* handler = LookupHandler(id);
+  if (handler == nullptr) {
     // Port does not exist.
     return false;
   }
-
-  MessageHandler* handler = (*it).handler;
-  ASSERT(handler != nullptr);
   return handler->IsCurrentIsolate();
 }
 
 Isolate* PortMap::GetIsolate(Dart_Port id) {
-  MutexLocker ml(mutex_);
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  LookupScope scope;
+  MessageHandler* handler = LookupHandler(id);
+  if (handler == nullptr) {
     // Port does not exist.
     return nullptr;
   }
-
-  MessageHandler* handler = (*it).handler;
   return handler->isolate();
 }
 
 bool PortMap::IsReceiverInThisIsolateGroup(Dart_Port receiver,
                                            IsolateGroup* group) {
-  MutexLocker ml(mutex_);
-  auto it = ports_->TryLookup(receiver);
-  if (it == ports_->end()) return false;
-  return (*it).handler->isolate()->group() == group;
+  LookupScope scope;
+  MessageHandler* handler = LookupHandler(receiver);
+  if (handler == nullptr) return false;
+  // Native ports have no isolate.
+  Isolate* isolate = handler->isolate();
+  return isolate != nullptr && isolate->group() == group;
 }
 
 void PortMap::Init() {
@@ -237,17 +432,31 @@ void PortMap::Init() {
     mutex_ = new Mutex();
   }
   ASSERT(mutex_ != NULL);
+  if (lookups_monitor_ == nullptr) {
+    lookups_monitor_ = new Monitor();
+  }
   if (prng_ == nullptr) {
     prng_ = new Random();
   }
   if (ports_ == nullptr) {
     ports_ = new PortSet<Entry>();
   }
+  if (lookup_table_.load(std::memory_order_relaxed) == nullptr) {
+    lookup_table_.store(new LookupTable(LookupTable::kMinCapacity),
+                        std::memory_order_release);
+  }
 }
 
 void PortMap::Cleanup() {
   ASSERT(ports_ != nullptr);
   ASSERT(prng_ != NULL);
+  {
+    MutexLocker ml(mutex_);
+    for (auto it = ports_->begin(); it != ports_->end(); ++it) {
+      RemoveLookupEntry((*it).port);
+    }
+    WaitForLookups();
+  }
   for (auto it = ports_->begin(); it != ports_->end(); ++it) {
     const auto& entry = *it;
     ASSERT(entry.handler != nullptr);
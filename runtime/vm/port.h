@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_PORT_H_
 #define RUNTIME_VM_PORT_H_
 
+#include <atomic>
 #include <memory>
 
 #include "include/dart_api.h"
@@ -19,6 +20,7 @@ namespace dart {
 class Isolate;
 class Message;
 class MessageHandler;
+class Monitor;
 class Mutex;
 class PortMapTestPeer;
 
@@ -52,6 +54,15 @@ class PortMap : public AllStatic {
   static bool PostMessage(std::unique_ptr<Message> message,
                           bool before_events = false);
 
+  // Enqueues several normal messages in the port with id at once. Returns
+  // false if the port is not active any longer, in which case none of the
+  // messages are enqueued.
+  //
+  // Claims ownership of 'messages'.
+  static bool PostMessages(Dart_Port id,
+                           std::unique_ptr<Message>* messages,
+                           intptr_t num_messages);
+
   // Returns whether a port is local to the current isolate.
   static bool IsLocalPort(Dart_Port id);
 
@@ -87,12 +98,44 @@ class PortMap : public AllStatic {
   static bool IsActivePort(Dart_Port id);
   static bool IsLivePort(Dart_Port id);
 
+  // Posting a message and the other lookups of a port do not take [mutex_].
+  // They find the handler of the port in [lookup_table_] from within a
+  // [LookupScope]. The table is only modified with [mutex_] held, and
+  // [WaitForLookups] is used to wait for the lookups that may still see a
+  // replaced table or a closed port, before the table is freed or the
+  // handler of the port may be deleted.
+  class LookupScope;
+  struct LookupTable;
+
+  static MessageHandler* LookupHandler(Dart_Port port);
+  static void AddLookupEntry(Dart_Port port, MessageHandler* handler);
+  static void RemoveLookupEntry(Dart_Port port);
+  static void LookupDone(std::atomic<intptr_t>* counter);
+  static void WaitForLookups();
+
+  // Lookups are counted in one of several counters, picked by thread, to
+  // avoid contention between threads posting messages.
+  static const intptr_t kNumLookupCounters = 16;
+  struct alignas(64) LookupCounter {
+    std::atomic<intptr_t> count;
+  };
+
   // Lock protecting access to the port map.
   static Mutex* mutex_;
 
   static PortSet<Entry>* ports_;
   static MessageHandler* deleted_entry_;
 
+  static std::atomic<LookupTable*> lookup_table_;
+  // Lookups are counted in the counters of the current epoch. WaitForLookups
+  // starts a new epoch and waits for the counters of the old one to drain.
+  static std::atomic<intptr_t> lookup_epoch_;
+  static LookupCounter lookup_counters_[2][kNumLookupCounters];
+  // WaitForLookups blocks on this monitor, and is woken up by the last lookup
+  // of the old epoch if [waiting_for_lookups_] is set.
+  static Monitor* lookups_monitor_;
+  static std::atomic<intptr_t> waiting_for_lookups_;
+
   static Random* prng_;
 };
 
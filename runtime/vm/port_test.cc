@@ -182,4 +182,71 @@ TEST_CASE(PortMap_PostMessageClosedPort) {
                    message_len, nullptr, Message::kNormalPriority)));
 }
 
+class ConcurrentPostMessageHandler : public MessageHandler {
+ public:
+  ConcurrentPostMessageHandler() : notify_count(0) {}
+
+  void MessageNotify(Message::Priority priority) { notify_count.fetch_add(1); }
+
+  MessageStatus HandleMessage(std::unique_ptr<Message> message) { return kOK; }
+
+  RelaxedAtomic<intptr_t> notify_count;
+};
+
+struct PostMessageSender {
+  Dart_Port port;
+  intptr_t count;
+  RelaxedAtomic<intptr_t>* posted;
+  Monitor* monitor;
+  intptr_t* running;
+};
+
+static void PostMessageSenderMain(uword param) {
+  PostMessageSender* sender = reinterpret_cast<PostMessageSender*>(param);
+  for (intptr_t i = 0; i < sender->count; i++) {
+    std::unique_ptr<Message> message =
+        Message::New(sender->port, Smi::New(i), Message::kNormalPriority);
+    if (PortMap::PostMessage(std::move(message))) {
+      sender->posted->fetch_add(1);
+    }
+  }
+  MonitorLocker ml(sender->monitor);
+  (*sender->running)--;
+  ml.Notify();
+}
+
+// Closing ports waits for the lookups of other threads that are posting
+// messages at the same time, without holding them up indefinitely.
+TEST_CASE(PortMap_PostMessagesWhileClosingPorts) {
+  const intptr_t kNumSenders = 4;
+  const intptr_t kMessagesPerSender = 2000;
+  ConcurrentPostMessageHandler handler;
+  const Dart_Port port = PortMap::CreatePort(&handler);
+  RelaxedAtomic<intptr_t> posted(0);
+  Monitor monitor;
+  intptr_t running = kNumSenders;
+  PostMessageSender senders[kNumSenders];
+  for (intptr_t i = 0; i < kNumSenders; i++) {
+    senders[i] = {port, kMessagesPerSender, &posted, &monitor, &running};
+    OSThread::Start("PostMessageSender", PostMessageSenderMain,
+                    reinterpret_cast<uword>(&senders[i]));
+  }
+  // Each round rebuilds the lookup table or closes ports, both of which wait
+  // for the lookups of the senders.
+  PortTestMessageHandler other_handler;
+  while (true) {
+    {
+      MonitorLocker ml(&monitor);
+      if (running == 0) break;
+    }
+    for (intptr_t i = 0; i < 16; i++) {
+      PortMap::CreatePort(&other_handler);
+    }
+    PortMap::ClosePorts(&other_handler);
+  }
+  EXPECT_EQ(kNumSenders * kMessagesPerSender, posted.load());
+  EXPECT_EQ(kNumSenders * kMessagesPerSender, handler.notify_count.load());
+  PortMap::ClosePorts(&handler);
+}
+
 }  // namespace dart
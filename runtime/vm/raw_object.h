@@ -699,6 +699,7 @@ class ObjectLayout {
   friend class Simulator;
   friend class SimulatorHelpers;
   friend class ObjectLocator;
+  friend class ObjectGraphCopier;  // StorePointer
   friend class WriteBarrierUpdateVisitor;  // CheckHeapPointerStore
   friend class OffsetsTable;
   friend class Object;
@@ -2623,6 +2624,7 @@ class ArrayLayout : public InstanceLayout {
   friend class ImmutableArrayLayout;
   friend class SnapshotReader;
   friend class GrowableObjectArray;
+  friend class GrowableObjectArrayLayout;
   friend class LinkedHashMap;
   friend class LinkedHashMapLayout;
   friend class Object;
@@ -1080,11 +1080,18 @@ GrowableObjectArrayPtr GrowableObjectArray::ReadFrom(SnapshotReader* reader,
                      reader->TypeArgumentsHandle()->raw());
 
   // Read length of growable array object.
-  array.SetLength(reader->ReadSmiValue());
+  const intptr_t len = reader->ReadSmiValue();
 
-  // Read the backing array of growable array object.
-  *(reader->ArrayHandle()) ^= reader->ReadObjectImpl(kAsReference);
-  array.SetData(*(reader->ArrayHandle()));
+  // Read the elements into a backing array without unused capacity.
+  if (len > 0) {
+    const Array& data = Array::ZoneHandle(reader->zone(), Array::New(len));
+    array.SetData(data);
+    array.SetLength(len);
+    for (intptr_t i = 0; i < len; i++) {
+      *reader->PassiveObjectHandle() = reader->ReadObjectImpl(kAsReference);
+      data.SetAt(i, *reader->PassiveObjectHandle());
+    }
+  }
 
   return array.raw();
 }
@@ -1108,8 +1115,13 @@ void GrowableObjectArrayLayout::WriteTo(SnapshotWriter* writer,
   // Write out the used length field.
   writer->Write<ObjectPtr>(length_);
 
-  // Write out the Array object.
-  writer->WriteObjectImpl(data_, kAsReference);
+  // Write out the used elements in place of the backing array, which saves
+  // its header and unused capacity and lets the reader fill the list in one
+  // pass.
+  const intptr_t len = Smi::Value(length_);
+  for (intptr_t i = 0; i < len; i++) {
+    writer->WriteObjectImpl(data_->ptr()->data()[i], kAsReference);
+  }
 }
 
 LinkedHashMapPtr LinkedHashMap::ReadFrom(SnapshotReader* reader,
@@ -0,0 +1,235 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/shared_ring_buffer.h"
+
+#include "platform/utils.h"
+#include "vm/lockers.h"
+#include "vm/message.h"
+#include "vm/object.h"
+#include "vm/os_thread.h"
+#include "vm/port.h"
+#include "vm/random.h"
+
+namespace dart {
+
+Mutex* SharedRingBuffer::tickets_mutex_ = new Mutex();
+MallocGrowableArray<SharedRingBuffer::Ticket>* SharedRingBuffer::tickets_ =
+    new MallocGrowableArray<SharedRingBuffer::Ticket>();
+Random* SharedRingBuffer::ticket_prng_ = nullptr;
+
+SharedRingBuffer* SharedRingBuffer::New(intptr_t record_size,
+                                        intptr_t capacity) {
+  if (record_size <= 0 || record_size > kMaxRecordSize || capacity <= 0 ||
+      capacity > kMaxCapacity) {
+    return nullptr;
+  }
+  capacity = Utils::RoundUpToPowerOfTwo(capacity);
+  // Every slot starts with its sequence number, followed by the record.
+  const intptr_t slot_size = Utils::RoundUp(
+      sizeof(std::atomic<uintptr_t>) + record_size, sizeof(uintptr_t));
+  // The largest buffers do not fit in the address space of 32-bit targets.
+  if (capacity > kIntptrMax / slot_size) {
+    return nullptr;
+  }
+  uint8_t* slots = reinterpret_cast<uint8_t*>(malloc(capacity * slot_size));
+  if (slots == nullptr) {
+    return nullptr;
+  }
+  return new SharedRingBuffer(record_size, capacity, slot_size, slots);
+}
+
+SharedRingBuffer::SharedRingBuffer(intptr_t record_size,
+                                   intptr_t capacity,
+                                   intptr_t slot_size,
+                                   uint8_t* slots)
+    : record_size_(record_size),
+      mask_(capacity - 1),
+      slot_size_(slot_size),
+      slots_(slots),
+      ref_count_(1),
+      tail_(0),
+      head_(0),
+      not_empty_doorbell_(ILLEGAL_PORT),
+      not_full_doorbell_(ILLEGAL_PORT) {
+  // The slot at position i is free for the producer of position i.
+  for (intptr_t i = 0; i < capacity; i++) {
+    new (SequenceAt(i)) std::atomic<uintptr_t>(i);
+  }
+}
+
+SharedRingBuffer::~SharedRingBuffer() {
+  free(slots_);
+}
+
+void SharedRingBuffer::Retain() {
+  ref_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SharedRingBuffer::Release() {
+  if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete this;
+  }
+}
+
+void SharedRingBuffer::Detach() {
+  // The isolate may have been the only producer or consumer a waiter was
+  // waiting for.
+  Ring(&not_empty_doorbell_);
+  Ring(&not_full_doorbell_);
+  Release();
+}
+
+intptr_t SharedRingBuffer::Length() const {
+  const uintptr_t head = head_.load(std::memory_order_relaxed);
+  const uintptr_t tail = tail_.load(std::memory_order_relaxed);
+  const intptr_t length = static_cast<intptr_t>(tail - head);
+  if (length < 0) {
+    return 0;
+  }
+  return Utils::Minimum(length, capacity());
+}
+
+bool SharedRingBuffer::TryPush(const void* record) {
+  uintptr_t position = tail_.load(std::memory_order_relaxed);
+  while (true) {
+    const uintptr_t sequence =
+        SequenceAt(position)->load(std::memory_order_acquire);
+    const intptr_t difference = static_cast<intptr_t>(sequence - position);
+    if (difference == 0) {
+      if (tail_.compare_exchange_weak(position, position + 1,
+                                      std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      // The consumer of the previous round has not popped the slot yet.
+      return false;
+    } else {
+      position = tail_.load(std::memory_order_relaxed);
+    }
+  }
+  memmove(RecordAt(position), record, record_size_);
+  // The slot now belongs to the consumer of [position].
+  SequenceAt(position)->store(position + 1, std::memory_order_release);
+
+  // Pairs with the fence in Arm, so that either the producer sees the
+  // doorbell or the waiter sees the record.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  Ring(&not_empty_doorbell_);
+  return true;
+}
+
+bool SharedRingBuffer::TryPop(void* record) {
+  uintptr_t position = head_.load(std::memory_order_relaxed);
+  while (true) {
+    const uintptr_t sequence =
+        SequenceAt(position)->load(std::memory_order_acquire);
+    const intptr_t difference =
+        static_cast<intptr_t>(sequence - (position + 1));
+    if (difference == 0) {
+      if (head_.compare_exchange_weak(position, position + 1,
+                                      std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      // The producer of [position] has not pushed the slot yet.
+      return false;
+    } else {
+      position = head_.load(std::memory_order_relaxed);
+    }
+  }
+  memmove(record, RecordAt(position), record_size_);
+  // The slot now belongs to the producer of the next round.
+  SequenceAt(position)->store(position + mask_ + 1,
+                              std::memory_order_release);
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  Ring(&not_full_doorbell_);
+  return true;
+}
+
+void SharedRingBuffer::RingWhenNotEmpty(Dart_Port port) {
+  Arm(&not_empty_doorbell_, port);
+  if (Length() > 0) {
+    Ring(&not_empty_doorbell_);
+  }
+}
+
+void SharedRingBuffer::RingWhenNotFull(Dart_Port port) {
+  Arm(&not_full_doorbell_, port);
+  if (Length() < capacity()) {
+    Ring(&not_full_doorbell_);
+  }
+}
+
+void SharedRingBuffer::Arm(std::atomic<Dart_Port>* doorbell, Dart_Port port) {
+  const Dart_Port replaced = doorbell->exchange(port);
+  if (replaced != ILLEGAL_PORT) {
+    // Let the waiter on the replaced port check the buffer again.
+    PortMap::PostMessage(
+        Message::New(replaced, Object::null(), Message::kNormalPriority));
+  }
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void SharedRingBuffer::Ring(std::atomic<Dart_Port>* doorbell) {
+  if (doorbell->load(std::memory_order_relaxed) == ILLEGAL_PORT) {
+    return;
+  }
+  // Only one of the threads ringing at once sends the message.
+  const Dart_Port port = doorbell->exchange(ILLEGAL_PORT);
+  if (port != ILLEGAL_PORT) {
+    PortMap::PostMessage(
+        Message::New(port, Object::null(), Message::kNormalPriority));
+  }
+}
+
+int64_t SharedRingBuffer::Share() {
+  Retain();
+  MutexLocker ml(tickets_mutex_);
+  if (ticket_prng_ == nullptr) {
+    ticket_prng_ = new Random();
+  }
+  // Tickets are random, so an isolate cannot attach to a buffer it was not
+  // sent a ticket for by guessing one.
+  Ticket ticket;
+  do {
+    ticket.id = static_cast<int64_t>(ticket_prng_->NextUInt64());
+  } while ((ticket.id == 0) || IsTicketInUseLocked(ticket.id));
+  ticket.buffer = this;
+  tickets_->Add(ticket);
+  return ticket.id;
+}
+
+bool SharedRingBuffer::IsTicketInUseLocked(int64_t ticket) {
+  ASSERT(tickets_mutex_->IsOwnedByCurrentThread());
+  for (intptr_t i = 0; i < tickets_->length(); i++) {
+    if ((*tickets_)[i].id == ticket) {
+      return true;
+    }
+  }
+  return false;
+}
+
+SharedRingBuffer* SharedRingBuffer::Attach(int64_t ticket) {
+  MutexLocker ml(tickets_mutex_);
+  for (intptr_t i = 0; i < tickets_->length(); i++) {
+    if ((*tickets_)[i].id == ticket) {
+      SharedRingBuffer* buffer = (*tickets_)[i].buffer;
+      (*tickets_)[i] = tickets_->Last();
+      tickets_->RemoveLast();
+      return buffer;
+    }
+  }
+  return nullptr;
+}
+
+void SharedRingBuffer::Revoke(int64_t ticket) {
+  SharedRingBuffer* buffer = Attach(ticket);
+  if (buffer != nullptr) {
+    buffer->Release();
+  }
+}
+
+}  // namespace dart
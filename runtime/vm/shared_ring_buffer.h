@@ -0,0 +1,129 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_SHARED_RING_BUFFER_H_
+#define RUNTIME_VM_SHARED_RING_BUFFER_H_
+
+#include <atomic>
+
+#include "include/dart_api.h"
+#include "platform/growable_array.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+class Mutex;
+class Random;
+
+// A bounded queue of fixed size records in memory that is shared by all
+// isolates attached to it, so that records can be passed between isolates
+// without sending messages.
+//
+// Records are pushed and popped without locks, by any number of producers and
+// consumers. Every slot has a sequence number that tells whether it is the
+// turn of a producer or a consumer to use the slot (the bounded MPMC queue
+// by D. Vyukov). A doorbell port can be armed to be sent a message once the
+// buffer is no longer empty or no longer full.
+//
+// A buffer is reference counted by the isolates attached to it and by the
+// tickets used to attach other isolates. The tickets that were not used are
+// revoked when the isolate that created them detaches.
+class SharedRingBuffer {
+ public:
+  static const intptr_t kMaxRecordSize = 64 * KB;
+  static const intptr_t kMaxCapacity = 16 * MB;
+
+  // Returns a new buffer with a single reference, or nullptr if
+  // [record_size] or [capacity] is out of range or the buffer does not fit in
+  // memory. The capacity is rounded up to a power of two.
+  static SharedRingBuffer* New(intptr_t record_size, intptr_t capacity);
+
+  void Retain();
+  void Release();
+
+  // Releases the reference of an isolate that no longer uses the buffer, and
+  // rings both doorbells, so that no other isolate waits for it forever.
+  void Detach();
+
+  intptr_t record_size() const { return record_size_; }
+  intptr_t capacity() const { return mask_ + 1; }
+
+  // The number of records in the buffer, which may already have changed by
+  // the time it is returned.
+  intptr_t Length() const;
+
+  // Copies [record_size] bytes from [record] into the buffer. Returns false if
+  // the buffer is full.
+  bool TryPush(const void* record);
+
+  // Copies the oldest record into [record]. Returns false if the buffer is
+  // empty.
+  bool TryPop(void* record);
+
+  // Sends a null message to [port] once the buffer is not empty, or not full.
+  // The message is sent right away if the buffer is already in that state. A
+  // port armed before is sent a message too, when it is replaced.
+  void RingWhenNotEmpty(Dart_Port port);
+  void RingWhenNotFull(Dart_Port port);
+
+  // Returns a ticket with which another isolate can attach to the buffer
+  // once. The ticket holds a reference to the buffer until it is used.
+  int64_t Share();
+
+  // Returns the buffer of [ticket], with the reference that was held by the
+  // ticket, or nullptr if the ticket is unknown or was used already.
+  static SharedRingBuffer* Attach(int64_t ticket);
+
+  // Releases the reference held by [ticket] if it was not used yet.
+  static void Revoke(int64_t ticket);
+
+ private:
+  struct Ticket {
+    int64_t id;
+    SharedRingBuffer* buffer;
+  };
+
+  SharedRingBuffer(intptr_t record_size,
+                   intptr_t capacity,
+                   intptr_t slot_size,
+                   uint8_t* slots);
+  ~SharedRingBuffer();
+
+  std::atomic<uintptr_t>* SequenceAt(uintptr_t position) const {
+    return reinterpret_cast<std::atomic<uintptr_t>*>(
+        slots_ + (position & mask_) * slot_size_);
+  }
+  uint8_t* RecordAt(uintptr_t position) const {
+    return slots_ + (position & mask_) * slot_size_ +
+           sizeof(std::atomic<uintptr_t>);
+  }
+
+  static bool IsTicketInUseLocked(int64_t ticket);
+  static void Ring(std::atomic<Dart_Port>* doorbell);
+  void Arm(std::atomic<Dart_Port>* doorbell, Dart_Port port);
+
+  static Mutex* tickets_mutex_;
+  static MallocGrowableArray<Ticket>* tickets_;
+  static Random* ticket_prng_;
+
+  const intptr_t record_size_;
+  const uintptr_t mask_;
+  const intptr_t slot_size_;
+  uint8_t* const slots_;
+  std::atomic<intptr_t> ref_count_;
+
+  // Producers and consumers claim positions on separate cache lines.
+  alignas(64) std::atomic<uintptr_t> tail_;
+  alignas(64) std::atomic<uintptr_t> head_;
+
+  alignas(64) std::atomic<Dart_Port> not_empty_doorbell_;
+  std::atomic<Dart_Port> not_full_doorbell_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedRingBuffer);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_SHARED_RING_BUFFER_H_
@@ -0,0 +1,141 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/shared_ring_buffer.h"
+#include "platform/assert.h"
+#include "vm/lockers.h"
+#include "vm/os_thread.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+VM_UNIT_TEST_CASE(SharedRingBuffer_PushPop) {
+  EXPECT(SharedRingBuffer::New(0, 4) == nullptr);
+  EXPECT(SharedRingBuffer::New(8, 0) == nullptr);
+
+  // The capacity is rounded up to a power of two.
+  SharedRingBuffer* buffer = SharedRingBuffer::New(3, 3);
+  EXPECT_EQ(3, buffer->record_size());
+  EXPECT_EQ(4, buffer->capacity());
+
+  uint8_t record[3];
+  EXPECT(!buffer->TryPop(record));
+  for (uint8_t i = 0; i < 4; i++) {
+    uint8_t pushed[3] = {i, static_cast<uint8_t>(i + 1), 42};
+    EXPECT(buffer->TryPush(pushed));
+  }
+  EXPECT_EQ(4, buffer->Length());
+  EXPECT(!buffer->TryPush(record));
+  for (uint8_t i = 0; i < 4; i++) {
+    EXPECT(buffer->TryPop(record));
+    EXPECT_EQ(i, record[0]);
+    EXPECT_EQ(i + 1, record[1]);
+    EXPECT_EQ(42, record[2]);
+  }
+  EXPECT_EQ(0, buffer->Length());
+  EXPECT(!buffer->TryPop(record));
+  buffer->Release();
+}
+
+VM_UNIT_TEST_CASE(SharedRingBuffer_Tickets) {
+  SharedRingBuffer* buffer = SharedRingBuffer::New(8, 8);
+  const int64_t ticket = buffer->Share();
+  EXPECT(SharedRingBuffer::Attach(ticket + 1) == nullptr);
+  EXPECT(SharedRingBuffer::Attach(ticket) == buffer);
+  // A ticket can only be used once.
+  EXPECT(SharedRingBuffer::Attach(ticket) == nullptr);
+  // A ticket that was not used yet can be revoked.
+  const int64_t revoked = buffer->Share();
+  SharedRingBuffer::Revoke(revoked);
+  EXPECT(SharedRingBuffer::Attach(revoked) == nullptr);
+  // Tickets cannot be guessed from the ones handed out before.
+  EXPECT_NE(0, revoked);
+  EXPECT(revoked != ticket + 1);
+  // Both the creator and the attached isolate release their reference.
+  buffer->Release();
+  buffer->Release();
+}
+
+struct RingBufferThreadInfo {
+  SharedRingBuffer* buffer;
+  intptr_t count;
+  intptr_t sum;
+  Monitor* monitor;
+  intptr_t* running;
+  ThreadJoinId join_id;
+};
+
+static void ThreadDone(RingBufferThreadInfo* info) {
+  MonitorLocker ml(info->monitor);
+  info->join_id = OSThread::GetCurrentThreadJoinId(OSThread::Current());
+  (*info->running)--;
+  ml.Notify();
+}
+
+static void PushRecords(uword param) {
+  RingBufferThreadInfo* info = reinterpret_cast<RingBufferThreadInfo*>(param);
+  for (intptr_t i = 1; i <= info->count; i++) {
+    while (!info->buffer->TryPush(&i)) {
+    }
+  }
+  ThreadDone(info);
+}
+
+static void PopRecords(uword param) {
+  RingBufferThreadInfo* info = reinterpret_cast<RingBufferThreadInfo*>(param);
+  info->sum = 0;
+  for (intptr_t i = 0; i < info->count; i++) {
+    intptr_t record;
+    while (!info->buffer->TryPop(&record)) {
+    }
+    info->sum += record;
+  }
+  ThreadDone(info);
+}
+
+VM_UNIT_TEST_CASE(SharedRingBuffer_Concurrent) {
+  const intptr_t kNumThreads = 4;
+  const intptr_t kRecordsPerThread = 100000;
+  SharedRingBuffer* buffer = SharedRingBuffer::New(sizeof(intptr_t), 64);
+  Monitor monitor;
+  intptr_t running = 2 * kNumThreads;
+
+  RingBufferThreadInfo producers[kNumThreads];
+  RingBufferThreadInfo consumers[kNumThreads];
+  for (intptr_t i = 0; i < kNumThreads; i++) {
+    RingBufferThreadInfo* infos[] = {&producers[i], &consumers[i]};
+    for (RingBufferThreadInfo* info : infos) {
+      info->buffer = buffer;
+      info->count = kRecordsPerThread;
+      info->sum = 0;
+      info->monitor = &monitor;
+      info->running = &running;
+      info->join_id = OSThread::kInvalidThreadJoinId;
+    }
+    OSThread::Start("PopRecords", PopRecords,
+                    reinterpret_cast<uword>(&consumers[i]));
+    OSThread::Start("PushRecords", PushRecords,
+                    reinterpret_cast<uword>(&producers[i]));
+  }
+  {
+    MonitorLocker ml(&monitor);
+    while (running > 0) {
+      ml.Wait();
+    }
+  }
+
+  // Every record is popped exactly once.
+  intptr_t sum = 0;
+  for (intptr_t i = 0; i < kNumThreads; i++) {
+    OSThread::Join(producers[i].join_id);
+    OSThread::Join(consumers[i].join_id);
+    sum += consumers[i].sum;
+  }
+  EXPECT_EQ(kNumThreads * (kRecordsPerThread * (kRecordsPerThread + 1) / 2),
+            sum);
+  EXPECT_EQ(0, buffer->Length());
+  buffer->Release();
+}
+
+}  // namespace dart
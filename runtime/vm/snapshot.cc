@@ -914,6 +914,7 @@ SnapshotWriter::SnapshotWriter(Thread* thread,
       object_store_(isolate()->object_store()),
       class_table_(isolate()->class_table()),
       forward_list_(forward_list),
+      strings_(),
       exception_type_(Exceptions::kNone),
       exception_msg_(NULL),
       can_send_any_object_(can_send_any_object) {
@@ -1067,6 +1068,34 @@ ForwardList::~ForwardList() {
   isolate()->set_forward_table_old(nullptr);
 }
 
+intptr_t StringObjectIdPairTrait::Hashcode(Key key) {
+  return String::Hash(key);
+}
+
+bool StringObjectIdPairTrait::IsKeyEqual(Pair kv, Key key) {
+  const intptr_t cid = key->GetClassId();
+  const intptr_t length = String::LengthOf(key);
+  if ((kv.string_->GetClassId() != cid) ||
+      (String::LengthOf(kv.string_) != length)) {
+    return false;
+  }
+  intptr_t data_offset;
+  intptr_t data_size;
+  if (cid == kOneByteStringCid) {
+    data_offset = OneByteString::data_offset();
+    data_size = length * OneByteString::kBytesPerElement;
+  } else {
+    ASSERT(cid == kTwoByteStringCid);
+    data_offset = TwoByteString::data_offset();
+    data_size = length * TwoByteString::kBytesPerElement;
+  }
+  return memcmp(reinterpret_cast<const void*>(
+                    ObjectLayout::ToAddr(kv.string_) + data_offset),
+                reinterpret_cast<const void*>(ObjectLayout::ToAddr(key) +
+                                              data_offset),
+                data_size) == 0;
+}
+
 intptr_t ForwardList::AddObject(Zone* zone,
                                 ObjectPtr raw,
                                 SerializeState state) {
@@ -1172,11 +1201,35 @@ bool SnapshotWriter::CheckAndWritePredefinedObject(ObjectPtr rawobj) {
   return false;
 }
 
+static bool IsSharedStringCandidate(ObjectPtr raw) {
+  const intptr_t cid = raw->GetClassId();
+  return ((cid == kOneByteStringCid) || (cid == kTwoByteStringCid)) &&
+         !raw->ptr()->IsCanonical();
+}
+
+bool SnapshotWriter::CheckAndWriteEqualString(ObjectPtr raw) {
+  // Messages often repeat equal strings, for example the keys of a list of
+  // maps decoded from JSON. Write a reference to the first one instead.
+  if ((kind_ != Snapshot::kMessage) || !IsSharedStringCandidate(raw)) {
+    return false;
+  }
+  NoSafepointScope no_safepoint;
+  StringObjectIdPair* pair = strings_.Lookup(static_cast<StringPtr>(raw));
+  if (pair == nullptr) {
+    return false;
+  }
+  WriteIndexedObject(pair->id_);
+  return true;
+}
+
 void SnapshotWriter::WriteObjectImpl(ObjectPtr raw, bool as_reference) {
   // First check if object can be written as a simple predefined type.
   if (CheckAndWritePredefinedObject(raw)) {
     return;
   }
+  if (CheckAndWriteEqualString(raw)) {
+    return;
+  }
 
   // When we know that we are dealing with leaf or shallow objects we write
   // these objects inline even when 'as_reference' is true.
@@ -1194,6 +1247,11 @@ void SnapshotWriter::WriteObjectImpl(ObjectPtr raw, bool as_reference) {
   } else {
     object_id = forward_list_->AddObject(zone(), raw, kIsSerialized);
   }
+  if ((kind_ == Snapshot::kMessage) && IsSharedStringCandidate(raw)) {
+    // Messages are written without safepoints, so the strings do not move.
+    strings_.Insert(
+        StringObjectIdPair(static_cast<StringPtr>(raw), object_id));
+  }
   if (write_as_reference || !IsSplitClassId(class_id)) {
     object_id = kOmittedObjectId;
   }
@@ -15,6 +15,7 @@
 #include "vm/finalizable_data.h"
 #include "vm/globals.h"
 #include "vm/growable_array.h"
+#include "vm/hash_map.h"
 #include "vm/isolate.h"
 #include "vm/message.h"
 #include "vm/visitor.h"
@@ -580,6 +581,31 @@ class ForwardList {
   DISALLOW_COPY_AND_ASSIGN(ForwardList);
 };
 
+class StringObjectIdPair {
+ public:
+  StringObjectIdPair() : string_(nullptr), id_(0) {}
+  StringObjectIdPair(StringPtr string, intptr_t id)
+      : string_(string), id_(id) {}
+  StringPtr string_;
+  intptr_t id_;
+};
+
+// Finds the strings already written to a message by their contents, so that
+// equal strings are written once and shared by the receiver.
+class StringObjectIdPairTrait {
+ public:
+  typedef StringPtr Key;
+  typedef intptr_t Value;
+  typedef StringObjectIdPair Pair;
+
+  static Key KeyOf(Pair kv) { return kv.string_; }
+  static Value ValueOf(Pair kv) { return kv.id_; }
+  static intptr_t Hashcode(Key key);
+  static bool IsKeyEqual(Pair kv, Key key);
+};
+
+typedef DirectChainedHashMap<StringObjectIdPairTrait> StringObjectIdMap;
+
 class SnapshotWriter : public BaseWriter {
  protected:
   SnapshotWriter(Thread* thread,
@@ -624,6 +650,7 @@ class SnapshotWriter : public BaseWriter {
 
  protected:
   bool CheckAndWritePredefinedObject(ObjectPtr raw);
+  bool CheckAndWriteEqualString(ObjectPtr raw);
   bool HandleVMIsolateObject(ObjectPtr raw);
 
   void WriteClassId(ClassLayout* cls);
@@ -659,6 +686,7 @@ class SnapshotWriter : public BaseWriter {
   ObjectStore* object_store_;  // Object store for common classes.
   ClassTable* class_table_;  // Class table for the class index to class lookup.
   ForwardList* forward_list_;
+  StringObjectIdMap strings_;
   Exceptions::ExceptionType exception_type_;  // Exception type.
   const char* exception_msg_;  // Message associated with exception.
   bool can_send_any_object_;   // True if any Dart instance can be sent.
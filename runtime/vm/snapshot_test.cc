@@ -496,6 +496,80 @@ ISOLATE_UNIT_TEST_CASE(SerializeArrayWithTypeArgument) {
   CheckEncodeDecodeMessage(root);
 }
 
+ISOLATE_UNIT_TEST_CASE(SerializeEqualStrings) {
+  // Write snapshot with equal but not identical strings.
+  const int kArrayLength = 4;
+  Array& array = Array::Handle(Array::New(kArrayLength));
+  array.SetAt(0, String::Handle(String::New("key")));
+  array.SetAt(1, String::Handle(String::New("key")));
+  array.SetAt(2, String::Handle(String::New("other")));
+  array.SetAt(3, String::Handle(String::New("key")));
+  MessageWriter writer(true);
+  std::unique_ptr<Message> message =
+      writer.WriteMessage(array, ILLEGAL_PORT, Message::kNormalPriority);
+
+  // Read object back from the snapshot, where equal strings are shared.
+  MessageSnapshotReader reader(message.get(), thread);
+  Array& serialized_array = Array::Handle();
+  serialized_array ^= reader.ReadObject();
+  EXPECT(array.CanonicalizeEquals(serialized_array));
+  EXPECT_EQ(serialized_array.At(0), serialized_array.At(1));
+  EXPECT_EQ(serialized_array.At(0), serialized_array.At(3));
+  EXPECT(serialized_array.At(0) != serialized_array.At(2));
+
+  // Read object back from the snapshot into a C structure.
+  ApiNativeScope scope;
+  ApiMessageReader api_reader(message.get());
+  Dart_CObject* root = api_reader.ReadMessage();
+  EXPECT_EQ(Dart_CObject_kArray, root->type);
+  EXPECT_EQ(kArrayLength, root->value.as_array.length);
+  for (int i = 0; i < kArrayLength; i++) {
+    Dart_CObject* element = root->value.as_array.values[i];
+    EXPECT_EQ(Dart_CObject_kString, element->type);
+    EXPECT_STREQ(i == 2 ? "other" : "key", element->value.as_string);
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(SerializeGrowableArray) {
+  // Write snapshot with a growable array that has unused capacity.
+  const int kArrayLength = 5;
+  GrowableObjectArray& array =
+      GrowableObjectArray::Handle(GrowableObjectArray::New(64));
+  Smi& smi = Smi::Handle();
+  for (int i = 0; i < kArrayLength; i++) {
+    smi ^= Smi::New(i);
+    array.Add(smi);
+  }
+  array.Add(array);
+  MessageWriter writer(true);
+  std::unique_ptr<Message> message =
+      writer.WriteMessage(array, ILLEGAL_PORT, Message::kNormalPriority);
+
+  // Read object back from the snapshot.
+  MessageSnapshotReader reader(message.get(), thread);
+  GrowableObjectArray& serialized_array = GrowableObjectArray::Handle();
+  serialized_array ^= reader.ReadObject();
+  EXPECT_EQ(kArrayLength + 1, serialized_array.Length());
+  EXPECT_EQ(kArrayLength + 1, serialized_array.Capacity());
+  for (int i = 0; i < kArrayLength; i++) {
+    EXPECT_EQ(Smi::New(i), serialized_array.At(i));
+  }
+  EXPECT_EQ(serialized_array.raw(), serialized_array.At(kArrayLength));
+
+  // Read object back from the snapshot into a C structure.
+  ApiNativeScope scope;
+  ApiMessageReader api_reader(message.get());
+  Dart_CObject* root = api_reader.ReadMessage();
+  EXPECT_EQ(Dart_CObject_kArray, root->type);
+  EXPECT_EQ(kArrayLength + 1, root->value.as_array.length);
+  for (int i = 0; i < kArrayLength; i++) {
+    Dart_CObject* element = root->value.as_array.values[i];
+    EXPECT_EQ(Dart_CObject_kInt32, element->type);
+    EXPECT_EQ(i, element->value.as_int32);
+  }
+  EXPECT_EQ(root, root->value.as_array.values[kArrayLength]);
+}
+
 TEST_CASE(FailSerializeLargeArray) {
   Dart_CObject root;
   root.type = Dart_CObject_kArray;
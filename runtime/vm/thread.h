@@ -1079,7 +1079,8 @@ class Thread : public ThreadState {
   friend class FieldTable;
   friend Isolate* CreateWithinExistingIsolateGroup(IsolateGroup*,
                                                    const char*,
-                                                   char**);
+                                                   char**,
+                                                   bool);
   DISALLOW_COPY_AND_ASSIGN(Thread);
 };
 
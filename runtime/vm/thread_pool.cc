@@ -15,6 +15,12 @@ DEFINE_FLAG(int,
             5000,
             "Free workers when they have been idle for this amount of time.");
 
+// How long a worker that is looking for a task waits before it steals the only
+// task scheduled by a busy worker, which will likely run the task soon, with
+// warm caches. This bounds the time such a task waits if the worker is busy
+// for longer.
+static const int64_t kStealLastTaskDelayMicros = 50;
+
 static int64_t ComputeTimeout(int64_t idle_start) {
   int64_t worker_timeout_micros =
       FLAG_worker_timeout_millis * kMicrosecondsPerMillisecond;
@@ -82,6 +88,17 @@ void ThreadPool::Shutdown() {
 }
 
 bool ThreadPool::RunImpl(std::unique_ptr<Task> task) {
+  auto worker =
+      static_cast<Worker*>(OSThread::Current()->owning_thread_pool_worker_);
+  // A blocked worker will not get to its own tasks soon, so it schedules them
+  // on the pool.
+  if (worker != nullptr && worker->pool_ == this && worker->is_running_ &&
+      !worker->is_blocked_ && task->can_run_on_scheduling_worker() &&
+      task->priority() == Task::kNormalPriority) {
+    RunLocal(worker, std::move(task));
+    return true;
+  }
+
   Worker* new_worker = nullptr;
   {
     MonitorLocker ml(&pool_monitor_);
@@ -96,6 +113,33 @@ bool ThreadPool::RunImpl(std::unique_ptr<Task> task) {
   return true;
 }
 
+void ThreadPool::RunLocal(Worker* worker, std::unique_ptr<Task> task) {
+  pending_local_tasks_++;
+  bool has_other_tasks;
+  {
+    MutexLocker ml(&worker->tasks_mutex_);
+    has_other_tasks = !worker->tasks_.IsEmpty();
+    worker->tasks_.Append(task.release());
+  }
+
+  // The worker runs the task once it is done with the current one. Another
+  // worker is needed right away once there is more than one task to run.
+  // A lone task is stolen by a worker that is already watching the local
+  // queues if the worker is still busy after kStealLastTaskDelayMicros, so a
+  // thief is only woken or started if there is no such worker.
+  if (!has_other_tasks && watching_workers_ > 0) {
+    return;
+  }
+  Worker* new_worker = nullptr;
+  {
+    MonitorLocker ml(&pool_monitor_);
+    new_worker = ScheduleThiefLocked(&ml);
+  }
+  if (new_worker != nullptr) {
+    new_worker->StartThread();
+  }
+}
+
 bool ThreadPool::CurrentThreadIsWorker() {
   auto worker =
       static_cast<Worker*>(OSThread::Current()->owning_thread_pool_worker_);
@@ -112,6 +156,16 @@ void ThreadPool::MarkCurrentWorkerAsBlocked() {
     worker->is_blocked_ = true;
     if (max_pool_size_ > 0) {
       ++max_pool_size_;
+    }
+    // The tasks queued with this worker can be stolen now.
+    bool has_local_tasks = false;
+    if (worker->pool_ == this) {
+      MutexLocker tl(&worker->tasks_mutex_);
+      has_local_tasks = !worker->tasks_.IsEmpty();
+    }
+    if (has_local_tasks) {
+      new_worker = ScheduleThiefLocked(&ml);
+    } else if (max_pool_size_ > 0) {
       // This thread is blocked and therefore no longer usable as a worker.
       // If we have pending tasks and there are no idle workers, we will spawn a
       // new thread (temporarily allow exceeding the maximum pool size) to
@@ -149,23 +203,24 @@ void ThreadPool::WorkerLoop(Worker* worker) {
   while (true) {
     MonitorLocker ml(&pool_monitor_);
 
-    if (!tasks_.IsEmpty()) {
+    std::unique_ptr<Task> task = TakeTaskLocked(&ml, worker);
+    if (task != nullptr) {
       IdleToRunningLocked(worker);
-      while (!tasks_.IsEmpty()) {
-        std::unique_ptr<Task> task(tasks_.RemoveFirst());
-        pending_tasks_--;
-        MonitorLeaveScope mls(&ml);
-        task->Run();
-        ASSERT(Isolate::Current() == nullptr);
-        task.reset();
+      while (task != nullptr) {
+        {
+          MonitorLeaveScope mls(&ml);
+          RunTasks(worker, std::move(task));
+        }
+        task = TakeTaskLocked(&ml, worker);
       }
       RunningToIdleLocked(worker);
     }
 
     if (running_workers_.IsEmpty()) {
-      ASSERT(tasks_.IsEmpty());
+      // Only running workers schedule tasks on their own queue.
+      ASSERT(pending_tasks_ == 0);
       OnEnterIdleLocked(&ml);
-      if (!tasks_.IsEmpty()) {
+      if (pending_tasks_ > 0) {
         continue;
       }
     }
@@ -176,14 +231,34 @@ void ThreadPool::WorkerLoop(Worker* worker) {
       break;
     }
 
-    // Sleep until we get a new task, we time out or we're shutdown.
+    // Sleep until we get a new task, we time out or we're shutdown. While
+    // workers have tasks queued, wake up after kStealLastTaskDelayMicros to
+    // steal the ones that their workers did not get to.
     const int64_t idle_start = OS::GetCurrentMonotonicMicros();
     bool done = false;
     while (!done) {
-      const auto result = ml.WaitMicros(ComputeTimeout(idle_start));
+      // One idle worker is enough to watch the local queues.
+      const bool watch_local_tasks =
+          pending_local_tasks_ > 0 && watching_workers_ == 0;
+      int64_t timeout = ComputeTimeout(idle_start);
+      if (watch_local_tasks) {
+        watching_workers_++;
+        if (timeout == 0 || timeout > kStealLastTaskDelayMicros) {
+          timeout = kStealLastTaskDelayMicros;
+        }
+      }
+      auto result = ml.WaitMicros(timeout);
+      if (watch_local_tasks) {
+        watching_workers_--;
+        if (result == Monitor::kTimedOut &&
+            timeout == kStealLastTaskDelayMicros) {
+          // Only the idle timeout ends the worker.
+          result = Monitor::kNotified;
+        }
+      }
 
       // We have to drain all pending tasks.
-      if (!tasks_.IsEmpty()) break;
+      if (pending_tasks_ > 0 || pending_local_tasks_ > 0) break;
 
       if (shutting_down_ || result == Monitor::kTimedOut) {
         done = true;
@@ -204,16 +279,91 @@ void ThreadPool::WorkerLoop(Worker* worker) {
   JoinDeadWorkersLocked(&dead_workers_to_join);
 }
 
+void ThreadPool::RunTasks(Worker* worker, std::unique_ptr<Task> task) {
+  while (task != nullptr) {
+    task->Run();
+    ASSERT(Isolate::Current() == nullptr);
+    task.reset();
+
+    // Continue with the most recent task scheduled by the tasks run so far,
+    // unless there are more urgent ones.
+    if (pending_high_priority_tasks_ > 0) {
+      break;
+    }
+    MutexLocker ml(&worker->tasks_mutex_);
+    if (!worker->tasks_.IsEmpty()) {
+      task.reset(worker->tasks_.RemoveLast());
+      pending_local_tasks_--;
+    }
+  }
+}
+
+std::unique_ptr<ThreadPool::Task> ThreadPool::TakeTaskLocked(
+    MonitorLocker* ml,
+    Worker* worker) {
+  bool steal_last = false;
+  while (true) {
+    if (!high_priority_tasks_.IsEmpty()) {
+      pending_high_priority_tasks_--;
+      pending_tasks_--;
+      return std::unique_ptr<Task>(high_priority_tasks_.RemoveFirst());
+    }
+    {
+      MutexLocker tl(&worker->tasks_mutex_);
+      if (!worker->tasks_.IsEmpty()) {
+        pending_local_tasks_--;
+        return std::unique_ptr<Task>(worker->tasks_.RemoveLast());
+      }
+    }
+    if (!tasks_.IsEmpty()) {
+      pending_tasks_--;
+      return std::unique_ptr<Task>(tasks_.RemoveFirst());
+    }
+    Task* task = StealTaskLocked(worker, steal_last);
+    if (task != nullptr) {
+      pending_local_tasks_--;
+      return std::unique_ptr<Task>(task);
+    }
+    if (steal_last || pending_local_tasks_ == 0) {
+      return nullptr;
+    }
+    // The remaining tasks are the only ones of their workers. Take them if
+    // their workers are still busy after a while.
+    watching_workers_++;
+    ml->WaitMicros(kStealLastTaskDelayMicros);
+    watching_workers_--;
+    steal_last = true;
+  }
+}
+
+ThreadPool::Task* ThreadPool::StealTaskLocked(Worker* thief, bool steal_last) {
+  // Idle workers have no tasks of their own.
+  for (Worker* worker : running_workers_) {
+    if (worker == thief) continue;
+    MutexLocker ml(&worker->tasks_mutex_);
+    if (worker->tasks_.IsEmpty()) continue;
+    if (steal_last || worker->is_blocked_ ||
+        worker->tasks_.First() != worker->tasks_.Last()) {
+      return worker->tasks_.RemoveFirst();
+    }
+  }
+  return nullptr;
+}
+
 void ThreadPool::IdleToRunningLocked(Worker* worker) {
   ASSERT(idle_workers_.ContainsForDebugging(worker));
   idle_workers_.Remove(worker);
   running_workers_.Append(worker);
   count_idle_--;
   count_running_++;
+  worker->is_running_ = true;
 }
 
 void ThreadPool::RunningToIdleLocked(Worker* worker) {
+  ASSERT(high_priority_tasks_.IsEmpty());
   ASSERT(tasks_.IsEmpty());
+  ASSERT(worker->tasks_.IsEmpty());
+  worker->is_running_ = false;
 
   ASSERT(running_workers_.ContainsForDebugging(worker));
   running_workers_.Remove(worker);
@@ -262,12 +412,21 @@ void ThreadPool::JoinDeadWorkersLocked(WorkerList* dead_workers_to_join) {
 ThreadPool::Worker* ThreadPool::ScheduleTaskLocked(MonitorLocker* ml,
                                                    std::unique_ptr<Task> task) {
   // Enqueue the new task.
-  tasks_.Append(task.release());
+  if (task->priority() == Task::kHighPriority) {
+    high_priority_tasks_.Append(task.release());
+    pending_high_priority_tasks_++;
+  } else {
+    tasks_.Append(task.release());
+  }
   pending_tasks_++;
+  return ScheduleWorkerLocked(ml);
+}
+
+ThreadPool::Worker* ThreadPool::ScheduleWorkerLocked(MonitorLocker* ml) {
   ASSERT(pending_tasks_ >= 1);
 
   // Notify existing idle worker (if available).
-  if (count_idle_ >= pending_tasks_) {
+  if (count_idle_ >= static_cast<uint64_t>(pending_tasks_)) {
     ASSERT(!idle_workers_.IsEmpty());
     ml->Notify();
     return nullptr;
@@ -289,6 +448,20 @@ ThreadPool::Worker* ThreadPool::ScheduleTaskLocked(MonitorLocker* ml,
   return new_worker;
 }
 
+ThreadPool::Worker* ThreadPool::ScheduleThiefLocked(MonitorLocker* ml) {
+  if (!idle_workers_.IsEmpty()) {
+    ml->Notify();
+    return nullptr;
+  }
+  if (max_pool_size_ > 0 && (count_idle_ + count_running_) >= max_pool_size_) {
+    return nullptr;
+  }
+  auto new_worker = new Worker(this);
+  idle_workers_.Append(new_worker);
+  count_idle_++;
+  return new_worker;
+}
+
 ThreadPool::Worker::Worker(ThreadPool* pool)
     : pool_(pool), join_id_(OSThread::kInvalidThreadJoinId) {}
 
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_THREAD_POOL_H_
 #define RUNTIME_VM_THREAD_POOL_H_
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
@@ -17,6 +18,12 @@ namespace dart {
 
 class MonitorLocker;
 
+// Tasks are queued in the pool, and run in the order they were scheduled.
+// Tasks that allow it and are scheduled by a task running on the pool are
+// queued with the worker running it instead, which runs them after the task,
+// most recent first, without taking the pool lock. Another worker is only
+// woken up to steal the oldest of those tasks once a worker has several of
+// them, or blocks.
 class ThreadPool {
  public:
   // Subclasses of Task are able to run on a ThreadPool.
@@ -25,11 +32,25 @@ class ThreadPool {
     Task() {}
 
    public:
+    enum Priority {
+      kNormalPriority,
+      // Tasks that other threads wait for to make progress, such as the
+      // helpers of a parallel GC. They run before any normal task.
+      kHighPriority,
+    };
+
     virtual ~Task() {}
 
     // Override this to provide task-specific behavior.
     virtual void Run() = 0;
 
+    virtual Priority priority() const { return kNormalPriority; }
+
+    // Whether the task may wait for the worker that scheduled it to finish
+    // its current task. Tasks that the scheduling task might wait for must
+    // not, as the worker would never get to run them.
+    virtual bool can_run_on_scheduling_worker() const { return false; }
+
    private:
     DISALLOW_COPY_AND_ASSIGN(Task);
   };
@@ -67,6 +88,10 @@ class ThreadPool {
   uint64_t workers_stopped() const { return count_dead_; }
 
  private:
+  class Worker;
+  using TaskList = IntrusiveDList<Task>;
+  using WorkerList = IntrusiveDList<Worker>;
+
   class Worker : public IntrusiveDListEntry<Worker> {
    public:
     explicit Worker(ThreadPool* pool);
@@ -87,6 +112,13 @@ class ThreadPool {
     ThreadJoinId join_id_;
     OSThread* os_thread_ = nullptr;
     bool is_blocked_ = false;
+    // Whether the worker is running tasks. Only changed by the worker itself.
+    bool is_running_ = false;
+
+    // The tasks scheduled by the tasks of this worker. The worker takes the
+    // most recent one, other workers steal the oldest one.
+    Mutex tasks_mutex_;
+    TaskList tasks_;
 
     DISALLOW_COPY_AND_ASSIGN(Worker);
   };
@@ -102,16 +134,19 @@ class ThreadPool {
   bool ShuttingDownLocked() { return shutting_down_; }
 
   // Whether new tasks are ready to be run.
-  bool TasksWaitingToRunLocked() { return !tasks_.IsEmpty(); }
+  bool TasksWaitingToRunLocked() { return pending_tasks_ > 0; }
 
  private:
-  using TaskList = IntrusiveDList<Task>;
-  using WorkerList = IntrusiveDList<Worker>;
-
   bool RunImpl(std::unique_ptr<Task> task);
+  void RunLocal(Worker* worker, std::unique_ptr<Task> task);
   void WorkerLoop(Worker* worker);
+  void RunTasks(Worker* worker, std::unique_ptr<Task> task);
 
   Worker* ScheduleTaskLocked(MonitorLocker* ml, std::unique_ptr<Task> task);
+  Worker* ScheduleWorkerLocked(MonitorLocker* ml);
+  std::unique_ptr<Task> TakeTaskLocked(MonitorLocker* ml, Worker* worker);
+  Task* StealTaskLocked(Worker* thief, bool steal_last);
+  Worker* ScheduleThiefLocked(MonitorLocker* ml);
 
   void IdleToRunningLocked(Worker* worker);
   void RunningToIdleLocked(Worker* worker);
@@ -127,7 +162,16 @@ class ThreadPool {
   WorkerList running_workers_;
   WorkerList idle_workers_;
   WorkerList dead_workers_;
-  uint64_t pending_tasks_ = 0;
+  // The number of tasks that have been scheduled on the pool and not yet
+  // taken by a worker.
+  std::atomic<intptr_t> pending_tasks_ = {0};
+  // The number of tasks queued with workers.
+  std::atomic<intptr_t> pending_local_tasks_ = {0};
+  // The number of workers that check the local queues for tasks to steal
+  // within kStealLastTaskDelayMicros.
+  std::atomic<intptr_t> watching_workers_ = {0};
+  std::atomic<intptr_t> pending_high_priority_tasks_ = {0};
+  TaskList high_priority_tasks_;
   TaskList tasks_;
 
   Monitor exit_monitor_;
@@ -256,4 +256,211 @@ THREAD_POOL_UNIT_TEST_CASE(ThreadPool_RecursiveSpawn) {
   EXPECT_EQ(kTotalTasks, done);
 }
 
+class WaitForChildTask : public ThreadPool::Task {
+ public:
+  WaitForChildTask(ThreadPool* pool, Monitor* sync, int* done)
+      : pool_(pool), sync_(sync), done_(done) {}
+
+  // Schedules a task from a worker and waits for it, so it has to be run by
+  // another worker.
+  virtual void Run() {
+    Monitor child_sync;
+    bool child_done = true;
+    pool_->Run<TestTask>(&child_sync, &child_done);
+    {
+      MonitorLocker ml(&child_sync);
+      child_done = false;
+      ml.Notify();
+      while (!child_done) {
+        ml.Wait();
+      }
+    }
+    MonitorLocker ml(sync_);
+    (*done_)++;
+    ml.Notify();
+  }
+
+ private:
+  ThreadPool* pool_;
+  Monitor* sync_;
+  int* done_;
+};
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_WaitForScheduledTask) {
+  ThreadPool thread_pool;
+  Monitor sync;
+  int done = 0;
+  thread_pool.Run<WaitForChildTask>(&thread_pool, &sync, &done);
+  {
+    MonitorLocker ml(&sync);
+    while (done < 1) {
+      ml.Wait();
+    }
+  }
+  EXPECT_EQ(1, done);
+}
+
+class LocalChildTask : public ThreadPool::Task {
+ public:
+  LocalChildTask(Monitor* sync, ThreadId* thread_id)
+      : sync_(sync), thread_id_(thread_id) {}
+
+  virtual bool can_run_on_scheduling_worker() const { return true; }
+
+  virtual void Run() {
+    MonitorLocker ml(sync_);
+    *thread_id_ = OSThread::GetCurrentThreadId();
+    ml.Notify();
+  }
+
+ private:
+  Monitor* sync_;
+  ThreadId* thread_id_;
+};
+
+class ScheduleLocalChildTask : public ThreadPool::Task {
+ public:
+  ScheduleLocalChildTask(ThreadPool* pool,
+                         Monitor* sync,
+                         ThreadId* thread_id,
+                         ThreadId* child_thread_id)
+      : pool_(pool),
+        sync_(sync),
+        thread_id_(thread_id),
+        child_thread_id_(child_thread_id) {}
+
+  virtual void Run() {
+    {
+      MonitorLocker ml(sync_);
+      *thread_id_ = OSThread::GetCurrentThreadId();
+    }
+    pool_->Run<LocalChildTask>(sync_, child_thread_id_);
+  }
+
+ private:
+  ThreadPool* pool_;
+  Monitor* sync_;
+  ThreadId* thread_id_;
+  ThreadId* child_thread_id_;
+};
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_RunOnSchedulingWorker) {
+  ThreadPool thread_pool;
+  Monitor sync;
+  ThreadId thread_id = OSThread::kInvalidThreadId;
+  ThreadId child_thread_id = OSThread::kInvalidThreadId;
+  thread_pool.Run<ScheduleLocalChildTask>(&thread_pool, &sync, &thread_id,
+                                          &child_thread_id);
+  {
+    MonitorLocker ml(&sync);
+    while (child_thread_id == OSThread::kInvalidThreadId) {
+      ml.Wait();
+    }
+  }
+  // The child task is run by the worker that scheduled it. At most one other
+  // worker is started to take it in case the scheduling worker stays busy.
+  EXPECT(thread_id == child_thread_id);
+  EXPECT_LE(thread_pool.workers_started(), 2U);
+}
+
+class SetFlagTask : public ThreadPool::Task {
+ public:
+  explicit SetFlagTask(std::atomic<bool>* flag) : flag_(flag) {}
+
+  virtual bool can_run_on_scheduling_worker() const { return true; }
+
+  virtual void Run() { *flag_ = true; }
+
+ private:
+  std::atomic<bool>* flag_;
+};
+
+class SpinForLocalChildTask : public ThreadPool::Task {
+ public:
+  SpinForLocalChildTask(ThreadPool* pool, Monitor* sync, bool* done)
+      : pool_(pool), sync_(sync), done_(done) {}
+
+  // Schedules a task that may run on this worker and spins until it has run,
+  // without marking the worker as blocked, so it has to be stolen.
+  virtual void Run() {
+    std::atomic<bool> child_done = {false};
+    pool_->Run<SetFlagTask>(&child_done);
+    while (!child_done) {
+      OS::Sleep(1);
+    }
+    MonitorLocker ml(sync_);
+    *done_ = true;
+    ml.Notify();
+  }
+
+ private:
+  ThreadPool* pool_;
+  Monitor* sync_;
+  bool* done_;
+};
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_StealFromBusyWorker) {
+  ThreadPool thread_pool;
+  Monitor sync;
+  bool done = false;
+  thread_pool.Run<SpinForLocalChildTask>(&thread_pool, &sync, &done);
+  {
+    MonitorLocker ml(&sync);
+    while (!done) {
+      ml.Wait();
+    }
+  }
+  EXPECT(done);
+}
+
+class PriorityTask : public ThreadPool::Task {
+ public:
+  PriorityTask(Monitor* sync,
+               MallocGrowableArray<intptr_t>* order,
+               intptr_t id,
+               Priority priority)
+      : sync_(sync), order_(order), id_(id), priority_(priority) {}
+
+  virtual Priority priority() const { return priority_; }
+
+  virtual void Run() {
+    MonitorLocker ml(sync_);
+    order_->Add(id_);
+    ml.Notify();
+  }
+
+ private:
+  Monitor* sync_;
+  MallocGrowableArray<intptr_t>* order_;
+  intptr_t id_;
+  Priority priority_;
+};
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_HighPriorityFirst) {
+  ThreadPool thread_pool(/*max_pool_size=*/1);
+  Monitor sync;
+  MallocGrowableArray<intptr_t> order;
+
+  // Keep the only worker busy while the other tasks are scheduled.
+  bool blocked = true;
+  thread_pool.Run<TestTask>(&sync, &blocked);
+  thread_pool.Run<PriorityTask>(&sync, &order, 1,
+                                ThreadPool::Task::kNormalPriority);
+  thread_pool.Run<PriorityTask>(&sync, &order, 2,
+                                ThreadPool::Task::kHighPriority);
+  thread_pool.Run<PriorityTask>(&sync, &order, 3,
+                                ThreadPool::Task::kNormalPriority);
+  {
+    MonitorLocker ml(&sync);
+    blocked = false;
+    ml.NotifyAll();
+    while (order.length() < 3) {
+      ml.Wait();
+    }
+  }
+  EXPECT_EQ(2, order[0]);
+  EXPECT_EQ(1, order[1]);
+  EXPECT_EQ(3, order[2]);
+}
+
 }  // namespace dart
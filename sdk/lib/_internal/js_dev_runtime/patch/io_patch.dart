@@ -541,6 +541,25 @@ class SecurityContext {
   static bool get alpnSupported {
     throw UnsupportedError("SecurityContext alpnSupported getter");
   }
+
+  @patch
+  static void configureServerSessionCache(
+      {int maximumSessions = 20480,
+      Duration? timeout,
+      bool sessionTickets = true}) {
+    throw UnsupportedError("SecurityContext.configureServerSessionCache");
+  }
+
+  @patch
+  static void rotateSessionTicketKey([List<int>? key]) {
+    throw UnsupportedError("SecurityContext.rotateSessionTicketKey");
+  }
+
+  @patch
+  static TlsSessionStatistics get serverSessionStatistics {
+    throw UnsupportedError(
+        "SecurityContext serverSessionStatistics getter");
+  }
 }
 
 @patch
@@ -626,6 +645,12 @@ class RawZLibFilter {
       int windowBits, List<int>? dictionary, bool raw) {
     throw UnsupportedError("_newZLibInflateFilter");
   }
+
+  @patch
+  static int _combineChecksums(
+      bool crc, int checksum1, int checksum2, int length2) {
+    throw UnsupportedError("_combineChecksums");
+  }
 }
 
 @patch
@@ -124,6 +124,16 @@ abstract class TransferableTypedData {
       _unsupported();
 }
 
+@patch
+abstract class SharedRingBuffer {
+  @patch
+  factory SharedRingBuffer(int recordSize, int capacity) => _unsupported();
+
+  @patch
+  factory SharedRingBuffer.attach(SharedRingBufferTicket ticket) =>
+      _unsupported();
+}
+
 @NoReifyGeneric()
 T _unsupported<T>() {
   throw UnsupportedError('dart:isolate is not supported on dart4web');
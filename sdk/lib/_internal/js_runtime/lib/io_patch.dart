@@ -541,6 +541,25 @@ class SecurityContext {
   static bool get alpnSupported {
     throw new UnsupportedError("SecurityContext alpnSupported getter");
   }
+
+  @patch
+  static void configureServerSessionCache(
+      {int maximumSessions: 20480,
+      Duration? timeout,
+      bool sessionTickets: true}) {
+    throw new UnsupportedError("SecurityContext.configureServerSessionCache");
+  }
+
+  @patch
+  static void rotateSessionTicketKey([List<int>? key]) {
+    throw new UnsupportedError("SecurityContext.rotateSessionTicketKey");
+  }
+
+  @patch
+  static TlsSessionStatistics get serverSessionStatistics {
+    throw new UnsupportedError(
+        "SecurityContext serverSessionStatistics getter");
+  }
 }
 
 @patch
@@ -626,6 +645,12 @@ class RawZLibFilter {
       int windowBits, List<int>? dictionary, bool raw) {
     throw new UnsupportedError("_newZLibInflateFilter");
   }
+
+  @patch
+  static int _combineChecksums(
+      bool crc, int checksum1, int checksum2, int length2) {
+    throw new UnsupportedError("_combineChecksums");
+  }
 }
 
 @patch
@@ -155,3 +155,16 @@ abstract class TransferableTypedData {
     throw new UnsupportedError('TransferableTypedData.fromList');
   }
 }
+
+@patch
+abstract class SharedRingBuffer {
+  @patch
+  factory SharedRingBuffer(int recordSize, int capacity) {
+    throw new UnsupportedError('SharedRingBuffer');
+  }
+
+  @patch
+  factory SharedRingBuffer.attach(SharedRingBufferTicket ticket) {
+    throw new UnsupportedError('SharedRingBuffer.attach');
+  }
+}
@@ -83,6 +83,7 @@ class _RandomAccessFileOpsImpl extends NativeFieldWrapperClass1
   length() native "File_Length";
   flush() native "File_Flush";
   lock(int lock, int start, int end) native "File_Lock";
+  map(int start, int end, int advice) native "File_Map";
 }
 
 class _WatcherPath {
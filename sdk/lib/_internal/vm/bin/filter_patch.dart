@@ -45,4 +45,7 @@ class RawZLibFilter {
   static RawZLibFilter _makeZLibInflateFilter(
           int windowBits, List<int>? dictionary, bool raw) =>
       new _ZLibInflateFilter(windowBits, dictionary, raw);
+  @patch
+  static int _combineChecksums(bool crc, int checksum1, int checksum2,
+      int length2) native "Filter_CombineChecksums";
 }
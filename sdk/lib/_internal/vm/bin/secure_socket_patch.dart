@@ -68,12 +68,17 @@ class _SecureSocket extends _Socket implements SecureSocket {
 class _SecureFilterImpl extends NativeFieldWrapperClass1
     implements _SecureFilter {
   // Performance is improved if a full buffer of plaintext fits
-  // in the encrypted buffer, when encrypted.
+  // in the encrypted buffer, when encrypted. With --large_tls_buffers the
+  // plaintext buffer holds a full TLS record, and the encrypted buffer two,
+  // so that several records can be passed per filter request.
   // SIZE and ENCRYPTED_SIZE are referenced from C++.
   @pragma("vm:entry-point")
-  static final int SIZE = 8 * 1024;
+  static final int SIZE = _useLargeBuffers() ? 16 * 1024 : 8 * 1024;
   @pragma("vm:entry-point")
-  static final int ENCRYPTED_SIZE = 10 * 1024;
+  static final int ENCRYPTED_SIZE =
+      _useLargeBuffers() ? 34 * 1024 : 10 * 1024;
+
+  static bool _useLargeBuffers() native "SecureSocket_UseLargeBuffers";
 
   _SecureFilterImpl._() {
     buffers = <_ExternalBuffer>[
@@ -158,6 +163,9 @@ class _SecureFilterImpl extends NativeFieldWrapperClass1
 
   int processBuffer(int bufferIndex) => throw new UnimplementedError();
 
+  List processAllBuffers(bool inHandshake, List<int> positions)
+      native "SecureSocket_ProcessAllBuffers";
+
   String? selectedProtocol() native "SecureSocket_GetSelectedProtocol";
 
   void renegotiate(bool useSessionCache, bool requestClientCertificate,
@@ -201,6 +209,47 @@ class SecurityContext {
 
   @patch
   static bool get alpnSupported => true;
+
+  @patch
+  static void configureServerSessionCache(
+      {int maximumSessions: 20480,
+      Duration? timeout,
+      bool sessionTickets: true}) {
+    if (maximumSessions < 0) {
+      throw new ArgumentError.value(
+          maximumSessions, 'maximumSessions', 'Must not be negative');
+    }
+    int timeoutSeconds = timeout?.inSeconds ?? 0;
+    if (timeout != null && timeoutSeconds <= 0) {
+      throw new ArgumentError.value(
+          timeout, 'timeout', 'Must be at least one second');
+    }
+    _configureServerSessionCache(
+        maximumSessions, timeoutSeconds, sessionTickets);
+  }
+
+  @patch
+  static void rotateSessionTicketKey([List<int>? key]) {
+    if (key != null && key.length != 48) {
+      throw new ArgumentError.value(key, 'key', 'Must contain 48 bytes');
+    }
+    _rotateSessionTicketKey(key);
+  }
+
+  @patch
+  static TlsSessionStatistics get serverSessionStatistics {
+    List<int> statistics = _serverSessionStatistics();
+    return new TlsSessionStatistics._(
+        statistics[0], statistics[1], statistics[2]);
+  }
+
+  static void _configureServerSessionCache(int maximumSessions,
+      int timeoutSeconds, bool sessionTickets)
+      native "SecurityContext_ConfigureServerSessionCache";
+  static void _rotateSessionTicketKey(List<int>? key)
+      native "SecurityContext_RotateSessionTicketKey";
+  static List<int> _serverSessionStatistics()
+      native "SecurityContext_ServerSessionStatistics";
 }
 
 class _SecurityContext extends NativeFieldWrapperClass1
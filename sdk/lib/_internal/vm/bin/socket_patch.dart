@@ -440,6 +440,14 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
   static const int normalTokenBatchSize = 8;
   static const int listeningTokenBatchSize = 2;
 
+  // Maximum number of buffers passed to a single gathering write. Must match
+  // SocketBase::kMaxWriteBuffers.
+  static const int maxWriteBuffers = 64;
+
+  // Maximum number of datagrams passed to a single native batch send or
+  // receive. Must match SocketBase::kMaxDatagramBatch.
+  static const int maxDatagramBatch = 16;
+
   static const Duration _retryDuration = const Duration(milliseconds: 250);
   static const Duration _retryDurationLoopback =
       const Duration(milliseconds: 25);
@@ -836,26 +844,30 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     try {
       Uint8List? list;
       if (count != null) {
-        list = nativeRead(count);
+        list = _readChunk(count);
         available = nativeAvailable();
       } else {
         // If count is null, read as many bytes as possible.
         // Loop here to ensure bytes that arrived while this read was
         // issued are also read.
-        BytesBuilder builder = BytesBuilder();
+        BytesBuilder? builder;
         do {
           assert(available > 0);
-          list = nativeRead(available);
-          if (list == null) {
+          Uint8List? chunk = _readChunk(available);
+          if (chunk == null) {
             break;
           }
-          builder.add(list);
+          if (list == null) {
+            list = chunk;
+          } else {
+            // Only concatenate when more than one chunk was read.
+            builder ??= BytesBuilder(copy: false)..add(list);
+            builder.add(chunk);
+          }
           available = nativeAvailable();
         } while (available > 0);
-        if (builder.isEmpty) {
-          list = null;
-        } else {
-          list = builder.toBytes();
+        if (builder != null) {
+          list = builder.takeBytes();
         }
       }
       if (!const bool.fromEnvironment("dart.vm.product")) {
@@ -869,6 +881,41 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     }
   }
 
+  // Buffer reused by all sockets of this isolate for reads of at most
+  // [_readBufferSize] bytes. Such reads are copied into a new heap allocated
+  // list of the exact size instead of an external one, which reduces the
+  // external allocation pressure on the GC.
+  static const int _readBufferSize = 16 * 1024;
+  static Uint8List? _readBuffer;
+
+  Uint8List? _readChunk(int count) {
+    if (count > _readBufferSize) return nativeRead(count);
+    Uint8List buffer = _readBuffer ??= Uint8List(_readBufferSize);
+    int bytesRead = nativeReadInto(buffer, 0, count);
+    if (bytesRead == 0) return null;
+    return buffer.sublist(0, bytesRead);
+  }
+
+  // Reads up to [count] bytes into [buffer] starting at [offset] without
+  // allocating. Returns the number of bytes read, which is 0 if no data was
+  // available.
+  int readInto(Uint8List buffer, int offset, int count) {
+    RangeError.checkValidRange(offset, offset + count, buffer.length);
+    if (isClosing || isClosed || count == 0) return 0;
+    try {
+      int bytesRead = nativeReadInto(buffer, offset, count);
+      available = nativeAvailable();
+      if (!const bool.fromEnvironment("dart.vm.product")) {
+        _SocketProfile.collectStatistic(
+            nativeGetSocketId(), _SocketProfileType.readBytes, bytesRead);
+      }
+      return bytesRead;
+    } catch (e) {
+      reportError(e, StackTrace.current, "Read failed");
+      return 0;
+    }
+  }
+
   Datagram? receive() {
     if (isClosing || isClosed) return null;
     try {
@@ -885,6 +932,35 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     }
   }
 
+  List<Datagram> receiveBatch(int maxDatagrams) {
+    if (maxDatagrams <= 0) {
+      throw new RangeError.range(maxDatagrams, 1, null, "maxDatagrams");
+    }
+    final datagrams = <Datagram>[];
+    if (isClosing || isClosed) return datagrams;
+    try {
+      while (datagrams.length < maxDatagrams) {
+        final count = min(maxDatagrams - datagrams.length, maxDatagramBatch);
+        final List<Datagram>? received = nativeRecvFromBatch(count);
+        if (received == null) break;
+        datagrams.addAll(received);
+        if (received.length < count) break;
+      }
+      if (!const bool.fromEnvironment("dart.vm.product")) {
+        int bytes = 0;
+        for (final datagram in datagrams) {
+          bytes += datagram.data.length;
+        }
+        _SocketProfile.collectStatistic(
+            nativeGetSocketId(), _SocketProfileType.readBytes, bytes);
+      }
+      _availableDatagram = nativeAvailableDatagram();
+    } catch (e) {
+      reportError(e, StackTrace.current, "Receive failed");
+    }
+    return datagrams;
+  }
+
   static int _fixOffset(int? offset) => offset ?? 0;
 
   int write(List<int> buffer, int offset, int? bytes) {
@@ -930,6 +1006,69 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     }
   }
 
+  // Writes [buffers] in order, starting at [offset] in the first buffer, with
+  // a single gathering write. At most [maxWriteBuffers] buffers are written.
+  //
+  // The buffers must already have been passed through
+  // [_ensureFastAndSerializableByteData], as they are handed to the native
+  // code as they are.
+  int writeBuffers(List<List<int>> buffers, int offset) {
+    if (isClosing || isClosed) return 0;
+    int count = min(buffers.length, maxWriteBuffers);
+    if (count == 0) return 0;
+    try {
+      final nativeBuffers =
+          (count == buffers.length) ? buffers : buffers.sublist(0, count);
+      int bytes = -offset;
+      for (int i = 0; i < count; i++) {
+        assert(_isDirectIOCapableTypedList(nativeBuffers[i]));
+        bytes += nativeBuffers[i].length;
+      }
+      if (bytes == 0) return 0;
+      if (!const bool.fromEnvironment("dart.vm.product")) {
+        _SocketProfile.collectStatistic(
+            nativeGetSocketId(), _SocketProfileType.writeBytes, bytes);
+      }
+      int result = nativeWriteBuffers(nativeBuffers, offset);
+      // As in [write], a negative result is a forced short write.
+      if (result >= 0 && result < bytes) {
+        writeAvailable = false;
+      }
+      if (result < 0) result = -result;
+      return result;
+    } catch (e) {
+      StackTrace st = StackTrace.current;
+      scheduleMicrotask(() => reportError(e, st, "Write failed"));
+      return 0;
+    }
+  }
+
+  // Sends [length] bytes of [file], starting at [offset], directly from the
+  // file to the socket. Returns the number of bytes sent, or null if the file
+  // cannot be sent this way or has ended, and has to be read instead.
+  int? sendFile(_RandomAccessFile file, int offset, int length) {
+    if (isClosing || isClosed) return 0;
+    if (length == 0) return 0;
+    try {
+      int? result = nativeSendFile(file._pointer(), offset, length);
+      if (result == null) return null;
+      // As in [write], a negative result is a forced short write.
+      if (result >= 0 && result < length) {
+        writeAvailable = false;
+      }
+      if (result < 0) result = -result;
+      if (!const bool.fromEnvironment("dart.vm.product")) {
+        _SocketProfile.collectStatistic(
+            nativeGetSocketId(), _SocketProfileType.writeBytes, result);
+      }
+      return result;
+    } catch (e) {
+      StackTrace st = StackTrace.current;
+      scheduleMicrotask(() => reportError(e, st, "Write failed"));
+      return 0;
+    }
+  }
+
   int send(List<int> buffer, int offset, int bytes, InternetAddress address,
       int port) {
     _throwOnBadPort(port);
@@ -953,6 +1092,46 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     }
   }
 
+  int sendBatch(List<Datagram> datagrams) {
+    for (final datagram in datagrams) {
+      _throwOnBadPort(datagram.port);
+    }
+    if (isClosing || isClosed) return 0;
+    int sent = 0;
+    try {
+      while (sent < datagrams.length) {
+        final count = min(datagrams.length - sent, maxDatagramBatch);
+        final buffers = <List<int>>[];
+        final addresses = <Uint8List>[];
+        final ports = <int>[];
+        int bytes = 0;
+        for (int i = sent; i < sent + count; i++) {
+          final datagram = datagrams[i];
+          final data = datagram.data;
+          buffers.add(
+              _ensureFastAndSerializableByteData(data, 0, data.length).buffer);
+          addresses.add((datagram.address as _InternetAddress)._in_addr);
+          ports.add(datagram.port);
+          bytes += datagram.data.length;
+        }
+        final result = nativeSendToBatch(buffers, addresses, ports);
+        if (!const bool.fromEnvironment("dart.vm.product")) {
+          for (int i = sent + result; i < sent + count; i++) {
+            bytes -= datagrams[i].data.length;
+          }
+          _SocketProfile.collectStatistic(
+              nativeGetSocketId(), _SocketProfileType.writeBytes, bytes);
+        }
+        sent += result;
+        if (result < count) break;
+      }
+    } catch (e) {
+      StackTrace st = StackTrace.current;
+      scheduleMicrotask(() => reportError(e, st, "Send failed"));
+    }
+    return sent;
+  }
+
   _NativeSocket? accept() {
     // Don't issue accept if we're closing.
     if (isClosing || isClosed) return null;
@@ -1333,11 +1512,22 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
   int nativeAvailable() native "Socket_Available";
   bool nativeAvailableDatagram() native "Socket_AvailableDatagram";
   Uint8List? nativeRead(int len) native "Socket_Read";
+  int nativeReadInto(Uint8List buffer, int offset, int len)
+      native "Socket_ReadInto";
   Datagram? nativeRecvFrom() native "Socket_RecvFrom";
+  List<Datagram>? nativeRecvFromBatch(int maxCount)
+      native "Socket_RecvFromBatch";
   int nativeWrite(List<int> buffer, int offset, int bytes)
       native "Socket_WriteList";
+  int nativeWriteBuffers(List<List<int>> buffers, int offset)
+      native "Socket_WriteBuffers";
+  int? nativeSendFile(int filePointer, int offset, int length)
+      native "Socket_SendFile";
   int nativeSendTo(List<int> buffer, int offset, int bytes, Uint8List address,
       int port) native "Socket_SendTo";
+  int nativeSendToBatch(
+          List<List<int>> buffers, List<Uint8List> addresses, List<int> ports)
+      native "Socket_SendToBatch";
   nativeCreateConnect(Uint8List addr, int port, int scope_id)
       native "Socket_CreateConnect";
   nativeCreateUnixDomainConnect(String addr, _Namespace namespace)
@@ -1457,7 +1647,8 @@ class _RawServerSocket extends Stream<RawSocket> implements RawServerSocket {
   }
 }
 
-class _RawSocket extends Stream<RawSocketEvent> implements RawSocket {
+class _RawSocket extends Stream<RawSocketEvent>
+    implements RawSocket, _ReadIntoSocket {
   final _NativeSocket _socket;
   final _controller = new StreamController<RawSocketEvent>(sync: true);
   bool _readEventsEnabled = true;
@@ -1564,6 +1755,22 @@ class _RawSocket extends Stream<RawSocketEvent> implements RawSocket {
     }
   }
 
+  int _readInto(Uint8List buffer, int start, int end) {
+    if (_isMacOSTerminalInput) {
+      var available = this.available();
+      if (available == 0) return 0;
+      var bytesRead = _socket.readInto(buffer, start, end - start);
+      if (bytesRead < available) {
+        // Reading less than available from a Mac OS terminal indicate Ctrl-D.
+        // This is interpreted as read closed.
+        scheduleMicrotask(() => _controller.add(RawSocketEvent.readClosed));
+      }
+      return bytesRead;
+    } else {
+      return _socket.readInto(buffer, start, end - start);
+    }
+  }
+
   int write(List<int> buffer, [int offset = 0, int? count]) =>
       _socket.write(buffer, offset, count);
 
@@ -1701,12 +1908,27 @@ class Socket {
 }
 
 class _SocketStreamConsumer extends StreamConsumer<List<int>> {
+  // Number of queued bytes above which the source stream is paused until the
+  // socket has drained.
+  static const int maxPendingBytes = 64 * 1024;
+
   StreamSubscription? subscription;
   final _Socket socket;
-  int? offset;
-  List<int>? buffer;
+  // Buffers waiting to be written, in order. Only the first one may be
+  // partially written, up to [offset].
+  final List<List<int>> buffers = <List<int>>[];
+  int offset = 0;
+  int pendingBytes = 0;
   bool paused = false;
+  bool streamDone = false;
   Completer<Socket>? streamCompleter;
+  // The file of an added [_FileStream] that is being sent directly to the
+  // socket, from [filePosition] up to [fileEnd].
+  bool sendingFile = false;
+  _RandomAccessFile? file;
+  String? filePath;
+  int filePosition = 0;
+  int fileEnd = 0;
 
   _SocketStreamConsumer(this.socket);
 
@@ -1714,26 +1936,101 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
     socket._ensureRawSocketSubscription();
     final completer = streamCompleter = new Completer<Socket>();
     if (socket._raw != null) {
-      subscription = stream.listen((data) {
-        assert(!paused);
-        assert(buffer == null);
-        buffer = data;
-        offset = 0;
-        try {
-          write();
-        } catch (e) {
-          socket.destroy();
-          stop();
-          done(e);
+      if (stream is _FileStream && canSendFile(stream)) {
+        sendFileStream(stream);
+      } else {
+        listenTo(stream);
+      }
+    }
+    return completer.future;
+  }
+
+  // Whether the file of [stream] can be sent by the kernel instead of being
+  // read into buffers first. This is only supported for plain sockets on
+  // Linux and Android.
+  bool canSendFile(_FileStream stream) =>
+      stream._path != null &&
+      !stream._listened &&
+      socket._raw is _RawSocket &&
+      (Platform.isLinux || Platform.isAndroid);
+
+  void sendFileStream(_FileStream stream) {
+    final path = stream._path!;
+    final start = stream._position;
+    final end = stream._end;
+    if (start < 0 || (end != null && end < start)) {
+      // Let the stream report the bad range.
+      listenTo(stream);
+      return;
+    }
+    sendingFile = true;
+    new File(path).open().then((opened) {
+      return opened.length().then((length) {
+        if (!sendingFile || length == 0) {
+          // Files that report no length, such as character devices, are
+          // read through the stream instead.
+          return opened.close().then((_) {
+            if (sendingFile) {
+              sendingFile = false;
+              listenTo(stream);
+            }
+          });
+        }
+        file = opened as _RandomAccessFile;
+        filePath = path;
+        filePosition = start;
+        fileEnd = min(end ?? length, length);
+        write();
+      }, onError: (error, stackTrace) {
+        opened.close();
+        return new Future.error(error, stackTrace);
+      });
+    }).catchError((error, stackTrace) {
+      if (!sendingFile) return;
+      socket.destroy();
+      done(error, stackTrace);
+    });
+  }
+
+  void listenTo(Stream<List<int>> stream) {
+    subscription = stream.listen((data) {
+      assert(!paused);
+      if (data.isEmpty) return;
+      final waitingForWrite = buffers.isNotEmpty;
+      // Native sockets hand the queued buffers to the native code as they
+      // are, so convert them once here instead of on every write attempt.
+      if (socket._raw is _RawSocket) {
+        data = _ensureFastAndSerializableByteData(data, 0, data.length).buffer;
+      }
+      buffers.add(data);
+      pendingBytes += data.length;
+      if (waitingForWrite) {
+        // Queue the data behind the pending buffers so they can all be
+        // written together once the socket becomes writable.
+        if (pendingBytes > maxPendingBytes) {
+          paused = true;
+          subscription!.pause();
         }
-      }, onError: (error, [stackTrace]) {
+        return;
+      }
+      try {
+        write();
+      } catch (e) {
         socket.destroy();
-        done(error, stackTrace);
-      }, onDone: () {
+        stop();
+        done(e);
+      }
+    }, onError: (error, [stackTrace]) {
+      socket.destroy();
+      done(error, stackTrace);
+    }, onDone: () {
+      // Complete once the queued buffers have been written.
+      if (buffers.isEmpty) {
         done();
-      }, cancelOnError: true);
-    }
-    return completer.future;
+      } else {
+        streamDone = true;
+      }
+    }, cancelOnError: true);
   }
 
   Future<Socket> close() {
@@ -1742,26 +2039,77 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
   }
 
   void write() {
+    final openFile = file;
+    if (openFile != null) {
+      writeFile(openFile);
+      return;
+    }
     final sub = subscription;
     if (sub == null) return;
     // Write as much as possible.
-    offset =
-        offset! + socket._write(buffer!, offset!, buffer!.length - offset!);
-    if (offset! < buffer!.length) {
-      if (!paused) {
+    final written = socket._writeBuffers(buffers, offset);
+    pendingBytes -= written;
+    offset += written;
+    int consumed = 0;
+    while (consumed < buffers.length && offset >= buffers[consumed].length) {
+      offset -= buffers[consumed].length;
+      consumed++;
+    }
+    buffers.removeRange(0, consumed);
+    if (buffers.isNotEmpty) {
+      if (!paused && pendingBytes > maxPendingBytes) {
         paused = true;
         sub.pause();
       }
       socket._enableWriteEvent();
     } else {
-      buffer = null;
-      if (paused) {
+      assert(offset == 0 && pendingBytes == 0);
+      if (streamDone) {
+        streamDone = false;
+        done();
+      } else if (paused) {
         paused = false;
         sub.resume();
       }
     }
   }
 
+  void writeFile(_RandomAccessFile openFile) {
+    final sent =
+        socket._sendFile(openFile, filePosition, fileEnd - filePosition);
+    if (sent == null) {
+      // The file cannot be sent directly, or it is shorter than when it was
+      // opened. Read the rest of it instead, which also completes the stream
+      // at the current end of the file.
+      final stream = new _FileStream(filePath, filePosition, fileEnd);
+      closeFile();
+      listenTo(stream);
+      return;
+    }
+    filePosition += sent;
+    if (filePosition < fileEnd) {
+      socket._enableWriteEvent();
+      return;
+    }
+    file = null;
+    sendingFile = false;
+    openFile.close().then((_) => done(), onError: (error, stackTrace) {
+      socket.destroy();
+      done(error, stackTrace);
+    });
+  }
+
+  void closeFile() {
+    sendingFile = false;
+    final openFile = file;
+    if (openFile != null) {
+      file = null;
+      // Errors are ignored, as the file has either been sent or the send has
+      // been abandoned.
+      openFile.close().catchError((_) {});
+    }
+  }
+
   void done([error, stackTrace]) {
     final completer = streamCompleter;
     if (completer != null) {
@@ -1775,11 +2123,19 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
   }
 
   void stop() {
+    if (sendingFile) {
+      closeFile();
+      socket._disableWriteEvent();
+    }
     final sub = subscription;
     if (sub == null) return;
     sub.cancel();
     subscription = null;
+    buffers.clear();
+    offset = 0;
+    pendingBytes = 0;
     paused = false;
+    streamDone = false;
     socket._disableWriteEvent();
   }
 }
@@ -1916,7 +2272,7 @@ class _Socket extends Stream<Uint8List> implements Socket {
     _detachReady = new Completer();
     _sink.close();
     return _detachReady.future.then((_) {
-      assert(_consumer.buffer == null);
+      assert(_consumer.buffers.isEmpty);
       var raw = _raw;
       _raw = null;
       return [raw, _subscription];
@@ -2003,6 +2359,34 @@ class _Socket extends Stream<Uint8List> implements Socket {
     return 0;
   }
 
+  // Writes [buffers] in order, starting at [offset] in the first buffer.
+  // Native sockets write them with a single gathering write, other raw
+  // sockets one buffer at a time until a write comes up short.
+  int _writeBuffers(List<List<int>> buffers, int offset) {
+    final raw = _raw;
+    if (raw == null) return 0;
+    if (buffers.length > 1 && raw is _RawSocket) {
+      return raw._socket.writeBuffers(buffers, offset);
+    }
+    int written = 0;
+    for (int i = 0; i < buffers.length; i++) {
+      final buffer = buffers[i];
+      final start = (i == 0) ? offset : 0;
+      final bytes = raw.write(buffer, start, buffer.length - start);
+      written += bytes;
+      if (bytes < buffer.length - start) break;
+    }
+    return written;
+  }
+
+  // Sends part of [file] directly to the socket, see
+  // [_NativeSocket.sendFile].
+  int? _sendFile(_RandomAccessFile file, int offset, int length) {
+    final raw = _raw;
+    if (raw == null) return 0;
+    return (raw as _RawSocket)._socket.sendFile(file, offset, length);
+  }
+
   void _enableWriteEvent() {
     _raw?.writeEventsEnabled = true;
   }
@@ -2040,7 +2424,7 @@ class RawDatagramSocket {
 }
 
 class _RawDatagramSocket extends Stream<RawSocketEvent>
-    implements RawDatagramSocket {
+    implements RawDatagramSocket, _BatchDatagramSocket {
   _NativeSocket _socket;
   late StreamController<RawSocketEvent> _controller;
   bool _readEventsEnabled = true;
@@ -2108,6 +2492,11 @@ class _RawDatagramSocket extends Stream<RawSocketEvent>
     return _socket.receive();
   }
 
+  int _sendBatch(List<Datagram> datagrams) => _socket.sendBatch(datagrams);
+
+  List<Datagram> _receiveBatch(int maxDatagrams) =>
+      _socket.receiveBatch(maxDatagrams);
+
   void joinMulticast(InternetAddress group, [NetworkInterface? interface]) {
     _socket.joinMulticast(group, interface);
   }
@@ -13,6 +13,7 @@ import "dart:async"
     show Completer, Future, Stream, StreamController, StreamSubscription, Timer;
 
 import "dart:collection" show HashMap;
+import "dart:nativewrappers" show NativeFieldWrapperClass1;
 import "dart:typed_data" show ByteBuffer, TypedData, Uint8List;
 import "dart:_internal" show spawnFunction;
 
@@ -674,3 +675,116 @@ class _TransferableTypedDataImpl implements TransferableTypedData {
   Uint8List _materializeIntoUint8List()
       native "TransferableTypedData_materialize";
 }
+
+@patch
+abstract class SharedRingBuffer {
+  @patch
+  factory SharedRingBuffer(int recordSize, int capacity) {
+    // The limits of SharedRingBuffer::New in the VM.
+    RangeError.checkValueInInterval(recordSize, 1, 64 * 1024, "recordSize");
+    RangeError.checkValueInInterval(capacity, 1, 16 * 1024 * 1024, "capacity");
+    return new _SharedRingBufferImpl().._create(recordSize, capacity);
+  }
+
+  @patch
+  factory SharedRingBuffer.attach(SharedRingBufferTicket ticket) {
+    final int id = (ticket as _SharedRingBufferTicketImpl)._id;
+    return new _SharedRingBufferImpl().._attach(id);
+  }
+}
+
+// The native field points to the reference of this isolate to the buffer,
+// which also keeps the object from being sent to another isolate.
+class _SharedRingBufferImpl extends NativeFieldWrapperClass1
+    implements SharedRingBuffer {
+  bool _closed = false;
+
+  void _create(int recordSize, int capacity)
+      native "SharedRingBuffer_create";
+  void _attach(int ticket) native "SharedRingBuffer_attach";
+
+  int get recordSize {
+    _checkOpen();
+    return _getRecordSize();
+  }
+
+  int get capacity {
+    _checkOpen();
+    return _getCapacity();
+  }
+
+  int get length {
+    _checkOpen();
+    return _getLength();
+  }
+
+  SharedRingBufferTicket share() {
+    _checkOpen();
+    return new _SharedRingBufferTicketImpl(_share());
+  }
+
+  bool tryPush(TypedData record) {
+    _checkOpen();
+    return _tryPush(record);
+  }
+
+  bool tryPop(TypedData record) {
+    _checkOpen();
+    return _tryPop(record);
+  }
+
+  Future<void> whenNotEmpty() {
+    _checkOpen();
+    final completer = new Completer<void>();
+    final port = new RawReceivePort();
+    port.handler = (_) {
+      port.close();
+      completer.complete();
+    };
+    _ringWhenNotEmpty(port.sendPort);
+    return completer.future;
+  }
+
+  Future<void> whenNotFull() {
+    _checkOpen();
+    final completer = new Completer<void>();
+    final port = new RawReceivePort();
+    port.handler = (_) {
+      port.close();
+      completer.complete();
+    };
+    _ringWhenNotFull(port.sendPort);
+    return completer.future;
+  }
+
+  void close() {
+    if (!_closed) {
+      _closed = true;
+      _close();
+    }
+  }
+
+  void _checkOpen() {
+    if (_closed) {
+      throw new StateError("SharedRingBuffer is closed");
+    }
+  }
+
+  int _getRecordSize() native "SharedRingBuffer_getRecordSize";
+  int _getCapacity() native "SharedRingBuffer_getCapacity";
+  int _getLength() native "SharedRingBuffer_getLength";
+  int _share() native "SharedRingBuffer_share";
+  bool _tryPush(TypedData record) native "SharedRingBuffer_tryPush";
+  bool _tryPop(TypedData record) native "SharedRingBuffer_tryPop";
+  void _ringWhenNotEmpty(SendPort port)
+      native "SharedRingBuffer_ringWhenNotEmpty";
+  void _ringWhenNotFull(SendPort port)
+      native "SharedRingBuffer_ringWhenNotFull";
+  void _close() native "SharedRingBuffer_close";
+}
+
+class _SharedRingBufferTicketImpl implements SharedRingBufferTicket {
+  final int _id;
+
+  _SharedRingBufferTicketImpl(this._id);
+}
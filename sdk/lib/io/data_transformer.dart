@@ -417,6 +417,123 @@ class ZLibEncoder extends Converter<List<int>, List<int>> {
     return new _ZLibEncoderSink._(
         sink, gzip, level, windowBits, memLevel, strategy, dictionary, raw);
   }
+
+  /**
+   * Compresses [bytes] like [convert], but on IO service threads so that the
+   * isolate is not blocked while compressing.
+   *
+   * Large inputs compressed with the maximum window size and no [dictionary]
+   * are split into blocks that are compressed in parallel, and joined into a
+   * single stream. The result is slightly larger than the one returned by
+   * [convert], but decompresses to the same data with any decoder.
+   */
+  Future<List<int>> convertAsync(List<int> bytes) {
+    Uint8List data = _toUint8List(bytes);
+    if (data.length < 2 * _deflateBlockSize ||
+        windowBits != ZLibOption.maxWindowBits ||
+        (dictionary != null && !gzip && !raw)) {
+      return _IOService._dispatch(_IOService.filterDeflate, [
+        data,
+        gzip,
+        level,
+        windowBits,
+        memLevel,
+        strategy,
+        dictionary == null ? null : _toUint8List(dictionary!),
+        raw
+      ]).then(_filterResult);
+    }
+    return _deflateBlocks(data);
+  }
+
+  // Compresses blocks of [data] in parallel, each with the data preceding it
+  // as dictionary, and joins them with a zlib or gzip header and trailer.
+  Future<List<int>> _deflateBlocks(Uint8List data) async {
+    bool useCrc = gzip && !raw;
+    int blockCount = (data.length + _deflateBlockSize - 1) ~/ _deflateBlockSize;
+    List responses = new List<dynamic>.filled(blockCount, null);
+    int nextBlock = 0;
+
+    Future<void> deflateNextBlocks() async {
+      while (nextBlock < blockCount) {
+        int i = nextBlock++;
+        int start = i * _deflateBlockSize;
+        int end = min(start + _deflateBlockSize, data.length);
+        int dictionaryStart = max(0, start - _deflateDictionarySize);
+        responses[i] = await _IOService._dispatch(
+            _IOService.filterDeflateBlock, [
+          new Uint8List.sublistView(data, dictionaryStart, end),
+          start - dictionaryStart,
+          level,
+          memLevel,
+          strategy,
+          end == data.length,
+          useCrc
+        ]);
+      }
+    }
+
+    // Keep at most one block per processor in flight, so that a large input
+    // does not occupy every IO service thread and delay other IO requests.
+    int inFlight = min(blockCount, max(1, Platform.numberOfProcessors));
+    await Future.wait(
+        new List<Future<void>>.generate(inFlight, (_) => deflateNextBlocks()));
+
+    BytesBuilder builder = new BytesBuilder(copy: false);
+    if (!raw) builder.add(gzip ? _gzipHeader() : _zlibHeader());
+    int checksum = 0;
+    for (int i = 0; i < responses.length; i++) {
+      var response = responses[i];
+      if (_isErrorResponse(response)) throw _filterException(response);
+      builder.add(response[1]);
+      int blockLength =
+          min(_deflateBlockSize, data.length - i * _deflateBlockSize);
+      checksum = (i == 0)
+          ? response[2]
+          : RawZLibFilter._combineChecksums(
+              useCrc, checksum, response[2], blockLength);
+    }
+    if (gzip && !raw) {
+      builder.add(_littleEndian(checksum));
+      builder.add(_littleEndian(data.length & 0xFFFFFFFF));
+    } else if (!raw) {
+      builder.add([
+        (checksum >> 24) & 0xFF,
+        (checksum >> 16) & 0xFF,
+        (checksum >> 8) & 0xFF,
+        checksum & 0xFF
+      ]);
+    }
+    return builder.takeBytes();
+  }
+
+  // The level flags as written by zlib in the zlib header, and the extra
+  // flags in the gzip header.
+  int get _effectiveLevel => level == -1 ? 6 : level;
+  bool get _isFastest =>
+      strategy >= ZLibOption.strategyHuffmanOnly || _effectiveLevel < 2;
+
+  List<int> _zlibHeader() {
+    int levelFlags = _isFastest
+        ? 0
+        : _effectiveLevel < 6 ? 1 : _effectiveLevel == 6 ? 2 : 3;
+    int header = 0x7800 | (levelFlags << 6);
+    header += 31 - (header % 31);
+    return [header >> 8, header & 0xFF];
+  }
+
+  List<int> _gzipHeader() {
+    int extraFlags = _effectiveLevel == 9 ? 2 : _isFastest ? 4 : 0;
+    // No file name or modification time, and a Unix operating system.
+    return [0x1f, 0x8b, 8, 0, 0, 0, 0, 0, extraFlags, 3];
+  }
+
+  static List<int> _littleEndian(int value) => [
+        value & 0xFF,
+        (value >> 8) & 0xFF,
+        (value >> 16) & 0xFF,
+        (value >> 24) & 0xFF
+      ];
 }
 
 /**
@@ -478,6 +595,19 @@ class ZLibDecoder extends Converter<List<int>, List<int>> {
     }
     return new _ZLibDecoderSink._(sink, windowBits, dictionary, raw);
   }
+
+  /**
+   * Decompresses [bytes] like [convert], but on an IO service thread so that
+   * the isolate is not blocked while decompressing.
+   */
+  Future<List<int>> convertAsync(List<int> bytes) {
+    return _IOService._dispatch(_IOService.filterInflate, [
+      _toUint8List(bytes),
+      windowBits,
+      dictionary == null ? null : _toUint8List(dictionary!),
+      raw
+    ]).then(_filterResult);
+  }
 }
 
 /**
@@ -540,6 +670,33 @@ abstract class RawZLibFilter {
 
   external static RawZLibFilter _makeZLibInflateFilter(
       int windowBits, List<int>? dictionary, bool raw);
+
+  // Returns the CRC-32, if [crc], or Adler-32 checksum of two concatenated
+  // buffers, given their checksums and the length of the second one.
+  external static int _combineChecksums(
+      bool crc, int checksum1, int checksum2, int length2);
+}
+
+// Inputs of [ZLibEncoder.convertAsync] larger than two blocks are compressed
+// in blocks of this size in parallel.
+const int _deflateBlockSize = 128 * 1024;
+// The size of the deflate window, and of the dictionary used for each block.
+const int _deflateDictionarySize = 32 * 1024;
+
+Uint8List _toUint8List(List<int> bytes) =>
+    bytes is Uint8List ? bytes : new Uint8List.fromList(bytes);
+
+List<int> _filterResult(response) {
+  if (_isErrorResponse(response)) throw _filterException(response);
+  return response[1];
+}
+
+Object _filterException(response) {
+  if (response[_errorResponseErrorType] == _osErrorResponse) {
+    return new OSError(response[_osErrorResponseMessage],
+        response[_osErrorResponseErrorCode]);
+  }
+  return new FormatException("Filter error, bad data");
 }
 
 class _BufferSink extends ByteConversionSink {
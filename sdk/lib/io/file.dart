@@ -97,6 +97,31 @@ class FileLock {
   const FileLock._internal(this._type);
 }
 
+/// Hints about how memory mapped by [RandomAccessFileMap.mapSync] is going to
+/// be accessed.
+///
+/// The operating system may use the hint to tune read-ahead and caching of
+/// the mapped pages. Hints are ignored on platforms which do not support them.
+class FileMapAdvice {
+  /// No particular access pattern.
+  static const normal = const FileMapAdvice._internal(0);
+
+  /// The mapping is read sequentially, so pages can be read ahead
+  /// aggressively and dropped soon after they have been accessed.
+  static const sequential = const FileMapAdvice._internal(1);
+
+  /// The mapping is accessed in random order, so read-ahead is not useful.
+  static const random = const FileMapAdvice._internal(2);
+
+  /// The whole mapping is going to be accessed soon, so it can be read into
+  /// memory ahead of time.
+  static const willNeed = const FileMapAdvice._internal(3);
+
+  final int _type;
+
+  const FileMapAdvice._internal(this._type);
+}
+
 /**
  * A reference to a file on the file system.
  *
@@ -950,6 +975,59 @@ abstract class RandomAccessFile {
   String get path;
 }
 
+/// Implemented by [RandomAccessFile]s that can map a file into memory.
+abstract class _MappableRandomAccessFile {
+  Uint8List _mapSync(int start, int end, FileMapAdvice advice);
+}
+
+/// Mapping a [RandomAccessFile] into memory.
+extension RandomAccessFileMap on RandomAccessFile {
+  /**
+   * Maps the bytes from [start] to [end] of the file into memory and returns
+   * them as an unmodifiable [Uint8List], without copying them into the Dart
+   * heap.
+   *
+   * If [end] is omitted, the file is mapped up to its current length. Pages
+   * of the file are only read when they are first accessed, and [advice]
+   * tells the operating system how the list is going to be accessed.
+   *
+   * The mapping is read-only. It stays valid after the file is closed and is
+   * released when the list is garbage collected. Accessing the list after
+   * the file has been truncated below [end] may crash the process on some
+   * platforms.
+   *
+   * A [RandomAccessFile] which is not opened by `dart:io` cannot be mapped.
+   * For such files the range is read into a new list instead.
+   *
+   * Throws a [FileSystemException] if the operation fails.
+   */
+  Uint8List mapSync(
+      {int start = 0, int? end, FileMapAdvice advice = FileMapAdvice.normal}) {
+    // TODO(40614): Remove once non-nullability is sound.
+    ArgumentError.checkNotNull(start, "start");
+    ArgumentError.checkNotNull(advice, "advice");
+    end = RangeError.checkValidRange(start, end, lengthSync());
+    if (end == start) return new UnmodifiableUint8ListView(new Uint8List(0));
+    if (this is _MappableRandomAccessFile) {
+      return (this as _MappableRandomAccessFile)._mapSync(start, end, advice);
+    }
+    final position = positionSync();
+    final result = new Uint8List(end - start);
+    try {
+      setPositionSync(start);
+      int read = 0;
+      while (read < result.length) {
+        final count = readIntoSync(result, read);
+        if (count == 0) break;
+        read += count;
+      }
+    } finally {
+      setPositionSync(position);
+    }
+    return new UnmodifiableUint8ListView(result);
+  }
+}
+
 /**
  * Exception thrown when a file operation fails.
  */
@@ -27,12 +27,18 @@ class _FileStream extends Stream<List<int>> {
 
   bool _atEnd = false;
 
+  // Whether the stream has been listened to. Sockets send the file of a
+  // stream that has not been listened to directly, see
+  // _SocketStreamConsumer.
+  bool _listened = false;
+
   _FileStream(this._path, int? position, this._end) : _position = position ?? 0;
 
   _FileStream.forStdin() : _position = 0;
 
   StreamSubscription<Uint8List> listen(void onData(Uint8List event)?,
       {Function? onError, void onDone()?, bool? cancelOnError}) {
+    _listened = true;
     _controller = new StreamController<Uint8List>(
         sync: true,
         onListen: _start,
@@ -505,7 +511,40 @@ class _File extends FileSystemEntity implements File {
     return new IOSink(consumer, encoding: encoding);
   }
 
+  // The status of a fileReadAll request, which is the first element of its
+  // response. Keep in sync with ReadAllStatus in runtime/bin/file.cc.
+  static const int _readAllSuccess = 0;
+  static const int _readAllUnsupported = 1;
+  static const int _readAllOpenFailed = 2;
+  static const int _readAllLengthFailed = 3;
+  static const int _readAllReadFailed = 4;
+
   Future<Uint8List> readAsBytes() {
+    // Open, read and close the file with a single IO service request. The
+    // file is listed among the open files while the request is pending.
+    _RandomAccessFile._maybeConnectHandler();
+    var resourceInfo = new _FileResourceInfo(this);
+    return _dispatchWithNamespace(_IOService.fileReadAll, [null, _rawPath])
+        .then((response) {
+      _FileResourceInfo.fileClosed(resourceInfo);
+      switch (response[0]) {
+        case _readAllSuccess:
+          return response[1];
+        case _readAllUnsupported:
+          return _readAsBytes();
+        case _readAllOpenFailed:
+          throw _exceptionFromResponse(response[1], "Cannot open file", path);
+        case _readAllLengthFailed:
+          throw _exceptionFromResponse(response[1], "length failed", path);
+        case _readAllReadFailed:
+          throw _exceptionFromResponse(response[1], "read failed", path);
+        default:
+          throw new FileSystemException("Cannot read file", path);
+      }
+    });
+  }
+
+  Future<Uint8List> _readAsBytes() {
     Future<Uint8List> readDataChunked(RandomAccessFile file) {
       var builder = new BytesBuilder(copy: false);
       var completer = new Completer<Uint8List>();
@@ -659,9 +698,10 @@ abstract class _RandomAccessFileOps {
   length();
   flush();
   lock(int lock, int start, int end);
+  map(int start, int end, int advice);
 }
 
-class _RandomAccessFile implements RandomAccessFile {
+class _RandomAccessFile implements RandomAccessFile, _MappableRandomAccessFile {
   static bool _connectedResourceHandler = false;
 
   final String path;
@@ -683,7 +723,7 @@ class _RandomAccessFile implements RandomAccessFile {
     }
   }
 
-  _maybeConnectHandler() {
+  static _maybeConnectHandler() {
     if (!_connectedResourceHandler) {
       // TODO(ricow): We probably need to set these in some initialization code.
       // We need to make sure that these are always available from the
@@ -1049,6 +1089,15 @@ class _RandomAccessFile implements RandomAccessFile {
     }
   }
 
+  Uint8List _mapSync(int start, int end, FileMapAdvice advice) {
+    _checkAvailable();
+    var result = _ops.map(start, end, advice._type);
+    if (result is OSError) {
+      throw new FileSystemException("map failed", path, result);
+    }
+    return new UnmodifiableUint8ListView(result);
+  }
+
   bool closed = false;
 
   // WARNING:
@@ -49,6 +49,10 @@ class _IOService {
   static const int directoryListStop = 40;
   static const int directoryRename = 41;
   static const int sslProcessFilter = 42;
+  static const int fileReadAll = 43;
+  static const int filterDeflate = 44;
+  static const int filterDeflateBlock = 45;
+  static const int filterInflate = 46;
 
   external static Future _dispatch(int request, List data);
 }
@@ -431,6 +431,10 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   static const int writeEncryptedId = 3;
   static const int bufferCount = 4;
 
+  // Filter requests with at most this many bytes to encrypt or decrypt are
+  // processed synchronously instead of by the IO service.
+  static const int syncFilterLimit = 16 * 1024;
+
   // Is a buffer identifier for an encrypted buffer?
   static bool _isBufferEncrypted(int identifier) =>
       identifier >= readEncryptedId;
@@ -1026,84 +1030,103 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
 
   Future<_FilterStatus> _pushAllFilterStages() {
     bool wasInHandshake = _status != connectedStatus;
-    List args = new List<dynamic>.filled(2 + bufferCount * 2, null);
-    args[0] = _secureFilter!._pointer();
-    args[1] = wasInHandshake;
     var bufs = _secureFilter!.buffers!;
+    List<int> positions = new List<int>.filled(bufferCount * 2, 0);
     for (var i = 0; i < bufferCount; ++i) {
-      args[2 * i + 2] = bufs[i].start;
-      args[2 * i + 3] = bufs[i].end;
+      positions[2 * i] = bufs[i].start;
+      positions[2 * i + 1] = bufs[i].end;
     }
 
+    // During the handshake only encrypted data is copied, and small amounts
+    // of data are quickly encrypted or decrypted. In both cases the round
+    // trip to the IO service costs more than filtering on this thread.
+    if (wasInHandshake ||
+        bufs[writePlaintextId].length + bufs[readEncryptedId].length <=
+            syncFilterLimit) {
+      return new Future<_FilterStatus>.sync(() => _processFilterResponse(
+          _secureFilter!.processAllBuffers(wasInHandshake, positions),
+          bufs,
+          wasInHandshake));
+    }
+    List args = new List<dynamic>.filled(2 + bufferCount * 2, null);
+    args[0] = _secureFilter!._pointer();
+    args[1] = wasInHandshake;
+    args.setRange(2, args.length, positions);
     return _IOService._dispatch(_IOService.sslProcessFilter, args)
-        .then((response) {
-      if (response.length == 2) {
-        if (wasInHandshake) {
-          // If we're in handshake, throw a handshake error.
-          _reportError(
-              new HandshakeException('${response[1]} error ${response[0]}'),
-              null);
-        } else {
-          // If we're connected, throw a TLS error.
-          _reportError(
-              new TlsException('${response[1]} error ${response[0]}'), null);
-        }
+        .then((response) =>
+            _processFilterResponse(response, bufs, wasInHandshake));
+  }
+
+  // Updates the buffers from the response of a filter request, and returns
+  // the resulting status.
+  _FilterStatus _processFilterResponse(
+      List response, List<_ExternalBuffer> bufs, bool wasInHandshake) {
+    if (response.length == 2) {
+      if (wasInHandshake) {
+        // If we're in handshake, throw a handshake error.
+        _reportError(
+            new HandshakeException('${response[1]} error ${response[0]}'),
+            null);
+      } else {
+        // If we're connected, throw a TLS error.
+        _reportError(
+            new TlsException('${response[1]} error ${response[0]}'), null);
       }
-      int start(int index) => response[2 * index];
-      int end(int index) => response[2 * index + 1];
-
-      _FilterStatus status = new _FilterStatus();
-      // Compute writeEmpty as "write plaintext buffer and write encrypted
-      // buffer were empty when we started and are empty now".
-      status.writeEmpty = bufs[writePlaintextId].isEmpty &&
-          start(writeEncryptedId) == end(writeEncryptedId);
-      // If we were in handshake when this started, _writeEmpty may be false
-      // because the handshake wrote data after we checked.
-      if (wasInHandshake) status.writeEmpty = false;
-
-      // Compute readEmpty as "both read buffers were empty when we started
-      // and are empty now".
-      status.readEmpty = bufs[readEncryptedId].isEmpty &&
-          start(readPlaintextId) == end(readPlaintextId);
-
-      _ExternalBuffer buffer = bufs[writePlaintextId];
-      int new_start = start(writePlaintextId);
-      if (new_start != buffer.start) {
-        status.progress = true;
-        if (buffer.free == 0) {
-          status.writePlaintextNoLongerFull = true;
-        }
-        buffer.start = new_start;
+    }
+    int start(int index) => response[2 * index];
+    int end(int index) => response[2 * index + 1];
+
+    _FilterStatus status = new _FilterStatus();
+    // Compute writeEmpty as "write plaintext buffer and write encrypted
+    // buffer were empty when we started and are empty now".
+    status.writeEmpty = bufs[writePlaintextId].isEmpty &&
+        start(writeEncryptedId) == end(writeEncryptedId);
+    // If we were in handshake when this started, _writeEmpty may be false
+    // because the handshake wrote data after we checked.
+    if (wasInHandshake) status.writeEmpty = false;
+
+    // Compute readEmpty as "both read buffers were empty when we started
+    // and are empty now".
+    status.readEmpty = bufs[readEncryptedId].isEmpty &&
+        start(readPlaintextId) == end(readPlaintextId);
+
+    _ExternalBuffer buffer = bufs[writePlaintextId];
+    int new_start = start(writePlaintextId);
+    if (new_start != buffer.start) {
+      status.progress = true;
+      if (buffer.free == 0) {
+        status.writePlaintextNoLongerFull = true;
       }
-      buffer = bufs[readEncryptedId];
-      new_start = start(readEncryptedId);
-      if (new_start != buffer.start) {
-        status.progress = true;
-        if (buffer.free == 0) {
-          status.readEncryptedNoLongerFull = true;
-        }
-        buffer.start = new_start;
+      buffer.start = new_start;
+    }
+    buffer = bufs[readEncryptedId];
+    new_start = start(readEncryptedId);
+    if (new_start != buffer.start) {
+      status.progress = true;
+      if (buffer.free == 0) {
+        status.readEncryptedNoLongerFull = true;
       }
-      buffer = bufs[writeEncryptedId];
-      int new_end = end(writeEncryptedId);
-      if (new_end != buffer.end) {
-        status.progress = true;
-        if (buffer.length == 0) {
-          status.writeEncryptedNoLongerEmpty = true;
-        }
-        buffer.end = new_end;
+      buffer.start = new_start;
+    }
+    buffer = bufs[writeEncryptedId];
+    int new_end = end(writeEncryptedId);
+    if (new_end != buffer.end) {
+      status.progress = true;
+      if (buffer.length == 0) {
+        status.writeEncryptedNoLongerEmpty = true;
       }
-      buffer = bufs[readPlaintextId];
-      new_end = end(readPlaintextId);
-      if (new_end != buffer.end) {
-        status.progress = true;
-        if (buffer.length == 0) {
-          status.readPlaintextNoLongerEmpty = true;
-        }
-        buffer.end = new_end;
+      buffer.end = new_end;
+    }
+    buffer = bufs[readPlaintextId];
+    new_end = end(readPlaintextId);
+    if (new_end != buffer.end) {
+      status.progress = true;
+      if (buffer.length == 0) {
+        status.readPlaintextNoLongerEmpty = true;
       }
-      return status;
-    });
+      buffer.end = new_end;
+    }
+    return status;
   }
 }
 
@@ -1251,6 +1274,10 @@ abstract class _SecureFilter {
   void init();
   X509Certificate? get peerCertificate;
   int processBuffer(int bufferIndex);
+  // Processes all buffers synchronously, given their start and end
+  // positions. Returns the same response as a filter request to the IO
+  // service.
+  List processAllBuffers(bool inHandshake, List<int> positions);
   void registerBadCertificateCallback(Function callback);
   void registerHandshakeCompleteCallback(Function handshakeCompleteHandler);
 
@@ -183,6 +183,47 @@ abstract class SecurityContext {
    */
   void setAlpnProtocols(List<String> protocols, bool isServer);
 
+  /**
+   * Configures the cache of TLS sessions that lets clients reconnecting to a
+   * [SecureServerSocket] resume their previous session instead of doing a
+   * full handshake.
+   *
+   * The cache is shared by all server connections of the process, including
+   * those of other isolates. A session is only resumed by a connection using
+   * the same certificate and, if client certificates are requested, the same
+   * [SecurityContext].
+   *
+   * At most [maximumSessions] sessions are cached, dropping the oldest first.
+   * A [maximumSessions] of 0 disables the cache. If [timeout] is given,
+   * sessions can only be resumed for that long. If [sessionTickets] is false,
+   * clients are not given session tickets, which resume a session without
+   * the server caching it.
+   */
+  external static void configureServerSessionCache(
+      {int maximumSessions: 20480,
+      Duration? timeout,
+      bool sessionTickets: true});
+
+  /**
+   * Replaces the key used to encrypt new session tickets.
+   *
+   * Session tickets encrypted with the previous key are still accepted, and
+   * are replaced by tickets encrypted with the new key. Older tickets are
+   * rejected, and the client does a full handshake.
+   *
+   * If [key] is given it must contain 48 bytes: a 16 byte key name, a 16 byte
+   * HMAC key and a 16 byte AES key. Using the same keys in several processes
+   * lets tickets issued by one be accepted by the others. Otherwise a random
+   * key is used.
+   */
+  external static void rotateSessionTicketKey([List<int>? key]);
+
+  /**
+   * Statistics of the handshakes of [SecureServerSocket] connections in the
+   * process, and of the size of the session cache.
+   */
+  external static TlsSessionStatistics get serverSessionStatistics;
+
   /// Encodes a set of supported protocols for ALPN/NPN usage.
   ///
   /// The `protocols` list is expected to contain protocols in descending order
@@ -281,3 +322,24 @@ abstract class SecurityContext {
     return new Uint8List.fromList(bytes);
   }
 }
+
+/**
+ * Statistics of TLS session resumption by [SecureServerSocket] connections.
+ *
+ * See [SecurityContext.serverSessionStatistics].
+ */
+class TlsSessionStatistics {
+  /// The number of handshakes that resumed a previous session.
+  final int hits;
+
+  /// The number of full handshakes.
+  final int misses;
+
+  /// The number of sessions in the session cache.
+  final int cachedSessions;
+
+  TlsSessionStatistics._(this.hits, this.misses, this.cachedSessions);
+
+  String toString() => 'TlsSessionStatistics(hits: $hits, misses: $misses, '
+      'cachedSessions: $cachedSessions)';
+}
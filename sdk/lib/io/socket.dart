@@ -1094,6 +1094,94 @@ abstract class RawDatagramSocket extends Stream<RawSocketEvent> {
   void setRawOption(RawSocketOption option);
 }
 
+/// Implemented by [RawSocket]s that can read directly into a caller
+/// supplied buffer.
+abstract class _ReadIntoSocket {
+  int _readInto(Uint8List buffer, int start, int end);
+}
+
+/// Reading from a [RawSocket] into an existing buffer.
+extension RawSocketReadInto on RawSocket {
+  /**
+   * Read up to `end - start` bytes from the socket into [buffer], starting
+   * at index [start]. If [end] is omitted, it defaults to the length of
+   * [buffer].
+   *
+   * This function is non-blocking and, unlike [RawSocket.read], does not
+   * allocate a new list for the data. Returns the number of bytes read,
+   * which is 0 if no data is available for immediate reading.
+   */
+  int readInto(Uint8List buffer, [int start = 0, int? end]) {
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (this is _ReadIntoSocket) {
+      return (this as _ReadIntoSocket)._readInto(buffer, start, end);
+    }
+    if (start == end) return 0;
+    final data = read(end - start);
+    if (data == null) return 0;
+    buffer.setRange(start, start + data.length, data);
+    return data.length;
+  }
+}
+
+/// Implemented by [RawDatagramSocket]s that can send and receive several
+/// datagrams with a single system call.
+abstract class _BatchDatagramSocket {
+  int _sendBatch(List<Datagram> datagrams);
+  List<Datagram> _receiveBatch(int maxDatagrams);
+}
+
+/// Batched sending and receiving of datagrams.
+extension RawDatagramSocketBatches on RawDatagramSocket {
+  /**
+   * Send a batch of datagrams.
+   *
+   * The [Datagram.data] of each of the [datagrams] is sent to its
+   * [Datagram.address] and [Datagram.port], in order. Where the platform
+   * supports it, several datagrams are sent with a single system call.
+   *
+   * Returns the number of datagrams sent. If it is less than the length of
+   * [datagrams] the remaining ones should be sent again once a
+   * [RawSocketEvent.write] event is received.
+   */
+  int sendBatch(List<Datagram> datagrams) {
+    if (this is _BatchDatagramSocket) {
+      return (this as _BatchDatagramSocket)._sendBatch(datagrams);
+    }
+    for (int i = 0; i < datagrams.length; i++) {
+      final datagram = datagrams[i];
+      if (send(datagram.data, datagram.address, datagram.port) == 0) {
+        return i;
+      }
+    }
+    return datagrams.length;
+  }
+
+  /**
+   * Receive up to [maxDatagrams] datagrams. If there are no datagrams
+   * available an empty list is returned.
+   *
+   * Where the platform supports it, several datagrams are received with a
+   * single system call. As for [receive], the maximum length of each
+   * datagram is 65503 bytes.
+   */
+  List<Datagram> receiveBatch(int maxDatagrams) {
+    if (maxDatagrams <= 0) {
+      throw RangeError.range(maxDatagrams, 1, null, "maxDatagrams");
+    }
+    if (this is _BatchDatagramSocket) {
+      return (this as _BatchDatagramSocket)._receiveBatch(maxDatagrams);
+    }
+    final datagrams = <Datagram>[];
+    while (datagrams.length < maxDatagrams) {
+      final datagram = receive();
+      if (datagram == null) break;
+      datagrams.add(datagram);
+    }
+    return datagrams;
+  }
+}
+
 /// Exception thrown when a socket operation fails.
 class SocketException implements IOException {
   /// Description of the error.
@@ -788,3 +788,111 @@ abstract class TransferableTypedData {
    */
   ByteBuffer materialize();
 }
+
+/**
+ * A bounded queue of fixed size records in memory shared by isolates.
+ *
+ * Records are pushed and popped without sending messages, so a
+ * [SharedRingBuffer] can pass many small records per second from producer
+ * isolates to consumer isolates. Any number of isolates can push and pop
+ * records at the same time.
+ *
+ * A [SharedRingBuffer] cannot be sent to another isolate. Instead, send a
+ * [SharedRingBufferTicket] created by [share], and attach to the same buffer
+ * in the receiving isolate with [SharedRingBuffer.attach].
+ *
+ * The memory of the buffer is released when every isolate attached to it
+ * has closed it or no longer references it, and every ticket has been used
+ * or revoked.
+ */
+@Since("2.11")
+abstract class SharedRingBuffer {
+  /**
+   * Creates a buffer of [capacity] records of [recordSize] bytes each.
+   *
+   * The [capacity] is rounded up to a power of two. The [recordSize] must be
+   * at most 65536, and the [capacity] at most 16777216.
+   */
+  external factory SharedRingBuffer(int recordSize, int capacity);
+
+  /**
+   * Attaches to the buffer that [ticket] was created for.
+   *
+   * A ticket can only be used once, even if it was sent to several isolates.
+   */
+  external factory SharedRingBuffer.attach(SharedRingBufferTicket ticket);
+
+  /** The size of every record in bytes. */
+  int get recordSize;
+
+  /** The maximum number of records in the buffer. */
+  int get capacity;
+
+  /**
+   * The number of records in the buffer.
+   *
+   * The buffer may be changed by other isolates at any time, so the length
+   * may already be different when it is returned.
+   */
+  int get length;
+
+  /**
+   * Creates a ticket with which another isolate can attach to this buffer.
+   *
+   * The ticket can be sent through a send port. It is revoked if it has not
+   * been used by the time this buffer is closed in this isolate.
+   */
+  SharedRingBufferTicket share();
+
+  /**
+   * Copies the first [recordSize] bytes of [record] into the buffer.
+   *
+   * Returns false, without blocking, if the buffer is full.
+   */
+  bool tryPush(TypedData record);
+
+  /**
+   * Copies the oldest record of the buffer into the first [recordSize] bytes
+   * of [record], and removes it from the buffer.
+   *
+   * Returns false, without blocking, if the buffer is empty.
+   */
+  bool tryPop(TypedData record);
+
+  /**
+   * Returns a future that completes once the buffer is not empty.
+   *
+   * Only one isolate at a time can wait for the buffer to be not empty. If
+   * another wait starts before the future completes, the future completes
+   * right away. Either way the buffer may be empty again by the time the
+   * future completes, so [tryPop] may still return false.
+   */
+  Future<void> whenNotEmpty();
+
+  /**
+   * Returns a future that completes once the buffer is not full.
+   *
+   * Only one isolate at a time can wait for the buffer to be not full. If
+   * another wait starts before the future completes, the future completes
+   * right away. Either way the buffer may be full again by the time the
+   * future completes, so [tryPush] may still return false.
+   */
+  Future<void> whenNotFull();
+
+  /**
+   * Detaches this isolate from the buffer.
+   *
+   * The buffer can no longer be used by this isolate afterwards. Futures
+   * returned by [whenNotEmpty] and [whenNotFull] in other isolates complete,
+   * so that they can check whether the buffer is still in use.
+   */
+  void close();
+}
+
+/**
+ * A ticket to attach an isolate to a [SharedRingBuffer].
+ *
+ * Created by [SharedRingBuffer.share], and used by [SharedRingBuffer.attach].
+ */
+@Since("2.11")
+abstract class SharedRingBufferTicket {}
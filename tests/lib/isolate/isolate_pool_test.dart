@@ -0,0 +1,52 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--enable-isolate-groups --isolate-pool-size=2
+// VMOptions=--enable-isolate-groups --isolate-pool-size=0
+// VMOptions=--no-enable-isolate-groups --isolate-pool-size=2
+
+// Tests that isolates taken from the idle isolates of the group behave like
+// isolates created by the spawn.
+
+import 'dart:async';
+import 'dart:isolate';
+
+import 'package:async_helper/async_helper.dart';
+import 'package:expect/expect.dart';
+
+int counter = 0;
+
+void child(SendPort reply) {
+  // Static state is not shared with the parent or the other children.
+  counter++;
+  reply.send([Isolate.current.debugName, counter]);
+}
+
+Future<void> spawnAndWait(String name) async {
+  final port = ReceivePort();
+  final exit = ReceivePort();
+  await Isolate.spawn(child, port.sendPort,
+      debugName: name, onExit: exit.sendPort);
+  final List reply = await port.first;
+  Expect.equals(name, reply[0]);
+  Expect.equals(1, reply[1]);
+  await exit.first;
+}
+
+main() async {
+  asyncStart();
+  counter = 42;
+
+  // Every spawn takes an isolate created after the previous one.
+  for (int i = 0; i < 10; i++) {
+    await spawnAndWait('sequential$i');
+  }
+
+  // Concurrent spawns take more isolates than there are idle ones.
+  await Future.wait(
+      [for (int i = 0; i < 10; i++) spawnAndWait('concurrent$i')]);
+
+  Expect.equals(42, counter);
+  asyncEnd();
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--enable-isolate-groups
+// VMOptions=--no-enable-isolate-groups
+
+import "dart:async";
+import "dart:isolate";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int count = 10000;
+
+// Pops [count] records and replies with their sum.
+Future<void> consumer(List args) async {
+  final ticket = args[0] as SharedRingBufferTicket;
+  final replyPort = args[1] as SendPort;
+  final buffer = SharedRingBuffer.attach(ticket);
+  final record = Int64List(1);
+  int sum = 0;
+  for (int i = 0; i < count; i++) {
+    while (!buffer.tryPop(record)) {
+      await buffer.whenNotEmpty();
+    }
+    sum += record[0];
+  }
+  buffer.close();
+  replyPort.send(sum);
+}
+
+void testPushPop() {
+  final buffer = SharedRingBuffer(8, 3);
+  Expect.equals(8, buffer.recordSize);
+  Expect.equals(4, buffer.capacity);
+  final record = Int64List(1);
+  Expect.isFalse(buffer.tryPop(record));
+  for (int i = 0; i < 4; i++) {
+    record[0] = i;
+    Expect.isTrue(buffer.tryPush(record));
+  }
+  Expect.equals(4, buffer.length);
+  Expect.isFalse(buffer.tryPush(record));
+  for (int i = 0; i < 4; i++) {
+    Expect.isTrue(buffer.tryPop(record));
+    Expect.equals(i, record[0]);
+  }
+  Expect.equals(0, buffer.length);
+
+  // Records must be large enough.
+  Expect.throwsArgumentError(() => buffer.tryPush(Int32List(1)));
+  Expect.throwsArgumentError(() => buffer.tryPop(Uint8List(7)));
+
+  buffer.close();
+  Expect.throwsStateError(() => buffer.tryPush(record));
+  Expect.throwsStateError(() => buffer.length);
+}
+
+void testArguments() {
+  Expect.throwsRangeError(() => SharedRingBuffer(0, 1));
+  Expect.throwsRangeError(() => SharedRingBuffer(8, 0));
+}
+
+void testTicket() {
+  final buffer = SharedRingBuffer(8, 8);
+  final ticket = buffer.share();
+  final attached = SharedRingBuffer.attach(ticket);
+  Expect.isTrue(buffer.tryPush(Int64List.fromList([42])));
+  final record = Int64List(1);
+  Expect.isTrue(attached.tryPop(record));
+  Expect.equals(42, record[0]);
+  // A ticket can only be used once.
+  Expect.throwsArgumentError(() => SharedRingBuffer.attach(ticket));
+  attached.close();
+  buffer.close();
+}
+
+void testRevokedTicket() {
+  final buffer = SharedRingBuffer(8, 8);
+  final ticket = buffer.share();
+  // Tickets that were not used are revoked when the buffer is closed.
+  buffer.close();
+  Expect.throwsArgumentError(() => SharedRingBuffer.attach(ticket));
+}
+
+Future<void> testCloseWakesWaiter() async {
+  final buffer = SharedRingBuffer(8, 8);
+  final attached = SharedRingBuffer.attach(buffer.share());
+  final notEmpty = attached.whenNotEmpty();
+  // Nothing will ever be pushed, so the waiter is woken up.
+  buffer.close();
+  await notEmpty;
+  Expect.equals(0, attached.length);
+  attached.close();
+}
+
+void testNotSendable() {
+  final buffer = SharedRingBuffer(8, 8);
+  final port = ReceivePort();
+  Expect.throws(() => port.sendPort.send(buffer));
+  port.close();
+  buffer.close();
+}
+
+Future<void> testBetweenIsolates() async {
+  final buffer = SharedRingBuffer(8, 64);
+  final replyPort = ReceivePort();
+  await Isolate.spawn(consumer, [buffer.share(), replyPort.sendPort]);
+  final record = Int64List(1);
+  int sum = 0;
+  for (int i = 0; i < count; i++) {
+    record[0] = i;
+    sum += i;
+    while (!buffer.tryPush(record)) {
+      await buffer.whenNotFull();
+    }
+  }
+  Expect.equals(sum, await replyPort.first);
+  buffer.close();
+}
+
+main() async {
+  asyncStart();
+  testPushPop();
+  testArguments();
+  testTicket();
+  testRevokedTicket();
+  await testCloseWakesWaiter();
+  testNotSendable();
+  await testBetweenIsolates();
+  asyncEnd();
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--enable-isolate-groups
+// VMOptions=--enable-isolate-groups --no-copy-isolate-group-messages
+// VMOptions=--no-enable-isolate-groups
+
+// Sends messages to an isolate spawned in the same isolate group. Lists,
+// maps with shared keys, typed data and plain objects are copied from heap
+// to heap. Maps with copied keys, sets and typed data views make the whole
+// message fall back to a snapshot, which has to rehash the maps and sets.
+
+import "dart:async";
+import "dart:isolate";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+class Node {
+  final int value;
+  final List<Node> next = <Node>[];
+  Node(this.value);
+}
+
+class Key {
+  final int id;
+  Key(this.id);
+}
+
+// Only contains objects which are copied or shared.
+List copiedMessage() {
+  var first = new Node(1);
+  var second = new Node(2);
+  first.next.add(second);
+  second.next.add(first);
+  var bytes = new Uint8List(16);
+  bytes[3] = 7;
+  var list = <Object>[first, bytes];
+  list.add(list);
+  return [
+    list,
+    {"first": first, "bytes": bytes},
+    "shared"
+  ];
+}
+
+void checkCopiedMessage(List message) {
+  List list = message[0];
+  Node first = list[0];
+  Node second = first.next[0];
+  Expect.equals(1, first.value);
+  Expect.equals(2, second.value);
+  Expect.identical(first, second.next[0]);
+  Uint8List bytes = list[1];
+  Expect.equals(16, bytes.length);
+  Expect.equals(7, bytes[3]);
+  Expect.identical(list, list[2]);
+  Map map = message[1];
+  Expect.identical(first, map["first"]);
+  Expect.identical(bytes, map["bytes"]);
+  Expect.equals("shared", message[2]);
+}
+
+// Contains objects which can only be sent as a snapshot.
+List fallbackMessage() {
+  var key = new Key(1);
+  var node = new Node(3);
+  var buffer = new Uint8List.fromList([1, 2, 3, 4]).buffer;
+  return [
+    {key: node, new Key(2): "two"},
+    new Set<Object>.from([key, node]),
+    new Uint8List.view(buffer, 1, 2),
+    node
+  ];
+}
+
+void checkFallbackMessage(List message) {
+  Map map = message[0];
+  Set set = message[1];
+  Uint8List view = message[2];
+  Node node = message[3];
+  Expect.equals(2, map.length);
+  // The keys are copies, so this only works if the map was rehashed.
+  for (var key in map.keys) {
+    Key k = key;
+    Expect.isTrue(map.containsKey(k));
+    if (k.id == 1) {
+      Expect.identical(node, map[k]);
+      Expect.isTrue(set.contains(k));
+    } else {
+      Expect.equals("two", map[k]);
+      Expect.isFalse(set.contains(k));
+    }
+  }
+  Expect.isTrue(set.contains(node));
+  Expect.equals(2, set.length);
+  Expect.listEquals([2, 3], view);
+}
+
+void worker(SendPort replyPort) {
+  var receivePort = new ReceivePort();
+  replyPort.send(receivePort.sendPort);
+  receivePort.listen((message) {
+    List request = message;
+    List payload = request[1];
+    if (request[0] == "copied") {
+      checkCopiedMessage(payload);
+    } else {
+      checkFallbackMessage(payload);
+    }
+    // Send the received message back, so it is copied once more.
+    replyPort.send(payload);
+  });
+}
+
+main() async {
+  asyncStart();
+  var receivePort = new ReceivePort();
+  var isolate = await Isolate.spawn(worker, receivePort.sendPort);
+  var replies = new StreamIterator<dynamic>(receivePort);
+
+  Expect.isTrue(await replies.moveNext());
+  SendPort workerPort = replies.current;
+
+  workerPort.send(["copied", copiedMessage()]);
+  Expect.isTrue(await replies.moveNext());
+  checkCopiedMessage(replies.current);
+
+  workerPort.send(["fallback", fallbackMessage()]);
+  Expect.isTrue(await replies.moveNext());
+  checkFallbackMessage(replies.current);
+
+  // A message mixing both kinds is sent as a snapshot as a whole.
+  workerPort.send(["fallback", fallbackMessage()..add(copiedMessage())]);
+  Expect.isTrue(await replies.moveNext());
+  List mixed = replies.current;
+  checkFallbackMessage(mixed);
+  checkCopiedMessage(mixed[4]);
+
+  isolate.kill();
+  await replies.cancel();
+  asyncEnd();
+}
@@ -10,8 +10,8 @@ import "package:expect/expect.dart";
 
 void testPauseList() {
   asyncStart();
-  // TOTAL should be bigger the our directory listing buffer.
-  const int TOTAL = 128;
+  // TOTAL should be bigger than the number of entries returned per request.
+  const int TOTAL = 1024;
   Directory.systemTemp.createTemp('dart_directory_list_pause').then((d) {
     for (int i = 0; i < TOTAL; i++) {
       new Directory("${d.path}/$i").createSync();
@@ -44,8 +44,8 @@ void testPauseList() {
 
 void testPauseResumeCancelList() {
   asyncStart();
-  // TOTAL should be bigger the our directory listing buffer.
-  const int TOTAL = 128;
+  // TOTAL should be bigger than the number of entries returned per request.
+  const int TOTAL = 1024;
   Directory.systemTemp.createTemp('dart_directory_list_pause').then((d) {
     for (int i = 0; i < TOTAL; i++) {
       new Directory("${d.path}/$i").createSync();
@@ -74,8 +74,8 @@ void testPauseResumeCancelList() {
 
 void testListIsEmpty() {
   asyncStart();
-  // TOTAL should be bigger the our directory listing buffer.
-  const int TOTAL = 128;
+  // TOTAL should be bigger than the number of entries returned per request.
+  const int TOTAL = 1024;
   Directory.systemTemp.createTemp('dart_directory_list_pause').then((d) {
     for (int i = 0; i < TOTAL; i++) {
       new Directory("${d.path}/$i").createSync();
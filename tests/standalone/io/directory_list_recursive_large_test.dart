@@ -0,0 +1,54 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Recursively lists directories with more entries than a single list request
+// returns, where subdirectories are listed in the middle of their parents.
+
+import "dart:io";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int filesPerDirectory = 600;
+
+Set<String> createTree(Directory root) {
+  var expected = new Set<String>();
+  void fill(String path, int depth) {
+    for (int i = 0; i < filesPerDirectory; i++) {
+      var file = new File("$path/file_$i");
+      file.createSync();
+      expected.add(file.path);
+    }
+    if (depth == 0) return;
+    for (int i = 0; i < 2; i++) {
+      var directory = new Directory("$path/dir_$i");
+      directory.createSync();
+      expected.add(directory.path);
+      fill(directory.path, depth - 1);
+    }
+  }
+
+  fill(root.path, 2);
+  return expected;
+}
+
+void checkListing(Set<String> expected, List<FileSystemEntity> entities) {
+  var listed = entities.map((entity) => entity.path).toList();
+  Expect.equals(expected.length, listed.length);
+  Expect.setEquals(expected, listed);
+}
+
+main() async {
+  asyncStart();
+  var root = Directory.systemTemp.createTempSync('dart_directory_list_large');
+  try {
+    var expected = createTree(root);
+    Expect.isTrue(expected.length > 1024);
+    checkListing(expected, root.listSync(recursive: true));
+    checkListing(expected, await root.list(recursive: true).toList());
+  } finally {
+    root.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
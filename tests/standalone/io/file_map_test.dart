@@ -0,0 +1,117 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests RandomAccessFileMap.mapSync.
+
+import 'dart:io';
+import 'dart:typed_data';
+
+import "package:expect/expect.dart";
+
+const int fileSize = 3 * 65536 + 123;
+
+Uint8List createContents() {
+  final contents = new Uint8List(fileSize);
+  for (int i = 0; i < contents.length; i++) {
+    contents[i] = i % 251;
+  }
+  return contents;
+}
+
+void testMapWholeFile(File file, Uint8List contents) {
+  final opened = file.openSync();
+  final mapped = opened.mapSync();
+  Expect.equals(contents.length, mapped.length);
+  Expect.listEquals(contents, mapped);
+  opened.closeSync();
+  // The mapping remains valid after the file is closed.
+  Expect.equals(contents[fileSize - 1], mapped[fileSize - 1]);
+}
+
+void testMapRange(File file, Uint8List contents) {
+  final opened = file.openSync();
+  opened.setPositionSync(17);
+  for (final advice in [
+    FileMapAdvice.normal,
+    FileMapAdvice.sequential,
+    FileMapAdvice.random,
+    FileMapAdvice.willNeed
+  ]) {
+    // Unaligned start and end.
+    final mapped = opened.mapSync(start: 4097, end: 70001, advice: advice);
+    Expect.listEquals(contents.sublist(4097, 70001), mapped);
+  }
+  Expect.listEquals(contents.sublist(65536), opened.mapSync(start: 65536));
+  Expect.equals(0, opened.mapSync(start: fileSize).length);
+  // Mapping does not move the file position.
+  Expect.equals(17, opened.positionSync());
+  opened.closeSync();
+}
+
+void testReadOnly(File file, Uint8List contents) {
+  final opened = file.openSync();
+  final mapped = opened.mapSync();
+  Expect.throws<UnsupportedError>(() => mapped[0] = mapped[0] + 1);
+  Expect.throws<UnsupportedError>(
+      () => mapped.buffer.asUint8List()[0] = mapped[0] + 1);
+  Expect.throws<UnsupportedError>(() => opened.mapSync(start: fileSize)[0] = 1);
+  opened.closeSync();
+  Expect.listEquals(contents, mapped);
+  Expect.listEquals(contents, file.readAsBytesSync());
+}
+
+// A RandomAccessFile that is not opened by dart:io.
+class DelegatingRandomAccessFile implements RandomAccessFile {
+  final RandomAccessFile _file;
+
+  DelegatingRandomAccessFile(this._file);
+
+  int lengthSync() => _file.lengthSync();
+  int positionSync() => _file.positionSync();
+  RandomAccessFile setPositionSync(int position) {
+    _file.setPositionSync(position);
+    return this;
+  }
+
+  int readIntoSync(List<int> buffer, [int start = 0, int? end]) =>
+      _file.readIntoSync(buffer, start, end);
+
+  noSuchMethod(Invocation invocation) => super.noSuchMethod(invocation);
+}
+
+void testNotMappable(File file, Uint8List contents) {
+  final opened = file.openSync();
+  final delegating = new DelegatingRandomAccessFile(opened);
+  delegating.setPositionSync(17);
+  final mapped = delegating.mapSync(start: 4097, end: 70001);
+  Expect.listEquals(contents.sublist(4097, 70001), mapped);
+  Expect.throws<UnsupportedError>(() => mapped[0] = 0);
+  Expect.equals(17, opened.positionSync());
+  opened.closeSync();
+}
+
+void testErrors(File file) {
+  final opened = file.openSync();
+  Expect.throws<RangeError>(() => opened.mapSync(start: -1));
+  Expect.throws<RangeError>(() => opened.mapSync(end: fileSize + 1));
+  Expect.throws<RangeError>(() => opened.mapSync(start: 10, end: 5));
+  opened.closeSync();
+  Expect.throws<FileSystemException>(() => opened.mapSync());
+}
+
+void main() {
+  final temp = Directory.systemTemp.createTempSync('file_map_test');
+  try {
+    final file = new File('${temp.path}/data');
+    final contents = createContents();
+    file.writeAsBytesSync(contents);
+    testMapWholeFile(file, contents);
+    testMapRange(file, contents);
+    testReadOnly(file, contents);
+    testNotMappable(file, contents);
+    testErrors(file);
+  } finally {
+    temp.deleteSync(recursive: true);
+  }
+}
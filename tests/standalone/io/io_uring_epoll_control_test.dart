@@ -0,0 +1,129 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=--io_uring
+// VMOptions=--io_uring --short_socket_read --short_socket_write
+
+// Tests the epoll registration changes that the Linux event handler submits
+// through io_uring with --io_uring. Toggling the read and write events of
+// many sockets at once removes and re-adds the same descriptors within one
+// batch of updates, and closing sockets removes them while other updates are
+// still queued. The flag is ignored on other platforms and on kernels
+// without io_uring.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int connectionCount = 50;
+const int dataSize = 64 * 1024;
+
+Future testToggleEvents() async {
+  var server = await RawServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((socket) {
+    // Echo everything back, toggling the write events on every read.
+    var pending = <int>[];
+    socket.listen((event) {
+      switch (event) {
+        case RawSocketEvent.read:
+          var data = socket.read();
+          if (data != null) pending.addAll(data);
+          socket.writeEventsEnabled = false;
+          socket.writeEventsEnabled = true;
+          break;
+        case RawSocketEvent.write:
+          if (pending.isNotEmpty) {
+            int written = socket.write(pending);
+            pending.removeRange(0, written);
+            socket.writeEventsEnabled = true;
+          }
+          break;
+        case RawSocketEvent.readClosed:
+          socket.close();
+          break;
+      }
+    });
+  });
+
+  var data = new Uint8List(dataSize);
+  for (int i = 0; i < dataSize; i++) {
+    data[i] = i & 0xff;
+  }
+  var done = <Future>[];
+  for (int i = 0; i < connectionCount; i++) {
+    var socket =
+        await RawSocket.connect(InternetAddress.loopbackIPv4, server.port);
+    var completer = new Completer();
+    done.add(completer.future);
+    int written = 0;
+    int received = 0;
+    socket.listen((event) {
+      switch (event) {
+        case RawSocketEvent.read:
+          var bytes = socket.read();
+          if (bytes == null) break;
+          for (int j = 0; j < bytes.length; j++) {
+            Expect.equals((received + j) & 0xff, bytes[j]);
+          }
+          received += bytes.length;
+          // Remove and re-add the descriptor within the same batch.
+          socket.readEventsEnabled = false;
+          socket.readEventsEnabled = true;
+          if (received == dataSize) {
+            socket.close();
+            completer.complete();
+          }
+          break;
+        case RawSocketEvent.write:
+          written += socket.write(data, written);
+          if (written < dataSize) socket.writeEventsEnabled = true;
+          break;
+        case RawSocketEvent.readClosed:
+          break;
+      }
+    });
+  }
+  await Future.wait(done);
+  await server.close();
+}
+
+Future testCloseWithPendingUpdates() async {
+  var server = await RawServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  var accepted = 0;
+  var allAccepted = new Completer();
+  server.listen((socket) {
+    socket.writeEventsEnabled = true;
+    socket.close();
+    if (++accepted == connectionCount) allAccepted.complete();
+  });
+  var closed = <Future>[];
+  for (int i = 0; i < connectionCount; i++) {
+    var socket =
+        await RawSocket.connect(InternetAddress.loopbackIPv4, server.port);
+    var completer = new Completer();
+    closed.add(completer.future);
+    socket.listen((event) {
+      if (event == RawSocketEvent.readClosed) {
+        socket.close();
+        completer.complete();
+      }
+    });
+    socket.writeEventsEnabled = false;
+    socket.readEventsEnabled = false;
+    socket.readEventsEnabled = true;
+  }
+  await allAccepted.future;
+  await Future.wait(closed);
+  await server.close();
+}
+
+main() async {
+  asyncStart();
+  await testToggleEvents();
+  await testCloseWithPendingUpdates();
+  asyncEnd();
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_read
+// VMOptions=--short_socket_write
+// VMOptions=--short_socket_read --short_socket_write
+
+// Tests RawSocket.read with counts that take the different native read
+// paths: small counts are read into the shared per-isolate buffer
+// (Socket_ReadInto) and large counts into an external buffer (Socket_Read),
+// which is shrunk when fewer bytes than requested were read.
+
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int dataSize = 200000;
+
+// Counts of at most 16KB use Socket_ReadInto. A count of 1MB is always larger
+// than what is available, so Socket_Read shrinks its buffer.
+const List<int?> readCounts = const [1, 100, 16 * 1024, 16 * 1024 + 1, null];
+const int largeCount = 1024 * 1024;
+
+void testReadSizes() {
+  asyncStart();
+  var data = new Uint8List(dataSize);
+  for (int i = 0; i < dataSize; i++) {
+    data[i] = i & 0xff;
+  }
+  RawServerSocket.bind(InternetAddress.loopbackIPv4, 0).then((server) {
+    server.listen((socket) {
+      int offset = 0;
+      socket.listen((event) {
+        if (event == RawSocketEvent.write) {
+          offset += socket.write(data, offset);
+          if (offset < dataSize) {
+            socket.writeEventsEnabled = true;
+          } else {
+            socket.shutdown(SocketDirection.send);
+          }
+        }
+      });
+    });
+    RawSocket.connect(InternetAddress.loopbackIPv4, server.port)
+        .then((socket) {
+      int received = 0;
+      int reads = 0;
+      socket.listen((event) {
+        if (event == RawSocketEvent.read) {
+          // Alternate between the counts in [readCounts] and [largeCount].
+          int? count = (reads % 2 == 1)
+              ? largeCount
+              : readCounts[(reads ~/ 2) % readCounts.length];
+          reads++;
+          var bytes = socket.read(count);
+          if (bytes == null) return;
+          Expect.isTrue(bytes.length > 0);
+          if (count != null) Expect.isTrue(bytes.length <= count);
+          for (int i = 0; i < bytes.length; i++) {
+            Expect.equals((received + i) & 0xff, bytes[i]);
+          }
+          received += bytes.length;
+        } else if (event == RawSocketEvent.readClosed) {
+          Expect.equals(dataSize, received);
+          socket.close();
+          server.close();
+          asyncEnd();
+        }
+      });
+    });
+  });
+}
+
+void main() {
+  testReadSizes();
+}
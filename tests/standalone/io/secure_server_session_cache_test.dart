@@ -0,0 +1,75 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests the configuration of the process wide TLS session cache and the
+// handshake statistics of server connections. SecureSocket clients do not
+// offer previous sessions, so resumption itself is tested by the
+// SSLSessionCache tests in runtime/bin/security_context_test.cc.
+//
+// OtherResources=certificates/server_chain.pem
+// OtherResources=certificates/server_key.pem
+// OtherResources=certificates/trusted_certs.pem
+
+import "dart:async";
+import "dart:io";
+
+import "package:expect/expect.dart";
+import "package:async_helper/async_helper.dart";
+
+String localFile(path) => Platform.script.resolve(path).toFilePath();
+
+SecurityContext serverContext = new SecurityContext()
+  ..useCertificateChain(localFile('certificates/server_chain.pem'))
+  ..usePrivateKey(localFile('certificates/server_key.pem'),
+      password: 'dartdart');
+
+SecurityContext clientContext = new SecurityContext()
+  ..setTrustedCertificates(localFile('certificates/trusted_certs.pem'));
+
+void testArguments() {
+  Expect.throwsArgumentError(
+      () => SecurityContext.configureServerSessionCache(maximumSessions: -1));
+  Expect.throwsArgumentError(() => SecurityContext.configureServerSessionCache(
+      timeout: const Duration(milliseconds: 10)));
+  Expect.throwsArgumentError(() =>
+      SecurityContext.rotateSessionTicketKey(new List<int>.filled(47, 0)));
+}
+
+Future testHandshakeStatistics() async {
+  SecurityContext.configureServerSessionCache(
+      maximumSessions: 16, timeout: const Duration(minutes: 1));
+  SecurityContext.rotateSessionTicketKey();
+  SecurityContext.rotateSessionTicketKey(new List<int>.generate(48, (i) => i));
+
+  TlsSessionStatistics before = SecurityContext.serverSessionStatistics;
+  const int connections = 5;
+  SecureServerSocket server = await SecureServerSocket.bind(
+      InternetAddress.loopbackIPv4, 0, serverContext);
+  server.listen((SecureSocket client) {
+    client.listen(null, onDone: client.close);
+  });
+  for (int i = 0; i < connections; i++) {
+    SecureSocket socket = await SecureSocket.connect(
+        InternetAddress.loopbackIPv4, server.port,
+        context: clientContext);
+    socket.close();
+    await socket.drain();
+  }
+  await server.close();
+
+  TlsSessionStatistics after = SecurityContext.serverSessionStatistics;
+  Expect.equals(connections,
+      (after.hits - before.hits) + (after.misses - before.misses));
+  Expect.isTrue(after.cachedSessions <= 16);
+
+  SecurityContext.configureServerSessionCache(maximumSessions: 0);
+  Expect.equals(0, SecurityContext.serverSessionStatistics.cachedSessions);
+  SecurityContext.configureServerSessionCache();
+}
+
+void main() {
+  testArguments();
+  asyncStart();
+  testHandshakeStatistics().then((_) => asyncEnd());
+}
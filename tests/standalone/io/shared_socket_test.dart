@@ -4,6 +4,7 @@
 
 // VMOptions=--enable-isolate-groups
 // VMOptions=--no-enable-isolate-groups
+// VMOptions=--enable-isolate-groups --listen_reuse_port
 
 import 'dart:async';
 import 'dart:io';
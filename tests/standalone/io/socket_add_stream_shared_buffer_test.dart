@@ -0,0 +1,49 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--verify_acquired_data
+// VMOptions=--short_socket_write
+//
+// Tests that a buffer added to a socket several times is written each time,
+// also when the copies are queued behind each other.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int chunkCount = 1000;
+
+main() {
+  asyncStart();
+  var shared = new Uint8List(1024);
+  for (int i = 0; i < shared.length; i++) {
+    shared[i] = i & 0xFF;
+  }
+  ServerSocket.bind(InternetAddress.loopbackIPv4, 0).then((server) {
+    server.listen((client) {
+      int received = 0;
+      client.listen((data) {
+        for (int i = 0; i < data.length; i++) {
+          Expect.equals((received + i) & 0xFF, data[i]);
+        }
+        received += data.length;
+      }, onDone: () {
+        Expect.equals(chunkCount * shared.length, received);
+        client.close();
+        server.close();
+        asyncEnd();
+      });
+    });
+    Socket.connect(server.address, server.port).then((socket) {
+      var chunks = new List<List<int>>.filled(chunkCount, shared);
+      socket.addStream(new Stream.fromIterable(chunks)).then((_) {
+        return socket.close();
+      });
+    });
+  });
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests compressing and decompressing with ZLibEncoder.convertAsync and
+// ZLibDecoder.convertAsync, including inputs large enough to be compressed
+// in parallel blocks.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+// Compressible data that is not just repeated bytes, so that blocks refer to
+// the data of the previous block.
+Uint8List makeData(int length) {
+  var data = new Uint8List(length);
+  for (int i = 0; i < length; i++) {
+    data[i] = (i * 7 + (i >> 10)) % 251;
+  }
+  return data;
+}
+
+Future testRoundTrip(int length,
+    {bool gzip: false, bool raw: false, int level: 6}) async {
+  var data = makeData(length);
+  var encoder = new ZLibEncoder(gzip: gzip, raw: raw, level: level);
+  var decoder = new ZLibDecoder(raw: raw);
+  var compressed = await encoder.convertAsync(data);
+  Expect.listEquals(data, decoder.convert(compressed));
+  Expect.listEquals(data, await decoder.convertAsync(compressed));
+  Expect.listEquals(data, await decoder.convertAsync(encoder.convert(data)));
+}
+
+Future testHeaders() async {
+  // The headers of streams compressed in blocks match those written by zlib.
+  var data = makeData(1024 * 1024);
+  for (int level in [-1, 1, 4, 6, 9]) {
+    for (bool gzip in [false, true]) {
+      var encoder = new ZLibEncoder(gzip: gzip, level: level);
+      var blocks = await encoder.convertAsync(data);
+      var stream = encoder.convert(data);
+      // The last byte of the gzip header is the operating system, which
+      // depends on how zlib was built.
+      Expect.listEquals(
+          stream.sublist(0, gzip ? 9 : 2), blocks.sublist(0, gzip ? 9 : 2));
+      // The trailers hold the same checksums and, for gzip, length.
+      Expect.listEquals(stream.sublist(stream.length - (gzip ? 8 : 4)),
+          blocks.sublist(blocks.length - (gzip ? 8 : 4)));
+    }
+  }
+}
+
+Future testDictionary() async {
+  var dictionary = [1, 2, 3, 4, 5];
+  var data = makeData(1024 * 1024);
+  var compressed =
+      await new ZLibEncoder(dictionary: dictionary).convertAsync(data);
+  Expect.listEquals(
+      data, new ZLibDecoder(dictionary: dictionary).convert(compressed));
+}
+
+Future testBadData() async {
+  await new ZLibDecoder()
+      .convertAsync([1, 2, 3, 4, 5, 6, 7, 8])
+      .then((_) => Expect.fail('Expected a FormatException'),
+          onError: (e) => Expect.isTrue(e is FormatException));
+}
+
+Future main() async {
+  asyncStart();
+  for (int length in [0, 1, 1000, 256 * 1024, 256 * 1024 + 1, 1000000]) {
+    await testRoundTrip(length);
+    await testRoundTrip(length, gzip: true);
+    await testRoundTrip(length, raw: true);
+    await testRoundTrip(length, gzip: true, level: 9);
+  }
+  await testHeaders();
+  await testDictionary();
+  await testBadData();
+  asyncEnd();
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests File.readAsBytes, which reads a file with a single IO service
+// request, against File.readAsBytesSync.
+
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+Future testReadFile(Directory temp, int length) async {
+  final file = new File("${temp.path}/file_$length");
+  final contents = new Uint8List(length);
+  for (int i = 0; i < length; i++) {
+    contents[i] = i % 251;
+  }
+  file.writeAsBytesSync(contents);
+  Expect.listEquals(contents, await file.readAsBytes());
+  Expect.listEquals(
+      contents, (await file.readAsString(encoding: latin1)).codeUnits);
+}
+
+Future testReadZeroLengthFile() async {
+  // Files in /proc report a length of 0, but are not empty.
+  if (!Platform.isLinux) return;
+  final file = new File("/proc/self/status");
+  final data = await file.readAsBytes();
+  Expect.isTrue(data.length > 0);
+  Expect.isTrue(new String.fromCharCodes(data).startsWith("Name:"));
+}
+
+Future testError(File file) async {
+  FileSystemException expected;
+  try {
+    file.readAsBytesSync();
+  } on FileSystemException catch (e) {
+    expected = e;
+  }
+  Expect.isNotNull(expected);
+  try {
+    await file.readAsBytes();
+    Expect.fail("readAsBytes of ${file.path} should fail");
+  } on FileSystemException catch (e) {
+    Expect.equals(expected.message, e.message);
+    Expect.equals(file.path, e.path);
+    Expect.equals(expected.osError?.errorCode, e.osError?.errorCode);
+  }
+}
+
+main() async {
+  asyncStart();
+  final temp = Directory.systemTemp.createTempSync("dart_file_read_as_bytes");
+  try {
+    for (final length in [0, 1, 4096, 65536 + 17, 1024 * 1024 + 3]) {
+      await testReadFile(temp, length);
+    }
+    await testReadZeroLengthFile();
+    await testError(new File("${temp.path}/nonexistent"));
+    await testError(new File(temp.path));
+  } finally {
+    temp.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
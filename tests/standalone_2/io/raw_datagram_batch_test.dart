@@ -0,0 +1,78 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--verify_acquired_data
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int datagramCount = 40;
+
+void sendAll(RawDatagramSocket socket, List<Datagram> datagrams) {
+  int sent = socket.sendBatch(datagrams);
+  Expect.isTrue(sent >= 0 && sent <= datagrams.length);
+  if (sent < datagrams.length) {
+    Timer.run(() => sendAll(socket, datagrams.sublist(sent)));
+  }
+}
+
+void testSendAndReceiveBatch() {
+  asyncStart();
+  var address = InternetAddress.loopbackIPv4;
+  RawDatagramSocket.bind(address, 0).then((producer) {
+    RawDatagramSocket.bind(address, 0).then((receiver) {
+      // The same buffer is sent several times in a batch.
+      var shared = new Uint8List.fromList([255, 255]);
+      var datagrams = <Datagram>[];
+      for (int i = 0; i < datagramCount; i++) {
+        var data = (i % 4 == 0) ? shared : new Uint8List.fromList([i, i]);
+        datagrams.add(new Datagram(data, address, receiver.port));
+      }
+      sendAll(producer, datagrams);
+
+      var received = <Datagram>[];
+      receiver.listen((event) {
+        if (event != RawSocketEvent.read) return;
+        var batch = receiver.receiveBatch(7);
+        Expect.isTrue(batch.length <= 7);
+        received.addAll(batch);
+        if (received.length < datagramCount) return;
+        Expect.equals(datagramCount, received.length);
+        for (int i = 0; i < datagramCount; i++) {
+          var expected = (i % 4 == 0) ? 255 : i;
+          Expect.listEquals([expected, expected], received[i].data);
+          Expect.equals(producer.port, received[i].port);
+          Expect.equals(address, received[i].address);
+        }
+        Expect.equals(0, receiver.receiveBatch(7).length);
+        producer.close();
+        receiver.close();
+        asyncEnd();
+      });
+    });
+  });
+}
+
+void testBadArguments() {
+  asyncStart();
+  var address = InternetAddress.loopbackIPv4;
+  RawDatagramSocket.bind(address, 0).then((socket) {
+    Expect.throwsRangeError(() => socket.receiveBatch(0));
+    Expect.throwsArgumentError(() => socket.sendBatch(
+        [new Datagram(new Uint8List(1), address, 65536)]));
+    Expect.equals(0, socket.sendBatch(<Datagram>[]));
+    socket.close();
+    asyncEnd();
+  });
+}
+
+main() {
+  testSendAndReceiveBatch();
+  testBadArguments();
+}
@@ -0,0 +1,95 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_read
+// VMOptions=--short_socket_write
+// VMOptions=--short_socket_read --short_socket_write
+
+// Tests RawSocket.readInto, which reads into a caller supplied buffer.
+
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int dataSize = 200000;
+
+void testReadInto() {
+  asyncStart();
+  var data = new Uint8List(dataSize);
+  for (int i = 0; i < dataSize; i++) {
+    data[i] = i & 0xff;
+  }
+  RawServerSocket.bind(InternetAddress.loopbackIPv4, 0).then((server) {
+    server.listen((socket) {
+      int offset = 0;
+      socket.listen((event) {
+        if (event == RawSocketEvent.write) {
+          offset += socket.write(data, offset);
+          if (offset < dataSize) {
+            socket.writeEventsEnabled = true;
+          } else {
+            socket.shutdown(SocketDirection.send);
+          }
+        }
+      });
+    });
+    RawSocket.connect(InternetAddress.loopbackIPv4, server.port)
+        .then((socket) {
+      // The bytes outside of [start, end) must not be touched.
+      const int start = 10;
+      const int end = 1000;
+      var buffer = new Uint8List(end + start);
+      int received = 0;
+      socket.listen((event) {
+        if (event == RawSocketEvent.read) {
+          buffer.fillRange(0, buffer.length, 0xaa);
+          int bytesRead = socket.readInto(buffer, start, end);
+          Expect.isTrue(bytesRead <= end - start);
+          for (int i = 0; i < bytesRead; i++) {
+            Expect.equals((received + i) & 0xff, buffer[start + i]);
+          }
+          for (int i = 0; i < start; i++) {
+            Expect.equals(0xaa, buffer[i]);
+          }
+          for (int i = start + bytesRead; i < buffer.length; i++) {
+            Expect.equals(0xaa, buffer[i]);
+          }
+          received += bytesRead;
+        } else if (event == RawSocketEvent.readClosed) {
+          Expect.equals(dataSize, received);
+          Expect.equals(0, socket.readInto(buffer));
+          socket.close();
+          server.close();
+          asyncEnd();
+        }
+      });
+    });
+  });
+}
+
+void testInvalidRange() {
+  asyncStart();
+  RawServerSocket.bind(InternetAddress.loopbackIPv4, 0).then((server) {
+    server.listen((socket) {});
+    RawSocket.connect(InternetAddress.loopbackIPv4, server.port)
+        .then((socket) {
+      var buffer = new Uint8List(10);
+      Expect.throwsRangeError(() => socket.readInto(buffer, 11));
+      Expect.throwsRangeError(() => socket.readInto(buffer, 0, 11));
+      Expect.throwsRangeError(() => socket.readInto(buffer, 5, 4));
+      Expect.equals(0, socket.readInto(buffer, 5, 5));
+      socket.close();
+      server.close();
+      asyncEnd();
+    });
+  });
+}
+
+void main() {
+  testReadInto();
+  testInvalidRange();
+}
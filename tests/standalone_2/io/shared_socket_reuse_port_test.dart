@@ -0,0 +1,94 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests that with --listen_reuse_port each isolate binding a shared server
+// socket gets a socket of its own, and that connections are spread across
+// the listening isolates.
+
+// VMOptions=--listen_reuse_port
+// VMOptions=--enable-isolate-groups --listen_reuse_port
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:isolate';
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int numListeners = 4;
+const int numConnections = 200;
+
+// The sockets open in this process, e.g. "socket:[1234]".
+Set<String> openSockets() {
+  final result = new Set<String>();
+  for (final entity in new Directory('/proc/self/fd').listSync()) {
+    try {
+      final target = new Link(entity.path).targetSync();
+      if (target.startsWith('socket:')) result.add(target);
+    } on FileSystemException {
+      // The descriptor used to list the directory is closed by now.
+    }
+  }
+  return result;
+}
+
+void serve(ServerSocket server, int id) {
+  server.listen((socket) {
+    socket.add([id]);
+    socket.close();
+  });
+}
+
+Future<void> listener(List args) async {
+  final int id = args[0];
+  final int port = args[1];
+  final SendPort ready = args[2];
+  final server =
+      await ServerSocket.bind(InternetAddress.loopbackIPv4, port, shared: true);
+  serve(server, id);
+  ready.send(id);
+}
+
+Future<int> connect(int port) async {
+  final socket = await Socket.connect(InternetAddress.loopbackIPv4, port);
+  final data = await socket.first;
+  socket.destroy();
+  return data[0];
+}
+
+main() async {
+  // The option has no effect on other platforms.
+  if (!Platform.isLinux && !Platform.isAndroid) return;
+  asyncStart();
+  final socketsBefore = openSockets();
+
+  // The first listener picks the port, the others bind to it in isolates.
+  final server =
+      await ServerSocket.bind(InternetAddress.loopbackIPv4, 0, shared: true);
+  serve(server, 0);
+  final ready = new ReceivePort();
+  final isolates = <Isolate>[];
+  for (int id = 1; id < numListeners; id++) {
+    isolates.add(
+        await Isolate.spawn(listener, [id, server.port, ready.sendPort]));
+  }
+  await ready.take(numListeners - 1).toList();
+  ready.close();
+
+  final newSockets = openSockets().difference(socketsBefore);
+  Expect.isTrue(newSockets.length >= numListeners,
+      "Expected a socket per listener, got $newSockets");
+
+  final ids = new Set<int>();
+  for (int i = 0; i < numConnections; i++) {
+    ids.add(await connect(server.port));
+  }
+  Expect.isTrue(ids.length > 1, "All connections reached listener $ids");
+
+  for (final isolate in isolates) {
+    isolate.kill();
+  }
+  await server.close();
+  asyncEnd();
+}
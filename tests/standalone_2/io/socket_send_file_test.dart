@@ -0,0 +1,83 @@
+// Copyright (c) 2020, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests adding file streams to sockets, which sends the files directly from
+// the kernel where that is supported.
+//
+// VMOptions=
+// VMOptions=--short_socket_write
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+// Connects to a loopback server, calls [send] with the client socket and
+// returns the bytes the server received.
+Future<List<int>> sendOver(Future<void> send(Socket socket)) async {
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  final received = server.first.then((socket) async {
+    final bytes = <int>[];
+    await for (final data in socket) {
+      bytes.addAll(data);
+    }
+    return bytes;
+  });
+  final client = await Socket.connect(server.address, server.port);
+  await send(client);
+  await client.close();
+  return received;
+}
+
+Future<List<int>> sendStream(Stream<List<int>> stream) =>
+    sendOver((socket) => socket.addStream(stream));
+
+Future<void> testSendFile(File file, Uint8List content) async {
+  Expect.listEquals(content, await sendStream(file.openRead()));
+  Expect.listEquals(content.sublist(1000, 200000),
+      await sendStream(file.openRead(1000, 200000)));
+  Expect.listEquals(content.sublist(content.length - 10),
+      await sendStream(file.openRead(content.length - 10)));
+  // An end past the end of the file stops at the end of the file.
+  Expect.listEquals(content.sublist(500),
+      await sendStream(file.openRead(500, content.length + 1000)));
+  Expect.listEquals(<int>[], await sendStream(file.openRead(10, 10)));
+}
+
+Future<void> testSendEmptyFile(File file) async {
+  Expect.listEquals(<int>[], await sendStream(file.openRead()));
+}
+
+Future<void> testSendFileAfterData(File file, Uint8List content) async {
+  final received = await sendOver((socket) async {
+    socket.add([1, 2, 3]);
+    await socket.addStream(file.openRead(0, 100));
+    socket.add([4, 5, 6]);
+  });
+  Expect.listEquals([1, 2, 3, ...content.sublist(0, 100), 4, 5, 6], received);
+}
+
+main() async {
+  asyncStart();
+  final directory = Directory.systemTemp.createTempSync('socket_send_file');
+  try {
+    final content = new Uint8List(1024 * 1024 + 17);
+    for (int i = 0; i < content.length; i++) {
+      content[i] = i % 251;
+    }
+    final file = new File('${directory.path}/content');
+    file.writeAsBytesSync(content);
+    final empty = new File('${directory.path}/empty');
+    empty.createSync();
+
+    await testSendFile(file, content);
+    await testSendEmptyFile(empty);
+    await testSendFileAfterData(file, content);
+  } finally {
+    directory.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}